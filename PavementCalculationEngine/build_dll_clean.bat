@@ -7,15 +7,36 @@ cd /d "%~dp0"
 
 if not exist "build-dll\bin" mkdir "build-dll\bin"
 
+echo.
+echo Compiling the AVX2 and AVX-512 special-function kernels...
+g++ -c -o build-dll\SpecialFunctionsAVX2.o src\SpecialFunctionsAVX2.cpp ^
+    -I./include -std=c++17 -O2 -mavx2
+if %ERRORLEVEL% NEQ 0 goto failed
+g++ -c -o build-dll\SpecialFunctionsAVX512.o src\SpecialFunctionsAVX512.cpp ^
+    -I./include -std=c++17 -O2 -mavx512f -mfma
+if %ERRORLEVEL% NEQ 0 goto failed
+
 echo.
 echo Compiling DLL with all source files...
 g++ -shared -o build-dll\bin\PavementCalculationEngine.dll ^
     -DPAVEMENT_EXPORTS ^
     src\PavementAPI.cpp ^
     src\PavementCalculator.cpp ^
+    src\HankelIntegrator.cpp ^
+    src\WynnEpsilon.cpp ^
+    src\ThreadPool.cpp ^
     src\PavementData.cpp ^
     src\MatrixOperations.cpp ^
+    src\BandedLU.cpp ^
+    src\BatchedLU.cpp ^
+    src\AssemblyPlan.cpp ^
+    src\ChebyshevInterpolant.cpp ^
+    src\SpecialFunctions.cpp ^
+    src\SpecialFunctionsBaseline.cpp ^
+    build-dll\SpecialFunctionsAVX2.o ^
+    build-dll\SpecialFunctionsAVX512.o ^
     src\TRMMSolver.cpp ^
+    src\CalculationEngine.cpp ^
     src\PyMasticSolver.cpp ^
     -I./include ^
     -I./extern/eigen ^
@@ -23,13 +44,15 @@ g++ -shared -o build-dll\bin\PavementCalculationEngine.dll ^
     -O2 ^
     -Wl,--out-implib,build-dll\bin\libPavementCalculationEngine.dll.a
 
-if %ERRORLEVEL% EQU 0 (
-    echo.
-    echo === BUILD SUCCESS ===
-    echo DLL Location: build-dll\bin\PavementCalculationEngine.dll
-    echo Version: PyMastic v2.1 - E*1000 fix - %DATE% %TIME%
-) else (
-    echo.
-    echo === BUILD FAILED ===
-    exit /b 1
-)
+if %ERRORLEVEL% NEQ 0 goto failed
+
+echo.
+echo === BUILD SUCCESS ===
+echo DLL Location: build-dll\bin\PavementCalculationEngine.dll
+echo Version: PyMastic v2.1 - E*1000 fix - %DATE% %TIME%
+exit /b 0
+
+:failed
+echo.
+echo === BUILD FAILED ===
+exit /b 1
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <vector>
+#include "PavementData.h"
+#include "Constants.h"
+
+namespace Pavement {
+
+/**
+ * Precomputed, m-independent description of the layered system matrix.
+ *
+ * Layers are written in Huang's stabilised basis: each finite layer has a
+ * part decaying downward from its top (amplitudes B, D) and one decaying
+ * upward from its bottom (amplitudes A, C); the half-space has only the
+ * downward part. Every non-zero entry then has the form
+ *   (c + d*m) * exp(-m*h_k)   or   (c + d*m),
+ * where c, d depend only on the layer properties and h_k is a layer
+ * thickness, so no entry grows with m. The plan stores these factors and
+ * the (row, col) pattern once per CalculationInput, so assembling for a new
+ * m only evaluates one exponential per finite layer and fills the known slots.
+ *
+ * Unknowns: layer k holds [B_k, D_k, A_k, C_k] from column 4k, the
+ * half-space [B, D] from column 4 * (layerCount - 1). Rows 0-1 are the
+ * surface conditions, rows 2+4i .. 5+4i interface i.
+ */
+class AssemblyPlan {
+public:
+    /**
+     * State (sigma_z, tau_rz, u, w) of one part of a layer solution per unit
+     * amplitude, stresses without their common factor m and displacements in
+     * units of the layer compliance (1 + nu) / E.
+     */
+    using Basis = Eigen::Matrix<double, 4, 2>;
+
+    /**
+     * Part decaying upward from the layer bottom, amplitudes (A, C), at
+     * t = m * (z - z_bottom) <= 0, before the factor exp(t).
+     */
+    static Basis UpwardBasis(double nu, double t) {
+        Basis basis;
+        basis << 1.0, t - (1.0 - 2.0 * nu),
+                 1.0, t + 2.0 * nu,
+                 1.0, t + 1.0,
+                 1.0, t - (2.0 - 4.0 * nu);
+        return basis;
+    }
+
+    /**
+     * Part decaying downward from the layer top, amplitudes (B, D), at
+     * t = m * (z - z_top) >= 0, before the factor exp(-t).
+     */
+    static Basis DownwardBasis(double nu, double t) {
+        Basis basis;
+        basis <<  1.0, (1.0 - 2.0 * nu) + t,
+                 -1.0, 2.0 * nu - t,
+                  1.0, t - 1.0,
+                 -1.0, -(2.0 - 4.0 * nu) - t;
+        return basis;
+    }
+
+    /**
+     * Build the plan from the structure description.
+     *
+     * @param input Calculation input with layer properties
+     * @throws std::invalid_argument if the layer count is outside MIN_LAYER_COUNT..MAX_LAYER_COUNT
+     *         or the thicknesses do not match it
+     */
+    explicit AssemblyPlan(const CalculationInput& input);
+
+    /** Size of the system (4 * layerCount - 2) */
+    int Size() const { return size_; }
+
+    int LayerCount() const { return layerCount_; }
+
+    /** Applied surface pressure (right-hand side of the normal-stress row) */
+    double Pressure() const { return pressure_; }
+
+    /** Number of structurally non-zero entries */
+    int NonZeroCount() const { return static_cast<int>(entries_.size()); }
+
+    /** First column of the downward amplitudes (B, D) of a layer */
+    static int DownwardColumn(int layer) { return 4 * layer; }
+
+    /** First column of the upward amplitudes (A, C) of a finite layer */
+    static int UpwardColumn(int layer) { return 4 * layer + 2; }
+
+    /**
+     * Write the matrix for Hankel parameter m into M.
+     * Only the planned slots are written, so M must be zero on entry.
+     *
+     * @param m Hankel transform parameter (> 0)
+     * @param M Dense, fixed-size or banded matrix of size Size()
+     */
+    template <typename Matrix>
+    void Fill(double m, Matrix& M) const;
+
+private:
+    /** m-polynomial part of an entry */
+    struct Term {
+        double constant;
+        double linear;  ///< Coefficient of m
+    };
+
+    struct Entry {
+        int row;
+        int col;
+        int decayLayer;  ///< Layer whose exp(-m*h_k) multiplies the entry (-1 for none)
+        Term term;
+    };
+
+    /** Which part of a layer solution an entry belongs to */
+    enum class Part : unsigned char {
+        Upward,   ///< Amplitudes (A, C), UpwardBasis
+        Downward  ///< Amplitudes (B, D), DownwardBasis
+    };
+
+    /**
+     * Add one state row of one part of a layer, evaluated at t = m * slope,
+     * times scale, to row (two entries: both amplitudes of the part).
+     */
+    void AddPart(int row, int state, int layer, Part part, double slope, int decayLayer,
+                 double scale, const CalculationInput& input);
+
+    /** Rows 0-1: zero shear and applied normal stress at the surface */
+    void AddSurfaceBoundary(const CalculationInput& input);
+
+    /** Rows 2+4i .. 5+4i: interface i (bonded, semi-bonded or frictionless) */
+    void AddInterface(int layerIndex, const CalculationInput& input);
+
+    int layerCount_;
+    int size_;
+    double pressure_;
+    std::vector<double> thicknesses_;  ///< Thickness of every finite layer
+    std::vector<Entry> entries_;
+};
+
+template <typename Matrix>
+void AssemblyPlan::Fill(double m, Matrix& M) const {
+    // Decay over every finite layer once (stack buffer: no allocation per m)
+    double decay[Constants::MAX_LAYER_COUNT];
+    const int finiteLayers = static_cast<int>(thicknesses_.size());
+    for (int k = 0; k < finiteLayers; ++k) {
+        decay[k] = std::exp(-m * thicknesses_[k]);
+    }
+
+    for (const Entry& entry : entries_) {
+        double value = entry.term.constant + m * entry.term.linear;
+        if (entry.decayLayer >= 0) {
+            value *= decay[entry.decayLayer];
+        }
+        M(entry.row, entry.col) = value;
+    }
+}
+
+} // namespace Pavement
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <cmath>
+#include <vector>
+
+namespace Pavement {
+
+/**
+ * Residual b - sum(a_j * x_j) accumulated in double-double arithmetic
+ * (Ogita, Rump and Oishi's Dot2): each product is split exactly with
+ * std::fma (TwoProduct) and each sum keeps its rounding error (TwoSum), so
+ * the result is as accurate as if computed in twice the double precision,
+ * on every compiler (long double is plain double on MSVC).
+ */
+class CompensatedResidual {
+public:
+    explicit CompensatedResidual(double b) : sum_(b) {}
+
+    /** Subtract a * x */
+    void Subtract(double a, double x) {
+        // fma with a zero addend rounds like a * x but cannot be contracted
+        // with the subtraction below, which would break TwoSum
+        const double product = std::fma(a, x, 0.0);
+        const double productError = std::fma(a, x, -product);
+        const double sum = sum_ - product;
+        const double part = sum - sum_;
+        const double sumError = (sum_ - (sum - part)) - (product + part);
+        sum_ = sum;
+        error_ += sumError - productError;
+    }
+
+    /** The residual, rounded to double once */
+    double Value() const { return sum_ + error_; }
+
+private:
+    double sum_;
+    double error_ = 0.0;
+};
+
+/**
+ * Square matrix stored in LAPACK general-band layout.
+ *
+ * Only the diagonals from -lower to +upper are stored, plus `lower` extra
+ * superdiagonals that receive fill-in when BandedLU pivots. Element (i, j)
+ * lives at storage(lower + upper + i - j, j).
+ */
+class BandedMatrix {
+public:
+    /**
+     * Create a zero matrix.
+     *
+     * @param size Matrix dimension
+     * @param lower Number of subdiagonals
+     * @param upper Number of superdiagonals
+     */
+    BandedMatrix(int size, int lower, int upper);
+
+    int rows() const { return size_; }
+    int cols() const { return size_; }
+    int LowerBandwidth() const { return lower_; }
+    int UpperBandwidth() const { return upper_; }
+
+    /** True if (i, j) lies inside the declared band */
+    bool InBand(int i, int j) const { return i - j <= lower_ && j - i <= upper_; }
+
+    /**
+     * Element access inside the band.
+     * @throws std::out_of_range if (i, j) lies outside the declared band
+     */
+    double& operator()(int i, int j);
+    double operator()(int i, int j) const;
+
+    /** Multiply row i by s (band entries only) */
+    void ScaleRow(int i, double s);
+
+    /** Multiply column j by s (band entries only) */
+    void ScaleCol(int j, double s);
+
+    /** Largest absolute value in row i */
+    double RowMaxAbs(int i) const;
+
+    /** Largest absolute value in column j */
+    double ColMaxAbs(int j) const;
+
+    /** Maximum absolute column sum (matrix 1-norm) */
+    double Norm1() const;
+
+    /** Matrix-vector product in O(size * bandwidth) */
+    Eigen::VectorXd Multiply(const Eigen::VectorXd& x) const;
+
+    /**
+     * Residual b - A x accumulated in double-double (CompensatedResidual),
+     * rounded to double once per component (for iterative refinement).
+     */
+    Eigen::VectorXd Residual(const Eigen::VectorXd& x, const Eigen::VectorXd& b) const;
+
+    /** Expand to a dense matrix (diagnostics and tests) */
+    Eigen::MatrixXd ToDense() const;
+
+private:
+    friend class BandedLU;
+
+    double& Raw(int i, int j) { return storage_(lower_ + upper_ + i - j, j); }
+    double Raw(int i, int j) const { return storage_(lower_ + upper_ + i - j, j); }
+
+    int size_;
+    int lower_;
+    int upper_;
+    Eigen::MatrixXd storage_;  ///< (2*lower + upper + 1) x size, column-major
+};
+
+/**
+ * LU factorisation with partial pivoting of a banded matrix (LAPACK dgbtf2).
+ *
+ * Row interchanges are restricted to the `lower` rows below the diagonal, so
+ * U keeps an upper bandwidth of lower + upper and the cost is
+ * O(size * lower * (lower + upper)) - linear in the matrix size.
+ */
+class BandedLU {
+public:
+    /**
+     * Factor A in place of a copy.
+     *
+     * @param A Banded matrix to factor
+     */
+    explicit BandedLU(const BandedMatrix& A);
+
+    /** False if an exactly zero pivot was met */
+    bool IsInvertible() const { return singularColumn_ < 0; }
+
+    /**
+     * Estimate of 1 / (||A||_1 * ||A^-1||_1) from the existing factors.
+     * Uses the Hager/Higham estimator (as LAPACK xGBCON): a handful of
+     * solves with A and A^T, so O(size * bandwidth) on top of the factorisation.
+     *
+     * @return Reciprocal 1-norm condition estimate (0 if singular)
+     */
+    double ReciprocalCondition() const;
+
+    /**
+     * Solve A x = b.
+     * @throws std::runtime_error if the matrix is singular
+     */
+    Eigen::VectorXd Solve(const Eigen::VectorXd& b) const;
+
+    /**
+     * Solve A^T x = b.
+     * @throws std::runtime_error if the matrix is singular
+     */
+    Eigen::VectorXd SolveTranspose(const Eigen::VectorXd& b) const;
+
+private:
+    /** Lower-bound estimate of ||A^-1||_1 (Higham, ACM TOMS 14, 1988) */
+    double InverseNorm1Estimate() const;
+
+    BandedMatrix lu_;
+    double norm1_;  ///< ||A||_1 of the matrix before factorisation
+    std::vector<int> pivots_;
+    int singularColumn_;
+};
+
+} // namespace Pavement
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <array>
+#include <vector>
+#include "BandedLU.h"
+
+namespace Pavement {
+
+/**
+ * LANES banded matrices of identical size and band structure, stored
+ * lane-interleaved (structure of arrays).
+ *
+ * The LANES values of element (i, j) are contiguous, so one vector
+ * instruction updates the same entry of every system. The band layout per
+ * lane is that of BandedMatrix, including the `lower` fill-in diagonals.
+ */
+class BatchedBandedMatrix {
+public:
+#if defined(__AVX512F__)
+    static constexpr int LANES = 8;   ///< One 512-bit register of doubles
+#else
+    static constexpr int LANES = 4;   ///< One 256-bit register (AVX2) or two 128-bit ones (SSE2)
+#endif
+
+    /** Right-hand sides or solutions: row i holds the LANES values of component i */
+    using LaneVectors = Eigen::Matrix<double, Eigen::Dynamic, LANES, Eigen::RowMajor>;
+
+    /**
+     * Writable view of one lane, usable wherever a matrix with
+     * operator()(i, j) is expected (e.g. AssemblyPlan::Fill).
+     */
+    class LaneView {
+    public:
+        double& operator()(int i, int j) { return matrix_(i, j, lane_); }
+
+    private:
+        friend class BatchedBandedMatrix;
+        LaneView(BatchedBandedMatrix& matrix, int lane) : matrix_(matrix), lane_(lane) {}
+
+        BatchedBandedMatrix& matrix_;
+        int lane_;
+    };
+
+    /**
+     * Create LANES zero matrices.
+     *
+     * @param size Matrix dimension
+     * @param lower Number of subdiagonals
+     * @param upper Number of superdiagonals
+     */
+    BatchedBandedMatrix(int size, int lower, int upper);
+
+    int rows() const { return size_; }
+    int cols() const { return size_; }
+    int LowerBandwidth() const { return lower_; }
+    int UpperBandwidth() const { return upper_; }
+
+    /** True if (i, j) lies inside the declared band */
+    bool InBand(int i, int j) const { return i - j <= lower_ && j - i <= upper_; }
+
+    /**
+     * Element (i, j) of one lane.
+     * @throws std::out_of_range if (i, j) lies outside the declared band or lane is invalid
+     */
+    double& operator()(int i, int j, int lane);
+    double operator()(int i, int j, int lane) const;
+
+    LaneView Lane(int lane) { return LaneView(*this, lane); }
+
+    /** Scale row i of every lane by its own factor (band entries only) */
+    void ScaleRows(int i, const double* scales);
+
+    /** Scale column j of every lane by its own factor (band entries only) */
+    void ScaleCols(int j, const double* scales);
+
+    /** Largest absolute value in row i, per lane */
+    void RowMaxAbs(int i, double* result) const;
+
+    /** Largest absolute value in column j, per lane */
+    void ColMaxAbs(int j, double* result) const;
+
+    /** Maximum absolute column sum (matrix 1-norm), per lane */
+    void Norm1(double* result) const;
+
+    /** Matrix-vector product of every lane with its own column of x */
+    LaneVectors Multiply(const LaneVectors& x) const;
+
+    /** BandedMatrix::Residual (double-double accumulation) for every lane */
+    LaneVectors Residual(const LaneVectors& x, const LaneVectors& b) const;
+
+    /** Copy one lane into a BandedMatrix (diagnostics and tests) */
+    BandedMatrix ExtractLane(int lane) const;
+
+private:
+    friend class BatchedBandedLU;
+
+    double* Raw(int i, int j) { return &storage_[Offset(i, j)]; }
+    const double* Raw(int i, int j) const { return &storage_[Offset(i, j)]; }
+    size_t Offset(int i, int j) const {
+        return (static_cast<size_t>(j) * rowsStored_ + lower_ + upper_ + i - j) * LANES;
+    }
+
+    int size_;
+    int lower_;
+    int upper_;
+    int rowsStored_;              ///< 2*lower + upper + 1 band rows per column
+    std::vector<double> storage_; ///< [column][band row][lane]
+};
+
+/**
+ * Lock-step LU factorisation of LANES banded matrices (BandedLU per lane).
+ *
+ * Every lane runs the dgbtf2 schedule of BandedLU with its own partial
+ * pivoting inside the band: the pivot search is a lane-wise compare and the
+ * row interchange a lane-wise select, so all lanes share one instruction
+ * stream. Each lane performs exactly the arithmetic of BandedLU on that
+ * matrix. AVX-512, AVX2 and baseline x86-64 (SSE2) builds use vector
+ * intrinsics; other targets run the same loops on plain arrays.
+ */
+class BatchedBandedLU {
+public:
+    static constexpr int LANES = BatchedBandedMatrix::LANES;
+    using LaneVectors = BatchedBandedMatrix::LaneVectors;
+
+    /**
+     * Factor all lanes of A in place of a copy.
+     *
+     * @param A Batched banded matrix to factor
+     */
+    explicit BatchedBandedLU(const BatchedBandedMatrix& A);
+
+    /** False if an exactly zero pivot was met in this lane */
+    bool IsInvertible(int lane) const { return singularColumn_[lane] < 0; }
+
+    /**
+     * Hager/Higham estimate of 1 / (||A||_1 * ||A^-1||_1) for every lane:
+     * the iteration of BandedLU::ReciprocalCondition, with the solves batched.
+     *
+     * @return Reciprocal 1-norm condition estimates (0 for singular lanes)
+     */
+    std::array<double, LANES> ReciprocalCondition() const;
+
+    /**
+     * Solve A_l x_l = b_l for every lane l (column l of b).
+     * Lanes that are not invertible return non-finite values.
+     */
+    LaneVectors Solve(const LaneVectors& b) const;
+
+    /** Solve A_l^T x_l = b_l for every lane l */
+    LaneVectors SolveTranspose(const LaneVectors& b) const;
+
+private:
+    BatchedBandedMatrix lu_;
+    std::array<double, LANES> norm1_;       ///< ||A_l||_1 before factorisation
+    std::vector<std::array<int, LANES>> pivots_;
+    std::array<int, LANES> singularColumn_;
+};
+
+} // namespace Pavement
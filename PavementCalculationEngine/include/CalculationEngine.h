@@ -0,0 +1,189 @@
+#pragma once
+
+#include "PavementData.h"
+#include "PavementCalculator.h"
+#include "TRMMSolver.h"
+#include "ThreadPool.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Pavement {
+
+/**
+ * Long-lived calculation context behind the C API engine handle.
+ *
+ * Building a solver per call pays for a thread pool, the solver objects and
+ * their scratch storage every time. An engine is configured once and keeps
+ * all of that: one worker pool shared by its solvers, solver workspaces
+ * reused from call to call, and an LRU cache of results keyed by the full
+ * input (the Bessel zero and PyMastic grid caches are process-wide already).
+ *
+ * Calculate may be called from several threads at once: every call checks
+ * out a workspace of its own, and ThreadPool::ParallelFor lets concurrent
+ * callers share the workers. Submit runs the same work in the background
+ * on the engine's own threads; destroying the engine cancels and waits for
+ * its jobs.
+ */
+class CalculationEngine {
+public:
+    /**
+     * Solver used by Calculate.
+     */
+    enum class Solver {
+        Standard,  ///< PavementCalculator: results at the layer interfaces (depths ignored)
+        Stable     ///< TRMMSolver: results on the wheel axis at the requested depths
+    };
+
+    struct EngineConfig {
+        Solver solver = Solver::Standard;
+        int threadCount = 1;                                    ///< Pool threads (1 = serial, <= 0 = all cores)
+        PavementCalculator::CalculatorConfig calculator;        ///< Standard solver settings (threadCount ignored)
+        PavementCalculation::TRMMSolver::TRMMConfig trmm;       ///< Stable solver settings (thread_count ignored)
+        std::size_t resultCacheCapacity = 0;                    ///< Results kept for repeated inputs (0 disables)
+    };
+
+    /**
+     * Counters of the result cache.
+     */
+    struct ResultCacheStats {
+        std::uint64_t hits = 0;        ///< Calculations served from the cache
+        std::uint64_t misses = 0;      ///< Calculations run by a solver
+        std::size_t entries = 0;       ///< Results currently cached
+        std::size_t capacity = 0;      ///< Maximum cached results (least recently used evicted)
+    };
+
+    CalculationEngine();
+    explicit CalculationEngine(const EngineConfig& config);
+    ~CalculationEngine();
+
+    CalculationEngine(const CalculationEngine&) = delete;
+    CalculationEngine& operator=(const CalculationEngine&) = delete;
+
+    /**
+     * Calculate one structure with the configured solver.
+     *
+     * @param input Structure and load (validated here)
+     * @param depths Calculation depths (m); the Standard solver ignores them
+     * @return Solver results, copied from the cache if the same input (and,
+     *         for the Stable solver, the same depths) was calculated before
+     * @throws std::invalid_argument if the input or depths are invalid
+     * @throws std::runtime_error if the solver fails
+     */
+    CalculationOutput Calculate(const CalculationInput& input, const std::vector<double>& depths);
+
+    /**
+     * Calculate into an existing output. Only a cache hit is free of
+     * allocations: the cached result is copied into the storage of output
+     * once output has held a result of the same size (the cache key is built
+     * in per-thread scratch storage). A cache miss solves the structure,
+     * which allocates the solver's work storage (integrand values, node
+     * vectors, integration segments, assembly plan) on every call, and
+     * replaces the storage of output with the new result.
+     *
+     * @param input Structure and load (validated here)
+     * @param depths Calculation depths (m); the Standard solver ignores them
+     * @param output Receives the results
+     * @throws std::invalid_argument if the input or depths are invalid
+     * @throws std::runtime_error if the solver fails
+     */
+    void Calculate(const CalculationInput& input, const std::vector<double>& depths, CalculationOutput& output);
+
+    /**
+     * Run task(i) for every i in [0, count) on the engine's pool (serially
+     * when the engine is serial), e.g. one Calculate per structure of a
+     * batch. Tasks share the workspaces and the result cache.
+     *
+     * @param count Number of iterations
+     * @param task Loop body (must be safe to call concurrently for distinct i)
+     * @throws Rethrows the first exception raised by any iteration
+     */
+    void ParallelFor(int count, const std::function<void(int)>& task);
+
+    /** Identifier of a background job (> 0) */
+    using JobId = std::int64_t;
+
+    /**
+     * Run task(i) for every i in [0, count) in the background and return
+     * at once.
+     *
+     * The iterations are spread as by ParallelFor, from a job started on the
+     * engine's pool (on one background worker for a serial engine). When
+     * every iteration has run or been skipped by Cancel, finished(cancelled)
+     * is called on that worker thread; cancelled is true exactly when Cancel
+     * succeeded for the job, even if no iteration was left to skip.
+     * Exceptions escaping task or finished are dropped.
+     *
+     * @param count Number of iterations (>= 0)
+     * @param task Loop body (must be safe to call concurrently for distinct i)
+     * @param finished Completion handler (may be empty)
+     * @return Job identifier
+     */
+    JobId Submit(int count, std::function<void(int)> task, std::function<void(bool)> finished);
+
+    /**
+     * Skip the iterations of a job that have not started; running ones
+     * finish and the completion handler still runs, with cancelled = true.
+     *
+     * @return true if the job's completion handler had not started yet
+     */
+    bool Cancel(JobId job);
+
+    /**
+     * Block until a job has finished, completion handler included. Must not
+     * be called from a task or completion handler of the engine.
+     *
+     * @return false if the job is unknown or had already finished
+     */
+    bool Wait(JobId job);
+
+    const EngineConfig& GetConfig() const { return config_; }
+
+    /** Threads of the shared pool, including the caller (1 when serial) */
+    int GetThreadCount() const { return pool_ ? pool_->GetThreadCount() : 1; }
+
+    /** Shared worker pool (null when serial) */
+    ThreadPool* GetThreadPool() const { return pool_.get(); }
+
+    ResultCacheStats GetResultCacheStats() const;
+
+    /** Drop every cached result and reset the counters */
+    void ClearResultCache();
+
+private:
+    /** Solvers of one in-flight call, returned to the engine afterwards */
+    struct Workspace;
+    struct ResultCache;
+    /** Cancellation state of a background job */
+    struct Job;
+
+    std::unique_ptr<Workspace> AcquireWorkspace();
+    void ReleaseWorkspace(std::unique_ptr<Workspace> workspace);
+
+    /**
+     * Cache key: every value the configured solver reads, as doubles.
+     */
+    void MakeCacheKey(const CalculationInput& input, const std::vector<double>& depths,
+                      std::vector<double>& key) const;
+
+    EngineConfig config_;
+    std::shared_ptr<ThreadPool> pool_;  ///< Null when running serially
+
+    std::mutex workspaceMutex_;
+    std::vector<std::unique_ptr<Workspace>> idleWorkspaces_;
+
+    std::unique_ptr<ResultCache> cache_;
+
+    std::mutex jobMutex_;
+    std::condition_variable jobFinished_;
+    std::unordered_map<JobId, std::shared_ptr<Job>> jobs_;  ///< Jobs not finished yet
+    JobId nextJob_ = 1;
+    std::unique_ptr<ThreadPool> jobRunner_;  ///< Background worker of a serial engine
+};
+
+} // namespace Pavement
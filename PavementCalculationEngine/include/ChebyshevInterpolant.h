@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <memory>
+#include <vector>
+#include "Constants.h"
+
+namespace Pavement {
+
+/**
+ * Settings of the Chebyshev interpolation of the layer coefficients in m.
+ */
+struct ChebyshevOptions {
+    bool enabled = false;                                         ///< Interpolate instead of solving at every m
+    int checkPoints = Constants::CHEBYSHEV_CHECK_POINTS;          ///< Segment nodes solved first to check each interpolant
+    double relativeTolerance = Constants::CHEBYSHEV_RELATIVE_TOLERANCE; ///< Accepted error at the check points
+    int minSamples = Constants::CHEBYSHEV_MIN_SAMPLES;            ///< Exact samples a quadrature segment needs before it is interpolated
+};
+
+/**
+ * Outcome of one ChebyshevInterpolant::FitSamples.
+ */
+struct ChebyshevFitReport {
+    double checkError = 0.0;  ///< Largest relative error at the check points
+    bool accepted = false;    ///< False if a check failed
+};
+
+/**
+ * Polynomial interpolant of a vector-valued function of m on [lower, upper],
+ * through its values at given nodes.
+ *
+ * The barycentric formula evaluates the interpolant in O(nodes) per
+ * component with no ill-conditioned monomial basis. With nodes clustered
+ * towards the interval ends like Chebyshev or Gauss points, and functions
+ * analytic near the interval, such as the layer coefficients between two
+ * zeros of J1(m*a), the error falls geometrically with the node count.
+ */
+class ChebyshevInterpolant {
+public:
+    /**
+     * Build the interpolant from values at arbitrary distinct nodes, e.g.
+     * quadrature points that were solved anyway. The barycentric weights
+     * are those of the given nodes; the interpolant is well conditioned
+     * when they cluster towards the interval ends like Chebyshev or Gauss
+     * points.
+     *
+     * @param lower Interval start
+     * @param upper Interval end (> lower)
+     * @param nodes Ascending nodes in [lower, upper]
+     * @param nodeValues Column j holds the function at nodes[j]
+     * @throws std::invalid_argument if the interval is empty, there are no
+     *         nodes or their count differs from the columns of nodeValues
+     */
+    ChebyshevInterpolant(double lower, double upper, std::vector<double> nodes, Eigen::MatrixXd nodeValues);
+
+    /**
+     * Interpolate through samples that are already known and keep the
+     * interpolant only if it reproduces exact values at further points to
+     * within options.relativeTolerance. Nothing is evaluated here: the
+     * caller supplies the check values, ideally at points it needs exactly
+     * anyway (SampleCheckPoints), so the check costs no extra solve.
+     *
+     * @param lower Interval start
+     * @param upper Interval end (> lower)
+     * @param nodes Ascending sample points in [lower, upper] (at least 2)
+     * @param nodeValues Column j holds the function at nodes[j]
+     * @param checks Check points (at least 1)
+     * @param checkValues Column i holds the function at checks[i]
+     * @param options Tolerance (checkPoints and minSamples unused)
+     * @param report Optional achieved accuracy
+     * @return The interpolant, or null if it failed the check
+     * @throws std::invalid_argument if there are too few nodes or checks
+     */
+    static std::unique_ptr<ChebyshevInterpolant> FitSamples(
+        double lower, double upper,
+        std::vector<double> nodes,
+        Eigen::MatrixXd nodeValues,
+        const std::vector<double>& checks,
+        const Eigen::MatrixXd& checkValues,
+        const ChebyshevOptions& options,
+        ChebyshevFitReport* report = nullptr);
+
+    /**
+     * The count candidates farthest from their nearest sample node, where an
+     * interpolant through the nodes errs most. Ties go to the earlier
+     * candidate.
+     *
+     * @param nodes Ascending sample points (at least 1)
+     * @param candidates Points to choose from
+     * @param count Number of points (at most candidates.size() are returned)
+     * @return The chosen candidates, ascending
+     */
+    static std::vector<double> SampleCheckPoints(const std::vector<double>& nodes,
+                                                 const std::vector<double>& candidates,
+                                                 int count);
+
+    /** Interpolated value at m (any m; meaningful inside [Lower(), Upper()]) */
+    Eigen::VectorXd Evaluate(double m) const;
+
+    /**
+     * Largest component error of Evaluate(m) against exact, relative to the
+     * largest magnitude of that component at the nodes.
+     */
+    double RelativeError(double m, const Eigen::Ref<const Eigen::VectorXd>& exact) const;
+
+    double Lower() const { return lower_; }
+    double Upper() const { return upper_; }
+    int NodeCount() const { return static_cast<int>(nodeValues_.cols()); }
+
+private:
+    double lower_;
+    double upper_;
+    std::vector<double> nodes_;
+    std::vector<double> weights_;  ///< Barycentric weights, node order
+    Eigen::MatrixXd nodeValues_;
+    Eigen::VectorXd scale_;        ///< Largest |value| of each component over the nodes
+};
+
+} // namespace Pavement
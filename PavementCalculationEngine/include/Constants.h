@@ -34,7 +34,57 @@ constexpr double GAUSS_WEIGHTS_4[4] = {
     0.3478548451374538
 };
 
-/** 
+/**
+ * Gauss-Kronrod 15-point abscissae on [0, 1] (QUADPACK qk15 ordering).
+ * Odd indices 1, 3, 5 and the centre (index 7) are the embedded 7-point Gauss nodes.
+ */
+constexpr double GAUSS_KRONROD_NODES_15[8] = {
+    0.991455371120812639206854697526329,
+    0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926,
+    0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013,
+    0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245,
+    0.000000000000000000000000000000000
+};
+
+/** Kronrod weights matching GAUSS_KRONROD_NODES_15 */
+constexpr double GAUSS_KRONROD_WEIGHTS_15[8] = {
+    0.022935322010529224963732008058970,
+    0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518,
+    0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550,
+    0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649,
+    0.209482141084727828012999174891714
+};
+
+/** Embedded 7-point Gauss weights (nodes 1, 3, 5 and centre of GAUSS_KRONROD_NODES_15) */
+constexpr double GAUSS_WEIGHTS_7[4] = {
+    0.129484966168869693270611432679082,
+    0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975,
+    0.417959183673469387755102040816327
+};
+
+/**
+ * Default relative tolerance for adaptive Hankel integration.
+ * Rationale: 1e-6 is well below the scatter of measured material moduli.
+ */
+constexpr double HANKEL_RELATIVE_TOLERANCE = 1e-6;
+
+/** Default absolute tolerance for adaptive Hankel integration (result units) */
+constexpr double HANKEL_ABSOLUTE_TOLERANCE = 1e-10;
+
+/**
+ * Default evaluation budget for adaptive Hankel integration.
+ * Each evaluation is one linear solve of the layered system.
+ */
+constexpr int HANKEL_MAX_EVALUATIONS = 2000;
+
+/**
  * Integration upper bound factor for Hankel transform.
  * Integration over [0, HANKEL_INTEGRATION_BOUND / contactRadius].
  * Rationale: Bessel function J₁(m·r) decays rapidly for m·r > 70,
@@ -42,6 +92,40 @@ constexpr double GAUSS_WEIGHTS_4[4] = {
  */
 constexpr double HANKEL_INTEGRATION_BOUND = 70.0;
 
+/**
+ * Largest number of intervals between zeros of J1(m*a) summed by
+ * partition-extrapolation (HankelIntegrationOptions::extrapolateTail).
+ * Rationale: three times the intervals below HANKEL_INTEGRATION_BOUND; the
+ * epsilon algorithm normally stops far earlier.
+ */
+constexpr int HANKEL_MAX_PARTITIONS = 64;
+
+/** Intervals integrated per partition-extrapolation round */
+constexpr int HANKEL_EXTRAPOLATION_ROUND = 4;
+
+/** Deepest column of the Wynn epsilon table (QUADPACK's QELG limit) */
+constexpr int WYNN_EPSILON_MAX_COLUMNS = 50;
+
+/** Nodes of a quadrature segment solved first to check its interpolant */
+constexpr int CHEBYSHEV_CHECK_POINTS = 2;
+
+/**
+ * Exact samples a quadrature segment must already hold (from the Kronrod
+ * rules of the segments it was bisected from) before its nodes are
+ * interpolated instead of solved.
+ * Rationale: a fresh half inherits 8 nodes of its parent's rule, too few
+ * for the coefficients; a few bisections further it holds 12 or more,
+ * enough to pass CHEBYSHEV_RELATIVE_TOLERANCE away from m = 0.
+ */
+constexpr int CHEBYSHEV_MIN_SAMPLES = 12;
+
+/**
+ * Largest interpolation error accepted at the check points, relative to the
+ * largest magnitude of each coefficient over the interval.
+ * Rationale: two orders below HANKEL_RELATIVE_TOLERANCE.
+ */
+constexpr double CHEBYSHEV_RELATIVE_TOLERANCE = 1e-8;
+
 /** 
  * Minimum Hankel parameter m to avoid singularity at m=0.
  * Rationale: Bessel functions have removable singularity at origin.
@@ -99,11 +183,15 @@ constexpr double STIFF_MATERIAL_WARNING_THRESHOLD = 50000.0;
 // LAYER GEOMETRY LIMITS
 // ============================================================================
 
-/** Minimum layer count */
-constexpr int MIN_LAYER_COUNT = 1;
+/** Minimum layer count (at least one layer over the half-space) */
+constexpr int MIN_LAYER_COUNT = 2;
 
-/** Maximum layer count (practical limit for computation) */
-constexpr int MAX_LAYER_COUNT = 20;
+/**
+ * Maximum layer count (practical limit for computation).
+ * Rationale: the banded solve is linear in the layer count, so structures
+ * discretised into many sublayers (temperature gradients, treated soils) stay cheap.
+ */
+constexpr int MAX_LAYER_COUNT = 50;
 
 /** 
  * Minimum layer thickness in meters (10 mm).
@@ -175,6 +263,13 @@ constexpr double CONDITION_NUMBER_WARNING_THRESHOLD = 1e12;
  */
 constexpr double RESIDUAL_TOLERANCE = 1e-6;
 
+/**
+ * Reciprocal condition below which a system is treated as numerically singular.
+ * Rationale: below machine epsilon the solution carries no correct digits even
+ * when the residual is tiny (LAPACK xGESVX uses the same test).
+ */
+constexpr double SINGULAR_RECIPROCAL_CONDITION = 2.220446049250313e-16;
+
 // ============================================================================
 // UNIT CONVERSION FACTORS
 // ============================================================================
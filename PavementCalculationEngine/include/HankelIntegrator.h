@@ -0,0 +1,199 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "Constants.h"
+
+namespace Pavement {
+
+class ThreadPool;
+
+/**
+ * Accuracy targets and budget for adaptive Hankel integration.
+ */
+struct HankelIntegrationOptions {
+    double absoluteTolerance = Constants::HANKEL_ABSOLUTE_TOLERANCE;
+    double relativeTolerance = Constants::HANKEL_RELATIVE_TOLERANCE;
+    int maxEvaluations = Constants::HANKEL_MAX_EVALUATIONS;
+    bool extrapolateTail = false;  ///< Breakpoints are kernel zeros: extrapolate their partial sums to infinity
+    int maxPartitions = Constants::HANKEL_MAX_PARTITIONS;  ///< Zero intervals offered to the integrator when extrapolating
+};
+
+/**
+ * Integral value together with the error actually achieved.
+ */
+struct HankelIntegrationResult {
+    Eigen::VectorXd value;       ///< Integral of every integrand component
+    double errorEstimate = 0.0;  ///< Sum of |Kronrod - Gauss| over all subintervals (max-norm)
+    int evaluations = 0;         ///< Number of integrand evaluations (linear solves)
+    int intervals = 0;           ///< Number of subintervals in the final partition
+    int failedEvaluations = 0;   ///< Non-finite integrand values in the final partition, integrated as zero
+    bool converged = false;      ///< True if the tolerance was met within the budget and no evaluation failed
+    int partitions = 0;          ///< Breakpoint intervals summed before extrapolation (extrapolateTail only)
+    double extrapolationError = 0.0;  ///< Wynn epsilon error estimate, included in errorEstimate
+};
+
+/**
+ * Adaptive Gauss-Kronrod (G7-K15) integrator for Hankel transforms.
+ *
+ * The integration range is first partitioned at user breakpoints (typically
+ * the zeros of the load kernel J1(m*a)) so each subinterval holds at most one
+ * oscillation. The subinterval with the largest error estimate is bisected
+ * until the global error meets the tolerance or the budget is exhausted.
+ *
+ * With HankelIntegrationOptions::extrapolateTail the breakpoints are taken
+ * as consecutive zeros of the oscillating kernel and the integral runs to
+ * infinity by partition-extrapolation: the intervals are integrated in
+ * rounds of HANKEL_EXTRAPOLATION_ROUND, the partial sum up to every zero is
+ * fed to Wynn's epsilon algorithm, and integration stops as soon as the
+ * extrapolation and quadrature errors together meet the tolerance. Unused
+ * breakpoints are never evaluated.
+ */
+class HankelIntegrator {
+public:
+    /** Vector-valued integrand: all responses for one Hankel parameter m */
+    using Integrand = std::function<Eigen::VectorXd(double m)>;
+
+    /** Batched integrand: values[i] = f(m[i]) for i in [0, count) */
+    using BatchIntegrand = std::function<void(const double* m, int count, Eigen::VectorXd* values)>;
+
+    /**
+     * Told about the segments (lower, upper) of every refinement step, in
+     * interval order, before any of their nodes is evaluated (KronrodNodes
+     * gives them). Runs on the calling thread while no integrand call is
+     * in flight, so it may prepare state that the integrand then only reads.
+     */
+    using SegmentObserver = std::function<void(const std::vector<std::pair<double, double>>& segments)>;
+
+    /** Nodes of the 15-point Kronrod rule on one segment */
+    static constexpr int KRONROD_NODES = 15;
+
+    /**
+     * Integrate f over [breakpoints.front(), breakpoints.back()].
+     *
+     * When a pool is given, the integrand nodes of each refinement step are
+     * evaluated concurrently; every node result lands in its own slot and
+     * the rules are combined in a fixed order, so the result is bit-identical
+     * for any thread count.
+     *
+     * An integrand signals a point it cannot evaluate with a non-finite
+     * value (e.g. NaN). Such points are integrated as zero, counted in
+     * failedEvaluations, and the result is never reported as converged.
+     *
+     * @param f Integrand (must return vectors of identical size; must be
+     *          thread-safe when a pool is given)
+     * @param breakpoints Sorted interval boundaries (at least 2)
+     * @param options Tolerances and evaluation budget
+     * @param pool Optional worker pool for the integrand evaluations
+     * @param observer Optional hook called with the segments of every step before their nodes are evaluated
+     * @return Integral, achieved error and evaluation count
+     * @throws std::invalid_argument if fewer than 2 breakpoints are given
+     *         (fewer than 3 intervals with extrapolateTail)
+     */
+    static HankelIntegrationResult Integrate(
+        const Integrand& f,
+        const std::vector<double>& breakpoints,
+        const HankelIntegrationOptions& options = HankelIntegrationOptions(),
+        ThreadPool* pool = nullptr,
+        const SegmentObserver& observer = nullptr);
+
+    /**
+     * Integrate with an integrand that evaluates several nodes per call.
+     *
+     * The nodes of each refinement step are handed to f in consecutive
+     * groups of batchSize (the last group may be shorter). Grouping depends
+     * only on the node order, so the result is bit-identical for any thread
+     * count, and identical to Integrate when f computes each node alone.
+     *
+     * @param f Batched integrand (thread-safe when a pool is given)
+     * @param batchSize Largest number of nodes per call (>= 1)
+     * @param breakpoints Sorted interval boundaries (at least 2)
+     * @param options Tolerances and evaluation budget
+     * @param pool Optional worker pool; groups are evaluated concurrently
+     * @param observer Optional hook called with the segments of every step before their nodes are evaluated
+     * @return Integral, achieved error and evaluation count
+     * @throws std::invalid_argument if fewer than 2 breakpoints are given or batchSize < 1
+     */
+    static HankelIntegrationResult IntegrateBatched(
+        const BatchIntegrand& f,
+        int batchSize,
+        const std::vector<double>& breakpoints,
+        const HankelIntegrationOptions& options = HankelIntegrationOptions(),
+        ThreadPool* pool = nullptr,
+        const SegmentObserver& observer = nullptr);
+
+    /**
+     * The KRONROD_NODES points at which the integrand is evaluated on
+     * [lower, upper], in the order it receives them: the centre, then
+     * (centre - dx_j, centre + dx_j) for the Kronrod abscissae outwards in.
+     *
+     * @param lower Segment start
+     * @param upper Segment end
+     * @param nodes Receives KRONROD_NODES points
+     */
+    static void KronrodNodes(double lower, double upper, double* nodes);
+
+    /**
+     * Breakpoints at the zeros of J1(m*a) on [0, upperBound], taken from
+     * the process-wide table of SpecialFunctions::BesselZeros.
+     *
+     * @param contactRadius Load radius a (m)
+     * @param upperBound Truncation point of the Hankel integral
+     * @return Sorted breakpoints starting at 0 and ending at upperBound
+     */
+    static std::vector<double> BesselJ1Breakpoints(double contactRadius, double upperBound);
+
+    /**
+     * Breakpoints at 0 and the first zeros of J1(m*a), for extrapolateTail
+     * (SpecialFunctions::BesselZeros).
+     *
+     * @param contactRadius Load radius a (m)
+     * @param intervals Number of zeros (intervals) to return
+     * @return Sorted breakpoints 0, j_{1,1}/a, ..., j_{1,intervals}/a
+     */
+    static std::vector<double> BesselJ1ZeroBreakpoints(double contactRadius, int intervals);
+
+private:
+    struct Segment {
+        double lower;
+        double upper;
+        Eigen::VectorXd value;
+        double error;
+        int failed = 0;  ///< Nodes with a non-finite value (the segment cannot converge)
+    };
+
+    /**
+     * Apply the 15-point Kronrod rule and its embedded 7-point Gauss rule to
+     * every segment (lower/upper set on entry). Nodes of all segments are
+     * evaluated as one batch, in groups of batchSize and in parallel when a
+     * pool is given. Non-finite node values count as failed and enter
+     * the rules as zero. The observer, if any, sees the segments first.
+     */
+    static void EvaluateSegments(const BatchIntegrand& f, int batchSize,
+                                 std::vector<Segment>& segments, ThreadPool* pool,
+                                 const SegmentObserver& observer);
+
+    /**
+     * Evaluate the segments, then bisect the worst one until their summed
+     * error meets max(absoluteTolerance, relativeTolerance * |sum|) or
+     * evaluations would exceed maxEvaluations.
+     *
+     * @return Final partition, in interval order
+     */
+    static std::vector<Segment> Refine(const BatchIntegrand& f, int batchSize,
+                                       std::vector<Segment> segments,
+                                       double absoluteTolerance, double relativeTolerance,
+                                       int maxEvaluations, int& evaluations, ThreadPool* pool,
+                                       const SegmentObserver& observer);
+
+    /** Partition-extrapolation over intervals (one per breakpoint interval) */
+    static HankelIntegrationResult Extrapolate(const BatchIntegrand& f, int batchSize,
+                                               const std::vector<Segment>& intervals,
+                                               const HankelIntegrationOptions& options,
+                                               ThreadPool* pool,
+                                               const SegmentObserver& observer);
+};
+
+} // namespace Pavement
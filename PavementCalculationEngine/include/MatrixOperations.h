@@ -1,17 +1,96 @@
 #pragma once
 
 #include <Eigen/Dense>
+#include <string>
 #include <vector>
 #include "PavementData.h"
+#include "BandedLU.h"
+#include "BatchedLU.h"
+#include "AssemblyPlan.h"
 
 namespace Pavement {
 
+/**
+ * Optional behaviour of the layered-system solve.
+ */
+struct SolveOptions {
+    /**
+     * Also compute the exact 2-norm condition number with a full SVD.
+     * Diagnostic only: costs far more than the solve itself.
+     */
+    bool exactConditionNumber = false;
+    
+    /**
+     * Iterative refinement steps allowed when the first solution misses
+     * RESIDUAL_TOLERANCE. Each step solves for a correction with the existing
+     * factors, using a residual accumulated in double-double; it stops early
+     * once the residual meets the tolerance or stops decreasing.
+     * 0 rejects such solutions at once.
+     */
+    int maxRefinementSteps = 3;
+};
+
+/**
+ * Outcome of one layered-system solve, returned by the Try* kernels.
+ */
+enum class SolveStatus {
+    Ok,                   ///< Solved to RESIDUAL_TOLERANCE
+    Singular,             ///< Zero pivot in the LU factors
+    ResidualTooLarge,     ///< Residual above RESIDUAL_TOLERANCE after refinement
+    NumericallySingular,  ///< Reciprocal condition below SINGULAR_RECIPROCAL_CONDITION (set by callers that reject it)
+    InvalidInput          ///< Plan does not match the kernel (e.g. layer count of a fixed-size solver)
+};
+
+/**
+ * Numerical diagnostics of one layered-system solve.
+ */
+struct SolveReport {
+    SolveStatus status = SolveStatus::Ok;  ///< Ok, or why the solve was rejected
+    double reciprocalCondition = 1.0;  ///< Hager/Higham 1-norm estimate of 1/cond (scaled system)
+    double residual = 0.0;             ///< ||M*x - b|| with the unscaled matrix (also set on ResidualTooLarge)
+    double exactConditionNumber = 0.0; ///< SVD 2-norm condition (only with SolveOptions::exactConditionNumber)
+    int refinementSteps = 0;           ///< Iterative refinement steps taken (0 if the first solution passed; also set on ResidualTooLarge)
+};
+
+/**
+ * Per-parameter results of MatrixOperations::SolveCoefficientsBatch.
+ */
+struct BatchSolveResult {
+    Eigen::MatrixXd coefficients;      ///< Column l holds the coefficients for m[l]
+    std::vector<SolveReport> reports;  ///< Diagnostics for m[l]; status is Ok if m[l] solved
+};
+
 /**
  * Matrix operations using Eigen library for pavement calculation.
  * Replaces manual Gauss-Jordan inversion with optimized LU decomposition.
+ *
+ * Interface conditions only couple neighbouring layers, so the 4n-2 system
+ * is banded (5 sub- and 5 superdiagonals for any layer count) and is solved
+ * with a banded LU in O(n). The matrix entries come from an AssemblyPlan.
  */
 class MatrixOperations {
 public:
+    /** Subdiagonals of the system matrix (row 4i+5 reaches back to column 4i) */
+    static constexpr int SYSTEM_LOWER_BANDWIDTH = 5;
+
+    /** Superdiagonals of the system matrix (row 4i+2 reaches forward to column 4i+7) */
+    static constexpr int SYSTEM_UPPER_BANDWIDTH = 5;
+
+    /** Smallest and largest layer counts with a compile-time sized solver */
+    static constexpr int MIN_FIXED_LAYER_COUNT = 2;
+    static constexpr int MAX_FIXED_LAYER_COUNT = 6;
+
+    /** Hankel parameters solved in lock-step by SolveCoefficientsBatch */
+    static constexpr int BATCH_SIZE = BatchedBandedMatrix::LANES;
+
+    /** Stack-allocated system matrix for a structure of LayerCount layers */
+    template <int LayerCount>
+    using FixedSystemMatrix = Eigen::Matrix<double, 4 * LayerCount - 2, 4 * LayerCount - 2>;
+
+    /** Stack-allocated coefficient vector for a structure of LayerCount layers */
+    template <int LayerCount>
+    using FixedCoefficients = Eigen::Matrix<double, 4 * LayerCount - 2, 1>;
+
     /**
      * Assemble system matrix for given Hankel parameter m.
      * Implements layered elastic theory boundary conditions.
@@ -24,101 +103,169 @@ public:
         double m, 
         const CalculationInput& input);
     
+    /**
+     * Assemble the system matrix in band storage (no dense k x k allocation).
+     * 
+     * @param m Hankel transform parameter
+     * @param plan Precomputed assembly plan of the structure
+     * @return Banded system matrix M for equation M*x = b
+     */
+    static BandedMatrix AssembleBandedSystem(
+        double m, 
+        const AssemblyPlan& plan);
+    
     /**
      * Solve linear system M*x = b for layer coefficients.
-     * Uses Eigen's partial pivoting LU decomposition for numerical stability.
+     * Uses a banded LU with partial pivoting inside the band, so the cost
+     * grows linearly with the layer count.
+     * 
+     * The reciprocal condition number is estimated on every solve from the
+     * LU factors (Hager/Higham); a warning is logged above
+     * CONDITION_NUMBER_WARNING_THRESHOLD. A solution that misses
+     * RESIDUAL_TOLERANCE is iteratively refined (SolveOptions::maxRefinementSteps).
      * 
      * @param m Hankel transform parameter
      * @param input Calculation input with layer properties
+     * @param report Optional solve diagnostics (conditioning and residual)
+     * @param options Optional diagnostics to enable
+     * @return Coefficient vector x
+     * @throws std::runtime_error if matrix is singular or the residual stays
+     *         above RESIDUAL_TOLERANCE after refinement
+     */
+    static Eigen::VectorXd SolveCoefficients(
+        double m, 
+        const CalculationInput& input,
+        SolveReport* report = nullptr,
+        const SolveOptions& options = SolveOptions());
+    
+    /**
+     * SolveCoefficients with a plan built once per structure: for each m only
+     * the exponentials are evaluated and the planned slots filled.
+     * 
+     * @param m Hankel transform parameter
+     * @param plan Precomputed assembly plan of the structure
+     * @param report Optional solve diagnostics (conditioning and residual)
+     * @param options Optional diagnostics to enable
      * @return Coefficient vector x
      * @throws std::runtime_error if matrix is singular or solution fails
      */
     static Eigen::VectorXd SolveCoefficients(
         double m, 
-        const CalculationInput& input);
+        const AssemblyPlan& plan,
+        SolveReport* report = nullptr,
+        const SolveOptions& options = SolveOptions());
 
-private:
     /**
-     * Compute cumulative layer depths from thicknesses.
+     * SolveCoefficients for up to BATCH_SIZE Hankel parameters at once.
+     * The systems share size and pattern, so they are assembled side by side
+     * (one SIMD lane per m) and scaled, factored and solved in lock-step by
+     * BatchedBandedLU. Each lane performs the arithmetic of SolveCoefficients.
+     * A failing m does not throw: its status is returned in its report.
+     * Like the Try* kernels, the batch does not log.
      * 
-     * @param thicknesses Layer thicknesses in meters
-     * @return Vector of depths from surface [0, h1, h1+h2, ...]
+     * @param m Hankel transform parameters
+     * @param count Number of parameters (1..BATCH_SIZE)
+     * @param plan Precomputed assembly plan of the structure
+     * @param options Optional diagnostics to enable
+     * @return Coefficients and diagnostics (status included) for every m
+     * @throws std::invalid_argument if count is outside 1..BATCH_SIZE
      */
-    static std::vector<double> ComputeLayerDepths(
-        const std::vector<double>& thicknesses);
-    
+    static BatchSolveResult SolveCoefficientsBatch(
+        const double* m,
+        int count,
+        const AssemblyPlan& plan,
+        const SolveOptions& options = SolveOptions());
+
     /**
-     * Assemble matrix block for layer interface boundary conditions.
-     * Handles bonded, unbonded, and semi-bonded interface types.
+     * Fixed-size variant of SolveCoefficients for the common 2-6 layer stacks.
+     * Assembly, scaling and the partial-pivoting LU all run on stack storage
+     * with sizes known at compile time; results match SolveCoefficients to
+     * rounding. Instantiated for MIN_FIXED_LAYER_COUNT..MAX_FIXED_LAYER_COUNT.
      * 
-     * @param M System matrix to populate (modified in place)
-     * @param layerIndex Layer index (0-based)
+     * @tparam LayerCount Number of layers (must equal plan.LayerCount())
      * @param m Hankel transform parameter
-     * @param input Calculation input
-     * @param depths Cumulative layer depths
+     * @param plan Precomputed assembly plan of the structure
+     * @param report Optional solve diagnostics (conditioning and residual)
+     * @param options Optional diagnostics to enable
+     * @return Coefficient vector x
+     * @throws std::invalid_argument if plan.LayerCount() != LayerCount
+     * @throws std::runtime_error if matrix is singular or solution fails
      */
-    static void AssembleInterfaceBlock(
-        Eigen::MatrixXd& M,
-        int layerIndex,
-        double m,
-        const CalculationInput& input,
-        const std::vector<double>& depths);
-    
+    template <int LayerCount>
+    static FixedCoefficients<LayerCount> SolveCoefficientsFixed(
+        double m, 
+        const AssemblyPlan& plan,
+        SolveReport* report = nullptr,
+        const SolveOptions& options = SolveOptions());
+
     /**
-     * Assemble bonded interface conditions (continuous displacement and stress).
+     * Status-returning kernels of SolveCoefficients and SolveCoefficientsFixed
+     * for the integration loops: the same
+     * arithmetic, but a failed solve is returned as a status (also stored in
+     * report->status) instead of a thrown, formatted message, and nothing is
+     * logged. The throwing functions above are wrappers around these.
+     * They are not noexcept: the dynamic kernels allocate work storage (and
+     * the fixed ones do for SolveOptions::exactConditionNumber), so
+     * std::bad_alloc can still escape.
      * 
-     * @param M System matrix
-     * @param row Starting row index
-     * @param layerIndex Layer index
-     * @param m Hankel parameter
-     * @param input Calculation input
-     * @param depths Layer depths
+     * @param m Hankel transform parameter
+     * @param plan Precomputed assembly plan of the structure
+     * @param coefficients Solution (left unspecified unless Ok)
+     * @param report Optional solve diagnostics
+     * @param options Optional diagnostics to enable
+     * @return SolveStatus::Ok, Singular or ResidualTooLarge
      */
-    static void AssembleBondedInterface(
-        Eigen::MatrixXd& M,
-        int row,
-        int layerIndex,
+    static SolveStatus TrySolveCoefficients(
         double m,
-        const CalculationInput& input,
-        const std::vector<double>& depths);
-    
+        const AssemblyPlan& plan,
+        Eigen::VectorXd& coefficients,
+        SolveReport* report = nullptr,
+        const SolveOptions& options = SolveOptions());
+
+    /** TrySolveCoefficients on stack storage; InvalidInput unless plan.LayerCount() equals LayerCount */
+    template <int LayerCount>
+    static SolveStatus TrySolveCoefficientsFixed(
+        double m,
+        const AssemblyPlan& plan,
+        FixedCoefficients<LayerCount>& coefficients,
+        SolveReport* report = nullptr,
+        const SolveOptions& options = SolveOptions());
+
     /**
-     * Assemble unbonded interface conditions (continuous normal stress, zero shear).
+     * Short description of a status, e.g. for summaries of failed points.
      * 
-     * @param M System matrix
-     * @param row Starting row index
-     * @param layerIndex Layer index
-     * @param m Hankel parameter
-     * @param input Calculation input
-     * @param depths Layer depths
+     * @param status Solve outcome
+     * @return Static string
      */
-    static void AssembleUnbondedInterface(
-        Eigen::MatrixXd& M,
-        int row,
-        int layerIndex,
-        double m,
-        const CalculationInput& input,
-        const std::vector<double>& depths);
+    static const char* StatusMessage(SolveStatus status) noexcept;
 
+private:
     /**
-     * Assemble surface boundary conditions (zero shear stress, applied normal stress).
+     * Log and throw the failure of a Try* kernel (throwing wrappers only).
      * 
-     * @param M System matrix
-     * @param m Hankel transform parameter
-     * @param input Calculation input
+     * @param report Diagnostics of the failed solve
+     * @param m Hankel transform parameter (for the message)
+     * @throws std::runtime_error always
      */
-    static void AssembleSurfaceBoundary(
-        Eigen::MatrixXd& M,
-        double m,
-        const CalculationInput& input);
+    [[noreturn]] static void ThrowSolveFailure(const SolveReport& report, double m);
     
     /**
-     * Check matrix condition number for numerical stability warning.
+     * Exact 2-norm condition number from a full SVD (opt-in diagnostic).
+     * Dynamic-size on purpose: fixed-size JacobiSVD instantiations trip
+     * -Wmaybe-uninitialized inside Eigen, and this path is never hot.
      * 
      * @param M Matrix to check
-     * @return Condition number estimate
+     * @return Condition number (infinity if numerically singular)
      */
     static double CheckConditionNumber(const Eigen::MatrixXd& M);
+    
+    /**
+     * Log a warning when the estimated condition number is too high.
+     * 
+     * @param reciprocalCondition Estimated 1/cond of the scaled system
+     * @param m Hankel transform parameter (for the message)
+     */
+    static void WarnIfIllConditioned(double reciprocalCondition, double m);
 };
 
 } // namespace Pavement
\ No newline at end of file
@@ -37,6 +37,7 @@ typedef enum {
     PAVEMENT_ERROR_NULL_POINTER = 2,   ///< Null pointer provided
     PAVEMENT_ERROR_ALLOCATION = 3,     ///< Memory allocation failed
     PAVEMENT_ERROR_CALCULATION = 4,    ///< Calculation error (singular matrix, overflow, etc.)
+    PAVEMENT_ERROR_CANCELLED = 5,      ///< Background job cancelled before the calculation ran
     PAVEMENT_ERROR_UNKNOWN = 99        ///< Unknown error occurred
 } PavementErrorCode;
 
@@ -56,7 +57,7 @@ typedef enum {
  */
 typedef struct {
     // Layer configuration
-    int nlayer;                    ///< Number of layers (1 to 20)
+    int nlayer;                    ///< Number of layers (2 to 50)
     double* poisson_ratio;         ///< Poisson''s ratios for each layer (nlayer elements)
     double* young_modulus;         ///< Young''s moduli in MPa (nlayer elements)
     double* thickness;             ///< Layer thicknesses in meters (nlayer elements)
@@ -116,6 +117,13 @@ PAVEMENT_API int PavementCalculate(
  * 
  * This function uses only negative exponentials exp(-m*h) to avoid overflow
  * when m*h > 30, ensuring all matrix elements remain bounded (less than or equal to 1.0).
+ * For every Hankel parameter the layers are coupled by reflection/transmission
+ * matrices in one O(nlayer) sweep from the half-space upward, and the responses
+ * are integrated over m with the engine's adaptive quadrature.
+ * 
+ * Results are given on the wheel axis at each z coordinate (the second wheel of
+ * a twin load is superposed; horizontal strains are along the axle). A z listed
+ * twice at an interface gives the upper layer, then the lower one.
  * 
  * Based on academic research by Qiu et al. (2025), Dong et al. (2021), Fan et al. (2022).
  * 
@@ -195,6 +203,280 @@ PAVEMENT_API int PavementCalculatePyMastic(
     PavementOutputC* output
 );
 
+// ============================================================================
+// Engine Handle
+// ============================================================================
+
+/**
+ * @brief Opaque calculation engine
+ * 
+ * Owns a worker pool, reusable solver workspaces and a result cache that
+ * outlive individual calls. Create one per process (or per configuration)
+ * and pass it to every calculation instead of paying the setup each time.
+ * An engine may be used from several threads at once.
+ */
+typedef struct PavementEngine PavementEngine;
+
+/**
+ * @brief Solver used by an engine
+ */
+typedef enum {
+    PAVEMENT_SOLVER_STANDARD = 0,  ///< Layered elastic solver of PavementCalculate (results at the interfaces)
+    PAVEMENT_SOLVER_STABLE = 1     ///< TRMM solver of PavementCalculateStable (results at z_coords)
+} PavementSolverType;
+
+/**
+ * @brief Minimum severity written by the process-wide logger (PavementSetLogLevel)
+ */
+typedef enum {
+    PAVEMENT_LOG_DEBUG = 0,
+    PAVEMENT_LOG_INFO = 1,
+    PAVEMENT_LOG_WARNING = 2,
+    PAVEMENT_LOG_ERROR = 3,
+    PAVEMENT_LOG_CRITICAL = 4
+} PavementLogLevel;
+
+/**
+ * @brief Set the minimum severity of the logger
+ * 
+ * The logger is process-wide: the level applies to every engine and to
+ * the one-shot calculations alike. The default is PAVEMENT_LOG_INFO.
+ * 
+ * @param level Minimum severity (see PavementLogLevel)
+ * @return PAVEMENT_SUCCESS, or PAVEMENT_ERROR_INVALID_INPUT for an unknown level
+ */
+PAVEMENT_API int PavementSetLogLevel(int level);
+
+/**
+ * @brief Engine configuration (C-compatible), fixed for the engine lifetime
+ * 
+ * Fill with PavementEngineDefaultConfig, then override fields as needed.
+ */
+typedef struct {
+    int solver;                    ///< Solver (see PavementSolverType)
+    int thread_count;              ///< Worker threads including the caller (1 = serial, <= 0 = all cores)
+    double absolute_tolerance;     ///< Absolute tolerance of the Hankel integral (> 0)
+    double relative_tolerance;     ///< Relative tolerance of the Hankel integral (> 0)
+    int max_evaluations;           ///< Integrand evaluation budget per calculation (> 0)
+    int result_cache_capacity;     ///< Results kept for repeated inputs (0 disables, >= 0)
+} PavementEngineConfigC;
+
+/**
+ * @brief Fill a configuration with the defaults
+ * 
+ * Standard solver, serial, default integration tolerances, no result cache.
+ * 
+ * @param config Configuration to fill (no-op if NULL)
+ */
+PAVEMENT_API void PavementEngineDefaultConfig(PavementEngineConfigC* config);
+
+/**
+ * @brief Create a calculation engine
+ * 
+ * @param config Configuration (NULL selects the defaults)
+ * @return New engine, or NULL if the configuration is invalid or creation
+ *         failed (see PavementGetLastError)
+ * @note Release with PavementEngineDestroy
+ */
+PAVEMENT_API PavementEngine* PavementEngineCreate(const PavementEngineConfigC* config);
+
+/**
+ * @brief Destroy an engine and join its worker threads
+ * 
+ * @param engine Engine to destroy (can be NULL, in which case no-op)
+ * @note No call may be using the engine any more
+ */
+PAVEMENT_API void PavementEngineDestroy(PavementEngine* engine);
+
+/**
+ * @brief Calculate one structure with an engine
+ * 
+ * Same input and output contract as PavementCalculate (standard solver) or
+ * PavementCalculateStable (stable solver), without the per-call setup.
+ * 
+ * @param engine Engine (must not be NULL)
+ * @param input Pointer to input structure (must not be NULL)
+ * @param output Pointer to output structure (must not be NULL, will be populated by DLL)
+ * @return PAVEMENT_SUCCESS on success, error code otherwise
+ * @note Output arrays are allocated by the DLL and must be freed with PavementFreeOutput
+ */
+PAVEMENT_API int PavementEngineCalculate(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    PavementOutputC* output
+);
+
+/**
+ * @brief Calculate many structures with an engine in one call
+ * 
+ * The structures are spread over the engine's worker threads (serially for
+ * a single-threaded engine) and share its solver workspaces and result
+ * cache. Each output receives the result of its input as from
+ * PavementEngineCalculate, including its own success flag and error; one
+ * failing structure does not stop the others.
+ * 
+ * @param engine Engine (must not be NULL)
+ * @param inputs Array of count input structures (can be NULL if count is 0)
+ * @param count Number of structures (>= 0)
+ * @param outputs Array of count output structures, populated by DLL (can be NULL if count is 0)
+ * @param failed_count Receives the number of failed structures (can be NULL)
+ * @return PAVEMENT_SUCCESS if every structure succeeded, otherwise the error
+ *         code of the first failed structure (PavementGetLastError gives its message)
+ * @note Free every output with PavementFreeOutput, failed ones included
+ */
+PAVEMENT_API int PavementCalculateBatch(
+    PavementEngine* engine,
+    const PavementInputC* inputs,
+    int count,
+    PavementOutputC* outputs,
+    int* failed_count
+);
+
+/**
+ * @brief Caller-owned result storage for PavementCalculateInto (C-compatible)
+ * 
+ * One contiguous block holds all quantities: point i of a quantity is
+ * block[offset + i * point_stride]. Offsets k * nz with stride 1 give one
+ * array per quantity; offsets 0..4 with stride 5 give one record per point.
+ * Quantities must not overlap; an offset of -1 skips the quantity.
+ * Quantities and units are those of PavementOutputC.
+ */
+typedef struct {
+    double* block;                 ///< Caller-owned buffer (e.g. a pinned managed array)
+    int block_length;              ///< Number of doubles in block
+    int point_stride;              ///< Doubles between consecutive points of one quantity (>= 1)
+    int deflection_offset;         ///< Index of the first deflection in mm (-1 to skip)
+    int vertical_stress_offset;    ///< Index of the first vertical stress in kPa (-1 to skip)
+    int horizontal_strain_offset;  ///< Index of the first horizontal strain in microstrain (-1 to skip)
+    int radial_strain_offset;      ///< Index of the first radial strain in microstrain (-1 to skip)
+    int shear_stress_offset;       ///< Index of the first shear stress in kPa (-1 to skip)
+} PavementResultBufferC;
+
+/**
+ * @brief Calculate one structure with an engine into caller-owned storage
+ * 
+ * Same results as PavementEngineCalculate, written in place: nothing is
+ * allocated for the caller and there is nothing to free. The conversion
+ * buffers are kept per calling thread and reused by repeated calls (e.g.
+ * over a batch with one pinned block). The call is allocation-free only
+ * when the engine serves the result from its cache; solving a structure
+ * allocates work storage inside the solver on every call.
+ * 
+ * @param engine Engine (must not be NULL)
+ * @param input Pointer to input structure (must not be NULL)
+ * @param buffer Result storage for input->nz points (must not be NULL)
+ * @param calculation_time_ms Receives the calculation time in ms (can be NULL)
+ * @return PAVEMENT_SUCCESS on success, error code otherwise (message from
+ *         PavementGetLastError); the block is left untouched on error
+ */
+PAVEMENT_API int PavementCalculateInto(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    const PavementResultBufferC* buffer,
+    double* calculation_time_ms
+);
+
+/**
+ * @brief Identifier of a background job of an engine (> 0; 0 means submission failed)
+ */
+typedef long long PavementJobId;
+
+/**
+ * @brief Progress of a background job (C-compatible)
+ */
+typedef struct {
+    int completed_structures;        ///< Structures calculated (or failed) so far
+    int total_structures;            ///< Structures in the job
+    long long integration_points;    ///< Hankel integrand evaluations of the completed structures
+} PavementProgressC;
+
+/**
+ * @brief Called after each structure of a job completes
+ * 
+ * Runs on an engine worker thread; calls for one job never overlap.
+ * progress is valid only during the call.
+ */
+typedef void (*PavementProgressCallback)(PavementJobId job, const PavementProgressC* progress, void* user_data);
+
+/**
+ * @brief Called once when a job has finished or been cancelled
+ * 
+ * Runs on an engine worker thread. outputs holds one result per submitted
+ * structure, in order; structures skipped by PavementCancel report
+ * PAVEMENT_ERROR_CANCELLED. The outputs are freed by the engine when the
+ * callback returns: copy what must be kept.
+ * 
+ * @param status PAVEMENT_SUCCESS, PAVEMENT_ERROR_CANCELLED, or the error code
+ *        of the first failed structure
+ */
+typedef void (*PavementCompletionCallback)(PavementJobId job, int status, const PavementOutputC* outputs,
+                                           int count, void* user_data);
+
+/**
+ * @brief Calculate a batch of structures in the background on an engine's workers
+ * 
+ * Returns at once. The inputs are copied before the call returns, so the
+ * caller may release them immediately. Structures run as in
+ * PavementCalculateBatch (a serial engine runs them one after another on a
+ * background thread). Callbacks must not call PavementWait or
+ * PavementEngineDestroy; destroying the engine cancels its jobs and waits
+ * for their completion callbacks.
+ * 
+ * Progress and cancellation act per structure: a structure already being
+ * integrated runs to completion.
+ * 
+ * @param engine Engine (must not be NULL)
+ * @param inputs Array of count input structures (may be NULL if count is 0)
+ * @param count Number of structures (>= 0)
+ * @param on_complete Completion callback (can be NULL)
+ * @param on_progress Progress callback (can be NULL)
+ * @param user_data Passed unchanged to both callbacks
+ * @return Job identifier, or 0 on error (message from PavementGetLastError)
+ */
+PAVEMENT_API PavementJobId PavementSubmitBatch(
+    PavementEngine* engine,
+    const PavementInputC* inputs,
+    int count,
+    PavementCompletionCallback on_complete,
+    PavementProgressCallback on_progress,
+    void* user_data
+);
+
+/**
+ * @brief Calculate one structure in the background on an engine's workers
+ * 
+ * Same as PavementSubmitBatch with a single structure and no progress callback.
+ * 
+ * @return Job identifier, or 0 on error (message from PavementGetLastError)
+ */
+PAVEMENT_API PavementJobId PavementSubmit(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    PavementCompletionCallback on_complete,
+    void* user_data
+);
+
+/**
+ * @brief Cancel the structures of a job that have not started
+ * 
+ * The completion callback still runs. Whenever this returns
+ * PAVEMENT_SUCCESS its status is PAVEMENT_ERROR_CANCELLED, even if every
+ * structure had already been calculated.
+ * 
+ * @return PAVEMENT_SUCCESS if the job's completion callback had not started,
+ *         PAVEMENT_ERROR_INVALID_INPUT if the job is unknown or already completing
+ */
+PAVEMENT_API int PavementCancel(PavementEngine* engine, PavementJobId job);
+
+/**
+ * @brief Block until a job has finished, completion callback included
+ * 
+ * Returns at once for unknown or finished jobs. Must not be called from a callback.
+ * 
+ * @return PAVEMENT_SUCCESS, or PAVEMENT_ERROR_NULL_POINTER if engine is NULL
+ */
+PAVEMENT_API int PavementWait(PavementEngine* engine, PavementJobId job);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2,6 +2,13 @@
 
 #include "PavementData.h"
 #include "MatrixOperations.h"
+#include "HankelIntegrator.h"
+#include "ChebyshevInterpolant.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace Pavement {
 
@@ -26,9 +33,42 @@ struct SolicitationComponents {
  */
 class PavementCalculator {
 public:
+    /**
+     * Numerical settings of the calculator.
+     */
+    struct CalculatorConfig {
+        HankelIntegrationOptions integration;  ///< Tolerances and budget of the Hankel integral
+        int threadCount = 1;                   ///< Threads for the m-points (1 = serial, <= 0 = all cores)
+        SolveOptions solver;                   ///< Per-m solve diagnostics (e.g. exact SVD condition)
+        bool batchedSolver = true;             ///< Solve MatrixOperations::BATCH_SIZE m-points per lock-step SIMD solve
+        ChebyshevOptions interpolation;        ///< Interpolate the coefficients in m from the solves of earlier Kronrod rules (off by default)
+    };
+    
+    PavementCalculator();
+    explicit PavementCalculator(const CalculatorConfig& config);
+    
     /**
      * Calculate stresses, strains, and deflections for pavement structure.
      * Uses Hankel transforms and layered elastic theory with Eigen matrix operations.
+     * The Hankel integral is evaluated adaptively to the configured tolerance;
+     * the achieved error and evaluation count are returned in output.integration.
+     * With threadCount != 1 the m-points are solved on a worker pool; results
+     * are bit-identical to the serial run.
+     * 
+     * With config.integration.extrapolateTail the integral is not truncated
+     * at HANKEL_INTEGRATION_BOUND / a: the partial sums up to successive
+     * zeros of J1(m*a) are extrapolated to infinity (Wynn epsilon), using
+     * only as many intervals as the tolerance needs (output.integration.partitions).
+     * 
+     * With config.interpolation.enabled, every coefficient vector solved at
+     * a quadrature node is kept. Once a segment of the adaptive refinement
+     * holds config.interpolation.minSamples of them (from the rules of the
+     * segments it was bisected from), a polynomial through them is checked
+     * at config.interpolation.checkPoints of the segment's own nodes and,
+     * if it passes, interpolates the coefficients at its other nodes. The
+     * check nodes belong to the rule, so a failed check costs no extra
+     * solve. The check tolerance is kept an order below
+     * config.integration.relativeTolerance.
      * 
      * @param input Structured input data (validated)
      * @return Calculation results for all interfaces
@@ -36,17 +76,127 @@ public:
      * @throws std::runtime_error if matrix solution fails
      */
     CalculationOutput Calculate(const CalculationInput& input);
+    
+    /**
+     * Calculate one structure under several surface load cases, each a
+     * pressure on its own contact radius (e.g. the classes of a traffic
+     * spectrum). The layer system does not depend on the load, so every
+     * Hankel parameter is solved once for input.pressure and integrated
+     * against each case's kernel a*J1(m*a), scaled by its pressure: the cost
+     * grows with the number of cases only through the kernels.
+     * 
+     * The cases are integrated as one vector, so the adaptive refinement and
+     * the integration report (shared by all outputs) cover all of them.
+     * When the radii differ, the integration intervals follow the zeros of
+     * the largest radius up to the truncation bound of the smallest, and
+     * config.integration.extrapolateTail is not applied.
+     * config.interpolation does not apply here.
+     * 
+     * @param input Structured input data (validated; its pressure is only a
+     *              reference, its contact radius the default of the cases)
+     * @param loads Load cases
+     * @return Calculation results, one per load case in the order of loads
+     * @throws std::invalid_argument if input validation fails, loads is empty
+     *         or a case has an invalid pressure or contact radius
+     */
+    std::vector<CalculationOutput> CalculateLoadCases(const CalculationInput& input,
+                                                      const std::vector<SurfaceLoad>& loads);
+    
+    const CalculatorConfig& GetConfig() const { return config_; }
+    void SetConfig(const CalculatorConfig& config);
+    
+    /**
+     * Run the m-points on an existing pool (e.g. one shared by several
+     * calculators) instead of a pool of our own. config.threadCount follows
+     * the pool; null runs serially.
+     */
+    void SetThreadPool(std::shared_ptr<ThreadPool> pool);
 
 private:
+    /** Per-m evaluation kernel, chosen once per Calculate call */
+    using HankelEvaluator = SolveStatus (PavementCalculator::*)(
+        double m, const AssemblyPlan& plan, const CalculationInput& input,
+        CalculationOutput& output, SolveReport& report, double* coefficients);
+    
+    /**
+     * Pick the fixed-size kernel for 2-6 layers, the dynamic one otherwise.
+     * Interface types are not dispatched on: they only change which entries
+     * the assembly plan writes, never the system size or bandwidth, so every
+     * kernel handles bonded and frictionless interfaces alike.
+     * 
+     * @param layerCount Number of layers of the structure
+     * @return Member function evaluating one Hankel parameter
+     */
+    static HankelEvaluator SelectEvaluator(int layerCount);
+    
+    /**
+     * Evaluate up to MatrixOperations::BATCH_SIZE Hankel parameters with one
+     * lock-step batched solve. A failing parameter does not throw; its status
+     * is returned in statuses[l] and outputs[l] is left untouched. Only an
+     * allocation failure of the batched solve propagates.
+     * 
+     * @param m Hankel transform parameters (count of them)
+     * @param count Number of parameters (1..MatrixOperations::BATCH_SIZE)
+     * @param plan Assembly plan of input, built once per Calculate call
+     * @param input Calculation input
+     * @param outputs Results storage per parameter (accumulated)
+     * @param reports Solve diagnostics per parameter
+     * @param statuses Solve status per parameter (NumericallySingular when the
+     *                 system solved but is too ill-conditioned to integrate)
+     * @param coefficients Optional per parameter: a non-null coefficients[l]
+     *                     receives the plan.Size() coefficients of m[l] when it solved
+     */
+    void CalculateForHankelParameterBatch(const double* m, int count,
+                                          const AssemblyPlan& plan,
+                                          const CalculationInput& input,
+                                          CalculationOutput* outputs,
+                                          SolveReport* reports,
+                                          SolveStatus* statuses,
+                                          double* const* coefficients = nullptr);
+    
+    /**
+     * Exact coefficients for several Hankel parameters (interpolation checks),
+     * batched like the integrand when config.batchedSolver is set.
+     * 
+     * @param m Hankel transform parameters
+     * @param plan Assembly plan of the structure
+     * @param refinementSteps Incremented by the refinement steps of every solve
+     * @return Column i holds the coefficients for m[i]
+     * @throws std::runtime_error if any solve fails or is numerically singular
+     */
+    Eigen::MatrixXd SolveCoefficientColumns(const std::vector<double>& m,
+                                            const AssemblyPlan& plan,
+                                            std::atomic<int>& refinementSteps);
+    
     /**
      * Perform Hankel transform integration for single parameter m.
      * 
      * @param m Hankel transform parameter
+     * @param plan Assembly plan of input, built once per Calculate call
      * @param input Calculation input
      * @param output Results storage (accumulated)
+     * @param report Solve diagnostics (e.g. iterative refinement steps)
+     * @param coefficients Optional: receives the plan.Size() solved
+     *                     coefficients (interpolation samples); untouched on failure
+     * @return SolveStatus::Ok, or why output was left untouched
+     */
+    SolveStatus CalculateForHankelParameter(double m, const AssemblyPlan& plan,
+                                            const CalculationInput& input, 
+                                            CalculationOutput& output,
+                                            SolveReport& report,
+                                            double* coefficients);
+    
+    /**
+     * CalculateForHankelParameter on stack storage sized at compile time.
+     * 
+     * @tparam LayerCount Number of layers (equals input.layerCount)
      */
-    void CalculateForHankelParameter(double m, const CalculationInput& input, 
-                                   CalculationOutput& output);
+    template <int LayerCount>
+    SolveStatus CalculateForHankelParameterFixed(double m, const AssemblyPlan& plan,
+                                                 const CalculationInput& input,
+                                                 CalculationOutput& output,
+                                                 SolveReport& report,
+                                                 double* coefficients);
     
     /**
      * Calculate stresses and strains at all interfaces for given coefficients.
@@ -57,25 +207,35 @@ private:
      * @param output Results storage
      */
     void CalculateSolicitationsFromCoefficients(
-        const Eigen::VectorXd& coefficients,
+        const Eigen::Ref<const Eigen::VectorXd>& coefficients,
         double m,
         const CalculationInput& input,
         CalculationOutput& output);
     
     /**
-     * Compute stress and strain at specific depth and radial position.
+     * Compute stress, strain and deflection on the load axis from one layer's
+     * coefficients, each part of the layer solution evaluated at its own t.
      * 
-     * @param coeffs Layer coefficients [A, B, C, D]
-     * @param depth Depth from surface
+     * @param coeffs Layer coefficients [B, D, A, C] (A = C = 0 in the half-space)
      * @param m Hankel parameter
+     * @param downwardT m * (z - z_top) of the downward part
+     * @param downwardDecay exp(-downwardT)
+     * @param upwardT m * (z - z_bottom) of the upward part
+     * @param upwardDecay exp(upwardT)
      * @param layerProps Layer elastic properties
      * @return Stress/strain components
      */
     SolicitationComponents ComputeSolicitations(
         const Eigen::Vector4d& coeffs,
-        double depth,
         double m,
+        double downwardT,
+        double downwardDecay,
+        double upwardT,
+        double upwardDecay,
         const LayerProperties& layerProps);
+    
+    CalculatorConfig config_;
+    std::shared_ptr<ThreadPool> pool_;  ///< Null when running serially
 };
 
 } // namespace Pavement
\ No newline at end of file
@@ -40,6 +40,33 @@ struct CalculationInput {
     void SetDefaults();
 };
 
+/**
+ * @brief One load case of PavementCalculator::CalculateLoadCases: a uniform
+ * pressure on its own circular contact area (e.g. one class of a traffic
+ * spectrum)
+ */
+struct SurfaceLoad {
+    double pressure = 0.0;       // Contact pressure (MPa, 0-5)
+    double contactRadius = 0.0;  // Contact radius (meters, 0-1; 0 = that of the input)
+};
+
+/**
+ * @brief Accuracy actually achieved by the Hankel integration
+ */
+struct IntegrationReport {
+    double errorEstimate = 0.0;   // Estimated absolute error (max over all results)
+    int evaluations = 0;          // Integrand evaluations (one linear solve each)
+    int intervals = 0;            // Subintervals in the final adaptive partition
+    int failedEvaluations = 0;    // Evaluations whose solve failed (contributed zero, never converged)
+    int refinementSteps = 0;      // Iterative refinement steps over all solves (residual rescue)
+    int interpolatedEvaluations = 0; // Evaluations served by Chebyshev interpolation (no solve)
+    int interpolationSolves = 0;  // Chebyshev self-check solves (quadrature nodes, counted in evaluations)
+    int rejectedInterpolants = 0; // Segments whose Chebyshev fit failed its self-check (solved exactly)
+    bool converged = false;       // True if the tolerance was reached with no failed evaluation
+    int partitions = 0;           // J1(m*a) zero intervals summed before extrapolation (0 = truncated integral)
+    double extrapolationError = 0.0; // Wynn epsilon error estimate, included in errorEstimate
+};
+
 /**
  * @brief Encapsulated output data structure for calculation results
  * 
@@ -53,6 +80,8 @@ struct CalculationOutput {
     std::vector<double> epsilonZ;    // Vertical strain (microdef)
     std::vector<double> deflection;  // Vertical displacement (mm)
     
+    IntegrationReport integration;   // Hankel integration accuracy and cost
+    
     // Constructor
     CalculationOutput();
     
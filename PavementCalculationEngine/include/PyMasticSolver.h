@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 #include <Eigen/Dense>
+#include "ThreadPool.h"
 
 // Platform-specific DLL export/import macros
 #ifdef _WIN32
@@ -24,11 +29,47 @@
  * Reference: Mostafa Nakhaei PyMastic (Apache 2.0)
  * Accuracy: <0.1% vs Python reference, <0.5% vs academic tables
  * 
+ * A solver instance keeps its worker pool and live structure between calls,
+ * so it must not be used from several threads at once; use one solver per
+ * thread instead.
+ * 
  * @author Pavement Calculation Engine Team
  * @date 2025-10-07
  */
 class PAVEMENT_API PyMasticSolver {
 public:
+    /**
+     * @brief Interface matrix solvers, named by Input::inverser
+     */
+    enum class Inverser {
+        Solve,  ///< "solve": column-pivoting Householder QR
+        Inv,    ///< "inv": explicit inverse
+        Pinv,   ///< "pinv": SVD pseudo-inverse
+        Lu,     ///< "lu": partial-pivoting LU
+        Svd     ///< "svd": SVD least squares
+    };
+    
+    /**
+     * @brief Response quantities, combined into Input::responses
+     * 
+     * Strains are derived from the three stresses at the same point, so any
+     * strain runs the stress integrals without keeping the stress matrices.
+     */
+    enum Response : unsigned {
+        DisplacementZ = 1u << 0,
+        DisplacementH = 1u << 1,
+        StressZ = 1u << 2,
+        StressR = 1u << 3,
+        StressT = 1u << 4,
+        StrainZ = 1u << 5,
+        StrainR = 1u << 6,
+        StrainT = 1u << 7,
+        Displacements = DisplacementZ | DisplacementH,
+        Stresses = StressZ | StressR | StressT,
+        Strains = StrainZ | StrainR | StrainT,
+        AllResponses = Displacements | Stresses | Strains
+    };
+    
     /**
      * @brief Input parameters for PyMastic calculation
      */
@@ -50,9 +91,11 @@ public:
         std::vector<int> bonded_interfaces;    ///< Interface bonding: 1=bonded, 0=frictionless
         
         // Numerical parameters
-        int iterations = 40;                   ///< Hankel integration iterations (25-50)
+        int iterations = 40;                   ///< Hankel integration iterations (>= 1, typically 25-50)
         double ZRO = 7e-7;                     ///< Small value for numerical stability (1e-3 to 7e-7)
-        std::string inverser = "solve";        ///< Matrix solver: "solve", "inv", "pinv", "lu", "svd"
+        std::string inverser = "solve";        ///< Matrix solver: "solve", "inv", "pinv", "lu", "svd" (see ParseInverser)
+        int threads = 1;                       ///< Worker threads (1 = serial, <= 0 = all cores)
+        unsigned responses = AllResponses;     ///< Response flags to compute; the other Output matrices stay empty
         
         /**
          * @brief Validate input parameters
@@ -79,12 +122,18 @@ public:
         Eigen::MatrixXd strain_r;              ///< Radial strain (dimensionless)
         Eigen::MatrixXd strain_t;              ///< Tangential strain (dimensionless)
         
+        unsigned responses = AllResponses;     ///< Response flags allocated by Initialize()
+        
         /**
          * @brief Initialize output matrices with correct dimensions
          * @param n_z Number of depth points
          * @param n_x Number of horizontal points
+         * @param requested Response flags to allocate; the other matrices are left 0 x 0
          */
-        void Initialize(int n_z, int n_x);
+        void Initialize(int n_z, int n_x, unsigned requested = AllResponses);
+        
+        /** @brief True if the matrix of response was computed */
+        bool Has(Response response) const { return (responses & response) != 0; }
         
         /**
          * @brief Check if output contains valid (non-NaN) results
@@ -95,36 +144,199 @@ public:
     
     /**
      * @brief Compute pavement response using PyMastic algorithm
+     * 
+     * With input.threads != 1 the state-vector propagation is split across
+     * m and the response evaluation across depth rows and column tiles of
+     * the output grid, on a worker pool kept by the solver. Every task
+     * writes its own rows, columns or m-slice, so no mutable state is shared.
+     * Propagation and depth kernels are bit-identical to the serial run;
+     * the tiled matrix products agree with it to rounding.
+     * 
      * @param input Calculation parameters
      * @return Computed displacements, stresses, and strains
      */
     Output Compute(const Input& input);
     
+    // Live structure for interactive edits
+    /**
+     * @brief Compute and keep the structure live for in-place layer edits
+     * 
+     * Same responses as Compute() up to rounding. The solver additionally
+     * keeps the Hankel grid, the radial Bessel kernels, the solved interface
+     * matrices and, per m, a segment tree of the 4x4 cascade products, so
+     * UpdateLayerModulus() only redoes the work an edit touches.
+     * 
+     * @param input Calculation parameters
+     * @return Computed displacements, stresses, and strains
+     */
+    Output ComputeLive(const Input& input);
+    
+    /**
+     * @brief Change the modulus and Poisson's ratio of one live layer
+     * 
+     * Layer k only enters interface matrices k-1 and k (and the surface
+     * conditions for k = 0). Those are re-solved for every m and each
+     * cascade product is refreshed with O(log n) 4x4 products through its
+     * segment tree; the coefficients and responses are then recomputed with
+     * the kept grid and radial kernels. If the update throws, the live
+     * structure is dropped.
+     * 
+     * @param layer Layer index (0 = surface layer)
+     * @param E_modulus New elastic modulus
+     * @param nu New Poisson's ratio
+     * @return Responses of the edited structure
+     * @throws std::logic_error if there is no live structure
+     * @throws std::invalid_argument if the layer or the values are invalid
+     */
+    Output UpdateLayerModulus(int layer, double E_modulus, double nu);
+    
+    /**
+     * @brief Change the thickness of one live layer
+     * 
+     * Depths and the Hankel grid are normalised by the total thickness, so a
+     * thickness edit moves every interface and every m value: the live
+     * structure is rebuilt in full (as ComputeLive()).
+     * 
+     * @param layer Layer index (0 = surface layer, semi-infinite layer excluded)
+     * @param thickness New thickness
+     * @return Responses of the edited structure
+     * @throws std::logic_error if there is no live structure
+     * @throws std::invalid_argument if the layer or the thickness is invalid
+     */
+    Output UpdateLayerThickness(int layer, double thickness);
+    
+    /** @brief True once ComputeLive() has succeeded */
+    bool HasLiveStructure() const { return live_.active; }
+    
+    /**
+     * @brief Structure of the live state, edits included
+     * @throws std::logic_error if there is no live structure
+     */
+    const Input& LiveInput() const;
+    
+    /** @brief Interface matrices re-solved per m by the last live call */
+    int LastRebuiltInterfaces() const { return live_.rebuilt_interfaces; }
+    
     /**
      * @brief Get version information
      * @return Version string
      */
     static std::string GetVersion() { return "PyMastic C++ v1.0"; }
+    
+    /**
+     * @brief First positive zeros of J0 or J1
+     * 
+     * SpecialFunctions::BesselZeros: generated on demand and cached for the
+     * whole process, in the table the Hankel breakpoints are built from.
+     * Thread-safe.
+     * 
+     * @param order Bessel function order (0 or 1)
+     * @param count Number of zeros to return
+     * @return The first count zeros, ascending
+     * @throws std::invalid_argument for another order or a negative count
+     */
+    static std::vector<double> ComputeBesselZeros(int order, int count);
+    
+    /**
+     * @brief Map an Input::inverser name to its solver
+     * @param name "solve", "inv", "pinv", "lu" or "svd"
+     * @param inverser Set when the name is known
+     * @return false for an unknown name (Input::Validate() rejects it)
+     */
+    static bool ParseInverser(const std::string& name, Inverser& inverser);
+    
+    /**
+     * @brief Counters of the process-wide Hankel grid cache
+     */
+    struct GridCacheStats {
+        std::uint64_t hits = 0;                ///< Grids served from the cache
+        std::uint64_t misses = 0;              ///< Grids built by SetupHankelGrid
+        std::size_t entries = 0;               ///< Grids currently cached
+        std::size_t capacity = 0;              ///< Maximum cached grids (least recently used evicted)
+    };
+    
+    /**
+     * @brief Current hit/miss counters and size of the grid cache
+     * 
+     * The m grid and Gauss weights depend only on a_m / sumH, the offsets
+     * divided by sumH and iterations, so structures sharing those reuse one
+     * immutable grid across calls and solver instances. Thread-safe.
+     */
+    static GridCacheStats GetGridCacheStats();
+    
+    /**
+     * @brief Empty the grid cache, reset its counters and set its capacity
+     * @param capacity Maximum cached grids (0 disables caching)
+     */
+    static void ResetGridCache(std::size_t capacity = 64);
 
 private:
-    // Bessel function computation
     /**
-     * @brief Compute zeros of Bessel functions J0 and J1
-     * @param order Bessel function order (0 or 1)
-     * @param count Number of zeros to compute
-     * @return Vector of Bessel zeros
+     * @brief Hankel integration grid (shared immutably through the grid cache)
+     */
+    struct HankelGrid {
+        std::vector<double> m_values;          ///< Quadrature points, ascending
+        std::vector<double> ft_weights;        ///< Gauss weights of m_values
+    };
+    
+    /**
+     * @brief Radial factors of the response integrals for a fixed grid and x offsets
+     */
+    struct RadialKernels {
+        Eigen::MatrixXd J0;                    ///< J0(m*ro), n_m x n_x
+        Eigen::MatrixXd J1;                    ///< J1(m*ro), n_m x n_x
+        Eigen::VectorXd inverse_ro;            ///< 1/ro per x offset
+        Eigen::VectorXd load_weight;           ///< w * J1(m*alpha) / m per m
+    };
+    
+    /**
+     * @brief State kept by ComputeLive() for in-place edits
+     * 
+     * trees holds, for each m, a segment tree of 2*leaves matrices: node 1
+     * is the cascade product, node v is node 2v times node 2v+1, and the
+     * solved interface matrices sit at leaves + i (identity padding up to
+     * the power of two).
+     */
+    struct LiveState {
+        bool active = false;
+        Input input;
+        std::shared_ptr<const HankelGrid> grid;
+        std::vector<double> lamda_bc;
+        std::vector<double> R;
+        RadialKernels radial;
+        int leaves = 0;
+        std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d>> trees;
+        Eigen::MatrixXd A, B, C, D;
+        int rebuilt_interfaces = 0;
+    };
+    
+    LiveState live_;
+    std::shared_ptr<Pavement::ThreadPool> pool_;  ///< Null until a threaded run
+    
+    /**
+     * @brief Run body(begin, end) over chunks covering [0, count)
+     * 
+     * Serial (one chunk) when threads resolves to 1; otherwise the chunks,
+     * at least grain items each, run on the worker pool.
+     * 
+     * @param count Number of items
+     * @param grain Minimum items per chunk
+     * @param threads Requested thread count (Input::threads)
+     * @param body Chunk body (must be safe to call concurrently for disjoint ranges)
      */
-    std::vector<double> ComputeBesselZeros(int order, int count);
+    void ParallelChunks(int count, int grain, int threads,
+                        const std::function<void(int, int)>& body);
     
+    // Bessel function computation
     /**
-     * @brief Bessel function J0(x)
+     * @brief Bessel function J0(x) (Pavement::SpecialFunctions kernel)
      * @param x Argument
      * @return J0(x) value
      */
     double BesselJ0(double x);
     
     /**
-     * @brief Bessel function J1(x)
+     * @brief Bessel function J1(x) (Pavement::SpecialFunctions kernel)
      * @param x Argument  
      * @return J1(x) value
      */
@@ -133,6 +345,13 @@ private:
     // Hankel integration setup
     /**
      * @brief Setup Hankel integration m-values grid with Gauss quadrature
+     * 
+     * The breakpoints are 0 and the smallest iterations + 2 values among the
+     * J0 zeros scaled by each offset (j0_k / ro) and the J1 zeros scaled by
+     * the load radius (j1_k / alpha). Each scaled sequence is ascending, so
+     * they are combined by a k-way merge that stops once enough distinct
+     * breakpoints are found.
+     * 
      * @param input Calculation parameters
      * @param m_values Output m-values for integration
      * @param ft_weights Output Gauss quadrature weights
@@ -141,6 +360,17 @@ private:
                         std::vector<double>& m_values, 
                         std::vector<double>& ft_weights);
     
+    /**
+     * @brief Hankel grid of the input, from the grid cache or built and cached
+     * @param input Calculation parameters
+     * @return Shared immutable grid
+     */
+    std::shared_ptr<const HankelGrid> AcquireHankelGrid(const Input& input);
+    
+    struct GridCache;
+    /** @brief The process-wide grid cache (defined in PyMasticSolver.cpp) */
+    static GridCache& SharedGridCache();
+    
     // Boundary condition matrices
     /**
      * @brief Build left-side boundary condition matrix for interface i
@@ -166,20 +396,40 @@ private:
                                     const std::vector<double>& lamda_bc,
                                     const std::vector<double>& R);
     
+    /** @brief Interface solve left^-1 * right, picked once per call */
+    using InterfaceSolver = Eigen::Matrix4d (*)(const Eigen::Matrix4d& left_matrix,
+                                                const Eigen::Matrix4d& right_matrix) noexcept;
+    
     /**
-     * @brief Solve boundary condition matrices using selected inverser
+     * @brief Solve boundary condition matrices with one inverser
+     * 
+     * A non-finite result (singular left matrix) falls back to the SVD
+     * pseudo-inverse.
+     * 
+     * @tparam Method Solver method
      * @param left_matrix 4x4 left matrix
      * @param right_matrix 4x4 right matrix
-     * @param inverser Solver method ("solve", "inv", "pinv", "lu", "svd")
      * @return 4x4 solved matrix
      */
-    Eigen::Matrix4d SolveMatrix(const Eigen::Matrix4d& left_matrix,
-                               const Eigen::Matrix4d& right_matrix,
-                               const std::string& inverser);
+    template <Inverser Method>
+    static Eigen::Matrix4d SolveMatrix(const Eigen::Matrix4d& left_matrix,
+                                       const Eigen::Matrix4d& right_matrix) noexcept;
+    
+    /**
+     * @brief Dispatch input.inverser once, before the per-m loops
+     * @param input Validated calculation parameters
+     * @return SolveMatrix instantiation for input.inverser
+     */
+    static InterfaceSolver SelectInterfaceSolver(const Input& input);
     
     // State vector propagation
     /**
      * @brief Propagate state vector coefficients through layer stack
+     * 
+     * The solved 4x4 interface matrices are kept for every (m, interface) in
+     * one aligned buffer: the forward cascade builds them and the
+     * back-propagation reuses them.
+     * 
      * @param input Calculation parameters
      * @param m_values Hankel parameter values
      * @param A Output coefficient matrix A[m,layer]
@@ -192,12 +442,48 @@ private:
                              Eigen::MatrixXd& A, Eigen::MatrixXd& B,
                              Eigen::MatrixXd& C, Eigen::MatrixXd& D);
     
+    /**
+     * @brief Solve the surface conditions and back-propagate one m
+     * @param j Index of m in the coefficient matrices
+     * @param m Hankel parameter value
+     * @param input Calculation parameters
+     * @param lamda_bc Normalized layer depths
+     * @param cascade Product of all solved interface matrices
+     * @param solved Solved interface matrices, surface first
+     * @param A Output coefficient matrix A[m,layer] (row j filled)
+     * @param B Output coefficient matrix B[m,layer] (row j filled)
+     * @param C Output coefficient matrix C[m,layer] (row j filled)
+     * @param D Output coefficient matrix D[m,layer] (row j filled)
+     */
+    void BackPropagate(int j, double m, const Input& input,
+                       const std::vector<double>& lamda_bc,
+                       const Eigen::Matrix4d& cascade,
+                       const Eigen::Matrix4d* solved,
+                       Eigen::MatrixXd& A, Eigen::MatrixXd& B,
+                       Eigen::MatrixXd& C, Eigen::MatrixXd& D);
+    
+    /**
+     * @brief Recompute the tree nodes above the given leaves, bottom up
+     * @param tree Segment tree of one m (2*leaves matrices)
+     * @param leaves Padded leaf count
+     * @param interfaces Changed interface indices, ascending
+     */
+    static void RefreshCascade(Eigen::Matrix4d* tree, int leaves,
+                               const std::vector<int>& interfaces);
+    
     // Response calculation
     /**
      * @brief Compute pavement responses from state vector coefficients
+     * 
+     * Each response integral is a depth kernel (coefficients, exponentials)
+     * times a radial kernel (J0 or J1 of m*ro), so the Bessel values and
+     * exponentials are evaluated once per (x, m) and (z, m), and the sums
+     * over m for the whole grid are two dense matrix products. Only the
+     * depth terms input.responses needs enter the products.
+     * 
      * @param input Calculation parameters
      * @param m_values Hankel parameter values
-     * @param ft_weights Gauss quadrature weights
+     * @param radial Radial kernels of m_values (BuildRadialKernels)
      * @param A Coefficient matrix A
      * @param B Coefficient matrix B
      * @param C Coefficient matrix C
@@ -206,11 +492,25 @@ private:
      */
     void ComputeResponses(const Input& input,
                          const std::vector<double>& m_values,
-                         const std::vector<double>& ft_weights,
+                         const RadialKernels& radial,
                          const Eigen::MatrixXd& A, const Eigen::MatrixXd& B,
                          const Eigen::MatrixXd& C, const Eigen::MatrixXd& D,
                          Output& output);
     
+    /**
+     * @brief Bessel factors of the response integrals (independent of the layers)
+     * 
+     * J0 or J1 is left empty when no response in input.responses needs it.
+     * 
+     * @param input Calculation parameters
+     * @param m_values Hankel parameter values
+     * @param ft_weights Gauss quadrature weights
+     * @return J0/J1 of m*ro per x offset and the load weight per m
+     */
+    RadialKernels BuildRadialKernels(const Input& input,
+                                     const std::vector<double>& m_values,
+                                     const std::vector<double>& ft_weights);
+    
     // Utility methods
     /**
      * @brief Find layer index for given depth
@@ -226,4 +526,11 @@ private:
      * @return Normalized cumulative depths
      */
     std::vector<double> ComputeLamdaValues(const std::vector<double>& H);
+    
+    /**
+     * @brief Elastic ratios R[i] = E_i/E_{i+1} * (1+nu_{i+1})/(1+nu_i)
+     * @param input Calculation parameters
+     * @return One ratio per interface
+     */
+    std::vector<double> ComputeElasticRatios(const Input& input);
 };
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file SimdPack.h
+ * @brief Lane-parallel double arithmetic shared by the vector kernels
+ *
+ * One Pack holds Simd::LANES doubles. The AVX-512, AVX2, SSE2 and scalar
+ * variants expose the same operations, so kernels (BatchedBandedLU,
+ * SpecialFunctions) are written once. The variant follows the instruction
+ * set the including translation unit is compiled for: the ENABLE_AVX2 /
+ * ENABLE_AVX512 build options for the library as a whole, or the per-ISA
+ * flags of the SpecialFunctions kernel files.
+ *
+ * Each variant lives in its own inline namespace, so translation units
+ * built for different instruction sets never share an inline definition
+ * (the linker could otherwise keep the AVX copy for every caller).
+ *
+ * Internal header: include it from source files only.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+namespace Pavement {
+namespace Simd {
+
+#if defined(__AVX512F__)
+inline namespace Avx512 {
+
+constexpr int LANES = 8;   ///< One 512-bit register of doubles
+constexpr const char* INSTRUCTION_SET = "AVX-512";
+
+using Pack = __m512d;
+using Mask = __mmask8;
+
+inline Pack Load(const double* p) { return _mm512_loadu_pd(p); }
+inline void Store(double* p, Pack v) { _mm512_storeu_pd(p, v); }
+inline Pack Broadcast(double x) { return _mm512_set1_pd(x); }
+inline Pack Add(Pack a, Pack b) { return _mm512_add_pd(a, b); }
+inline Pack Sub(Pack a, Pack b) { return _mm512_sub_pd(a, b); }
+inline Pack Mul(Pack a, Pack b) { return _mm512_mul_pd(a, b); }
+inline Pack Div(Pack a, Pack b) { return _mm512_div_pd(a, b); }
+inline Pack Sqrt(Pack a) { return _mm512_sqrt_pd(a); }
+inline Pack Abs(Pack a) { return _mm512_abs_pd(a); }
+inline Pack Max(Pack candidate, Pack current) { return _mm512_max_pd(candidate, current); }
+inline Mask Greater(Pack a, Pack b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+inline Mask Equal(Pack a, Pack b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+inline Mask NotEqual(Pack a, Pack b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); }
+inline Pack Select(Mask m, Pack ifTrue, Pack ifFalse) { return _mm512_mask_blend_pd(m, ifFalse, ifTrue); }
+inline bool Any(Mask m) { return m != 0; }
+inline bool All(Mask m) { return m == 0xFF; }
+
+// 2^n for integer-valued n in [-1022, 1023]: n + 1023 into the exponent field
+inline Pack Pow2(Pack n) {
+    const Pack biased = _mm512_add_pd(n, _mm512_set1_pd(1023.0 + 4503599627370496.0));
+    return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(biased), 52));
+}
+
+} // namespace Avx512
+#elif defined(__AVX2__)
+inline namespace Avx2 {
+
+constexpr int LANES = 4;   ///< One 256-bit register of doubles
+constexpr const char* INSTRUCTION_SET = "AVX2";
+
+using Pack = __m256d;
+using Mask = __m256d;
+
+inline Pack Load(const double* p) { return _mm256_loadu_pd(p); }
+inline void Store(double* p, Pack v) { _mm256_storeu_pd(p, v); }
+inline Pack Broadcast(double x) { return _mm256_set1_pd(x); }
+inline Pack Add(Pack a, Pack b) { return _mm256_add_pd(a, b); }
+inline Pack Sub(Pack a, Pack b) { return _mm256_sub_pd(a, b); }
+inline Pack Mul(Pack a, Pack b) { return _mm256_mul_pd(a, b); }
+inline Pack Div(Pack a, Pack b) { return _mm256_div_pd(a, b); }
+inline Pack Sqrt(Pack a) { return _mm256_sqrt_pd(a); }
+inline Pack Abs(Pack a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+inline Pack Max(Pack candidate, Pack current) { return _mm256_max_pd(candidate, current); }
+inline Mask Greater(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+inline Mask Equal(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+inline Mask NotEqual(Pack a, Pack b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+inline Pack Select(Mask m, Pack ifTrue, Pack ifFalse) { return _mm256_blendv_pd(ifFalse, ifTrue, m); }
+inline bool Any(Mask m) { return _mm256_movemask_pd(m) != 0; }
+inline bool All(Mask m) { return _mm256_movemask_pd(m) == 0xF; }
+
+inline Pack Pow2(Pack n) {
+    const Pack biased = _mm256_add_pd(n, _mm256_set1_pd(1023.0 + 4503599627370496.0));
+    return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+}
+
+} // namespace Avx2
+#elif defined(__SSE2__) || defined(_M_X64)
+inline namespace Sse2 {
+
+constexpr int LANES = 4;   ///< Two 128-bit registers of doubles
+constexpr const char* INSTRUCTION_SET = "SSE2";
+
+// Baseline x86-64: each 4-lane pack is two 128-bit registers
+struct Pack { __m128d lo, hi; };
+using Mask = Pack;
+
+inline Pack Load(const double* p) { return Pack{_mm_loadu_pd(p), _mm_loadu_pd(p + 2)}; }
+inline void Store(double* p, Pack v) { _mm_storeu_pd(p, v.lo); _mm_storeu_pd(p + 2, v.hi); }
+inline Pack Broadcast(double x) { return Pack{_mm_set1_pd(x), _mm_set1_pd(x)}; }
+inline Pack Add(Pack a, Pack b) { return Pack{_mm_add_pd(a.lo, b.lo), _mm_add_pd(a.hi, b.hi)}; }
+inline Pack Sub(Pack a, Pack b) { return Pack{_mm_sub_pd(a.lo, b.lo), _mm_sub_pd(a.hi, b.hi)}; }
+inline Pack Mul(Pack a, Pack b) { return Pack{_mm_mul_pd(a.lo, b.lo), _mm_mul_pd(a.hi, b.hi)}; }
+inline Pack Div(Pack a, Pack b) { return Pack{_mm_div_pd(a.lo, b.lo), _mm_div_pd(a.hi, b.hi)}; }
+inline Pack Sqrt(Pack a) { return Pack{_mm_sqrt_pd(a.lo), _mm_sqrt_pd(a.hi)}; }
+inline Pack Abs(Pack a) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    return Pack{_mm_andnot_pd(sign, a.lo), _mm_andnot_pd(sign, a.hi)};
+}
+inline Pack Max(Pack candidate, Pack current) {
+    return Pack{_mm_max_pd(candidate.lo, current.lo), _mm_max_pd(candidate.hi, current.hi)};
+}
+inline Mask Greater(Pack a, Pack b) { return Mask{_mm_cmpgt_pd(a.lo, b.lo), _mm_cmpgt_pd(a.hi, b.hi)}; }
+inline Mask Equal(Pack a, Pack b) { return Mask{_mm_cmpeq_pd(a.lo, b.lo), _mm_cmpeq_pd(a.hi, b.hi)}; }
+inline Mask NotEqual(Pack a, Pack b) { return Mask{_mm_cmpneq_pd(a.lo, b.lo), _mm_cmpneq_pd(a.hi, b.hi)}; }
+inline Pack Select(Mask m, Pack ifTrue, Pack ifFalse) {
+    return Pack{_mm_or_pd(_mm_and_pd(m.lo, ifTrue.lo), _mm_andnot_pd(m.lo, ifFalse.lo)),
+                _mm_or_pd(_mm_and_pd(m.hi, ifTrue.hi), _mm_andnot_pd(m.hi, ifFalse.hi))};
+}
+inline bool Any(Mask m) { return (_mm_movemask_pd(m.lo) | _mm_movemask_pd(m.hi)) != 0; }
+inline bool All(Mask m) { return (_mm_movemask_pd(m.lo) & _mm_movemask_pd(m.hi)) == 0x3; }
+
+inline Pack Pow2(Pack n) {
+    const __m128d bias = _mm_set1_pd(1023.0 + 4503599627370496.0);
+    return Pack{_mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n.lo, bias)), 52)),
+                _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(_mm_add_pd(n.hi, bias)), 52))};
+}
+
+} // namespace Sse2
+#else
+inline namespace Scalar {
+
+constexpr int LANES = 4;
+constexpr const char* INSTRUCTION_SET = "scalar";
+
+struct Pack { double v[LANES]; };
+struct Mask { bool v[LANES]; };
+
+template <typename Op>
+inline Pack Map(Pack a, Pack b, Op op) {
+    Pack r;
+    for (int l = 0; l < LANES; ++l) r.v[l] = op(a.v[l], b.v[l]);
+    return r;
+}
+
+inline Pack Load(const double* p) { Pack r; std::copy(p, p + LANES, r.v); return r; }
+inline void Store(double* p, Pack v) { std::copy(v.v, v.v + LANES, p); }
+inline Pack Broadcast(double x) { Pack r; std::fill(r.v, r.v + LANES, x); return r; }
+inline Pack Add(Pack a, Pack b) { return Map(a, b, [](double x, double y) { return x + y; }); }
+inline Pack Sub(Pack a, Pack b) { return Map(a, b, [](double x, double y) { return x - y; }); }
+inline Pack Mul(Pack a, Pack b) { return Map(a, b, [](double x, double y) { return x * y; }); }
+inline Pack Div(Pack a, Pack b) { return Map(a, b, [](double x, double y) { return x / y; }); }
+inline Pack Sqrt(Pack a) { return Map(a, a, [](double x, double) { return std::sqrt(x); }); }
+inline Pack Abs(Pack a) { return Map(a, a, [](double x, double) { return std::abs(x); }); }
+inline Pack Max(Pack candidate, Pack current) {
+    return Map(candidate, current, [](double c, double m) { return c > m ? c : m; });
+}
+inline Mask Greater(Pack a, Pack b) { Mask r; for (int l = 0; l < LANES; ++l) r.v[l] = a.v[l] > b.v[l]; return r; }
+inline Mask Equal(Pack a, Pack b) { Mask r; for (int l = 0; l < LANES; ++l) r.v[l] = a.v[l] == b.v[l]; return r; }
+inline Mask NotEqual(Pack a, Pack b) { Mask r; for (int l = 0; l < LANES; ++l) r.v[l] = a.v[l] != b.v[l]; return r; }
+inline Pack Select(Mask m, Pack ifTrue, Pack ifFalse) {
+    Pack r;
+    for (int l = 0; l < LANES; ++l) r.v[l] = m.v[l] ? ifTrue.v[l] : ifFalse.v[l];
+    return r;
+}
+inline bool Any(Mask m) { return std::any_of(m.v, m.v + LANES, [](bool b) { return b; }); }
+inline bool All(Mask m) { return std::all_of(m.v, m.v + LANES, [](bool b) { return b; }); }
+
+inline Pack Pow2(Pack n) {
+    Pack r;
+    for (int l = 0; l < LANES; ++l) {
+        const double biased = n.v[l] + (1023.0 + 4503599627370496.0);
+        std::uint64_t bits;
+        std::memcpy(&bits, &biased, sizeof bits);
+        bits <<= 52;
+        std::memcpy(&r.v[l], &bits, sizeof bits);
+    }
+    return r;
+}
+
+} // namespace Scalar
+#endif
+
+} // namespace Simd
+} // namespace Pavement
@@ -0,0 +1,253 @@
+#pragma once
+
+/**
+ * @file SimdSpecialFunctions.h
+ * @brief J0, J1 and exp kernels on Simd::Pack
+ *
+ * Compiled once per instruction set by SpecialFunctionsBaseline.cpp,
+ * SpecialFunctionsAVX2.cpp and SpecialFunctionsAVX512.cpp, each with its
+ * own target flags; SpecialFunctions.cpp picks one at run time. Everything
+ * here has internal linkage, so the builds never mix.
+ *
+ * Internal header: include it from those source files only.
+ */
+
+#include "SimdPack.h"
+#include "SpecialFunctionKernels.h"
+#include <limits>
+
+namespace Pavement {
+
+using namespace Simd;
+
+namespace {
+
+// J0(x) = sum c_k T_k(x^2/32 - 1) for |x| <= 8
+constexpr double J0_SMALL[17] = {
+    1.57727971474890121817e-01, -8.72344235285222105447e-03, 2.65178613203336799309e-01,
+    -3.70094993872649768996e-01, 1.58067102332097253470e-01, -3.48937694114088842179e-02,
+    4.81918006946760457687e-03, -4.60626166206275038367e-04, 3.24603288210050831895e-05,
+    -1.76194690776215074467e-06, 7.60816359241878205776e-08, -2.67925353055767279769e-09,
+    7.84869631447946477493e-11, -1.94383468673701644668e-12, 4.12532059563437413233e-14,
+    -7.58850812544754590285e-16, 1.22185158739614113433e-17
+};
+// J1(x) = x * sum c_k T_k(x^2/32 - 1) for |x| <= 8
+constexpr double J1_SMALL[16] = {
+    8.10448463256581153047e-02, -1.48975145067652109399e-01, 1.60999262357209710350e-01,
+    -8.26804917668179095713e-02, 2.22136396549660365685e-02, -3.64694060076927589753e-03,
+    4.05033772835482197561e-04, -3.25555486685725868493e-05, 1.98587740499151654358e-06,
+    -9.52198475675043612200e-08, 3.68713375909714814405e-09, -1.17802662269588496489e-10,
+    3.16015458034800320174e-12, -7.22175523965177338606e-14, 1.42321440035139424792e-15,
+    -2.44419729161904643913e-17
+};
+// Hankel form for x >= 8, y = 64/x^2: J_n(x) = sqrt(2/(pi x)) (P cos(chi) - (8/x) q sin(chi)),
+// chi = x - (2n+1) pi/4, with P = sum c_k T_k(2y - 1) and q likewise
+constexpr double P0[12] = {
+    9.99460349347518706153e-01, -5.36522046813211724373e-04, 3.07518478751947449306e-06,
+    -5.17059453760609752236e-08, 1.63064646351513823520e-09, -7.86409137723706975192e-11,
+    5.16826238734919281430e-12, -4.30457886992539141371e-13, 4.32659574315494036213e-14,
+    -5.06903409593523592551e-15, 6.74807221573387336932e-16, -1.00115137234677864132e-16
+};
+constexpr double Q0[11] = {
+    -1.55558546053370088530e-02, 6.83851994261164931399e-05, -7.41449841106064689049e-07,
+    1.79724572479689917469e-08, -7.27191593686632009072e-10, 4.22012190466873852421e-11,
+    -3.20674742099663482931e-12, 3.00614512535170623295e-13, -3.33632818532242671211e-14,
+    4.25522504024546080429e-15, -6.09993013164004959007e-16
+};
+constexpr double P1[12] = {
+    1.00090304086001369299e+00, 8.98989833085940830311e-04, -3.98728430048890841091e-06,
+    6.17763396064429883529e-08, -1.87189074910630669038e-09, 8.81689865958233913846e-11,
+    -5.70486364039564475711e-12, 4.69919551523054202794e-13, -4.68422378399048950026e-14,
+    5.45267489604471711047e-15, -7.22118084227401794964e-16, 1.06676891143354123550e-16
+};
+constexpr double Q1[11] = {
+    4.67777870695353231723e-02, -9.62772354915707965096e-05, 9.13861525795545445791e-07,
+    -2.09597813840834239523e-08, 8.22919332765055408791e-10, -4.68636368817694525057e-11,
+    3.51521879496860824449e-12, -3.26431567432789999654e-13, 3.59677658291652939159e-14,
+    -4.56125239507729740024e-15, 6.50828295778338366721e-16
+};
+constexpr double SMALL_ARGUMENT_LIMIT = 8.0;
+constexpr double TWO_OVER_PI = 0.63661977236758134308;
+constexpr double PI_OVER_4 = 0.78539816339744830962;
+constexpr double THREE_PI_OVER_4 = 2.35619449019234492885;
+constexpr double PI_OVER_2_HIGH = 1.57079632673412561417;    // 33 bits: n * PI_OVER_2_HIGH is exact
+constexpr double PI_OVER_2_LOW = 6.07710050650619224932e-11;
+constexpr double LOG2_E = 1.44269504088896340736;
+constexpr double LN2_HIGH = 6.93147180369123816490e-01;      // 32 bits: n * LN2_HIGH is exact
+constexpr double LN2_LOW = 1.90821492927058770002e-10;
+constexpr double EXP_OVERFLOW = 7.09782712893383973096e+02;  // log(DBL_MAX)
+constexpr double EXP_UNDERFLOW = -7.45133219101941108420e+02; // log of the smallest subnormal
+constexpr double INFINITE = std::numeric_limits<double>::infinity();  // Folded, never called out of line
+
+// Nearest integer (ties to even) for |x| < 2^51, by the 1.5 * 2^52 shift
+inline Pack Round(Pack x) {
+    const Pack shift = Broadcast(6755399441055744.0);
+    return Sub(Add(x, shift), shift);
+}
+
+template <int N>
+inline Pack Clenshaw(const double (&c)[N], Pack s) {
+    const Pack twoS = Add(s, s);
+    Pack b1 = Broadcast(0.0);
+    Pack b2 = Broadcast(0.0);
+    for (int k = N - 1; k >= 1; --k) {
+        const Pack b0 = Add(Sub(Mul(twoS, b1), b2), Broadcast(c[k]));
+        b2 = b1;
+        b1 = b0;
+    }
+    return Add(Sub(Mul(s, b1), b2), Broadcast(c[0]));
+}
+
+// sin(r) and cos(r) for |r| <= pi/4 (Taylor, truncation below 1e-17)
+inline void SinCosReduced(Pack r, Pack& sine, Pack& cosine) {
+    const Pack r2 = Mul(r, r);
+    Pack s = Broadcast(1.0 / 1307674368000.0);  // 1/15!
+    s = Add(Mul(s, r2), Broadcast(-1.0 / 6227020800.0));
+    s = Add(Mul(s, r2), Broadcast(1.0 / 39916800.0));
+    s = Add(Mul(s, r2), Broadcast(-1.0 / 362880.0));
+    s = Add(Mul(s, r2), Broadcast(1.0 / 5040.0));
+    s = Add(Mul(s, r2), Broadcast(-1.0 / 120.0));
+    s = Add(Mul(s, r2), Broadcast(1.0 / 6.0));
+    sine = Sub(r, Mul(Mul(s, r2), r));
+
+    Pack c = Broadcast(1.0 / 6402373705728000.0);  // 1/18!
+    c = Add(Mul(c, r2), Broadcast(-1.0 / 20922789888000.0));
+    c = Add(Mul(c, r2), Broadcast(1.0 / 87178291200.0));
+    c = Add(Mul(c, r2), Broadcast(-1.0 / 479001600.0));
+    c = Add(Mul(c, r2), Broadcast(1.0 / 3628800.0));
+    c = Add(Mul(c, r2), Broadcast(-1.0 / 40320.0));
+    c = Add(Mul(c, r2), Broadcast(1.0 / 720.0));
+    c = Add(Mul(c, r2), Broadcast(-1.0 / 24.0));
+    c = Add(Mul(c, r2), Broadcast(0.5));
+    cosine = Sub(Broadcast(1.0), Mul(c, r2));
+}
+
+// sqrt(2/(pi x)) (P cos(x - phase) - (8/x) q sin(x - phase)) for x >= 8
+template <int NP, int NQ>
+inline Pack HankelForm(Pack x, const double (&p)[NP], const double (&q)[NQ], double phase) {
+    const Pack inverse = Div(Broadcast(8.0), x);
+    const Pack s = Sub(Mul(Broadcast(2.0), Mul(inverse, inverse)), Broadcast(1.0));
+    const Pack pValue = Clenshaw(p, s);
+    const Pack qValue = Mul(Clenshaw(q, s), inverse);
+
+    // chi = x - phase = n pi/2 + r; the phase is removed after the reduction
+    const Pack n = Round(Mul(Sub(x, Broadcast(phase)), Broadcast(TWO_OVER_PI)));
+    const Pack r = Sub(Sub(Sub(x, Mul(n, Broadcast(PI_OVER_2_HIGH))),
+                           Mul(n, Broadcast(PI_OVER_2_LOW))), Broadcast(phase));
+    Pack sine, cosine;
+    SinCosReduced(r, sine, cosine);
+
+    // Quadrant n mod 4 (n / 4 - 3/8 rounds to floor(n / 4))
+    const Pack quadrant = Sub(n, Mul(Broadcast(4.0), Round(Sub(Mul(n, Broadcast(0.25)), Broadcast(0.375)))));
+    const Pack zero = Broadcast(0.0);
+    const auto q1 = Equal(quadrant, Broadcast(1.0));
+    const auto q2 = Equal(quadrant, Broadcast(2.0));
+    const auto q3 = Equal(quadrant, Broadcast(3.0));
+    const Pack sinChi = Select(q1, cosine, Select(q2, Sub(zero, sine), Select(q3, Sub(zero, cosine), sine)));
+    const Pack cosChi = Select(q1, Sub(zero, sine), Select(q2, Sub(zero, cosine), Select(q3, sine, cosine)));
+
+    const Pack amplitude = Sqrt(Div(Broadcast(TWO_OVER_PI), x));
+    return Mul(amplitude, Sub(Mul(pValue, cosChi), Mul(qValue, sinChi)));
+}
+
+inline Pack J0Kernel(Pack x) {
+    const Pack ax = Abs(x);
+    const auto small = Greater(Broadcast(SMALL_ARGUMENT_LIMIT), ax);
+    Pack smallValue = Broadcast(0.0);
+    Pack largeValue = Broadcast(0.0);
+    if (Any(small)) {
+        smallValue = Clenshaw(J0_SMALL, Sub(Mul(Mul(ax, ax), Broadcast(1.0 / 32.0)), Broadcast(1.0)));
+    }
+    if (!All(small)) {
+        largeValue = HankelForm(Max(ax, Broadcast(SMALL_ARGUMENT_LIMIT)), P0, Q0, PI_OVER_4);
+    }
+    return Select(small, smallValue, largeValue);
+}
+
+inline Pack J1Kernel(Pack x) {
+    const Pack ax = Abs(x);
+    const auto small = Greater(Broadcast(SMALL_ARGUMENT_LIMIT), ax);
+    Pack smallValue = Broadcast(0.0);
+    Pack largeValue = Broadcast(0.0);
+    if (Any(small)) {
+        smallValue = Mul(x, Clenshaw(J1_SMALL, Sub(Mul(Mul(ax, ax), Broadcast(1.0 / 32.0)), Broadcast(1.0))));
+    }
+    if (!All(small)) {
+        largeValue = HankelForm(Max(ax, Broadcast(SMALL_ARGUMENT_LIMIT)), P1, Q1, THREE_PI_OVER_4);
+        largeValue = Select(Greater(Broadcast(0.0), x), Sub(Broadcast(0.0), largeValue), largeValue);  // J1 is odd
+    }
+    return Select(small, smallValue, largeValue);
+}
+
+inline Pack ExpKernel(Pack x) {
+    // Clamp so the reduction stays finite; out-of-range lanes are replaced below
+    const Pack clamped = Max(Broadcast(EXP_UNDERFLOW - 1.0),
+                             Select(Greater(x, Broadcast(EXP_OVERFLOW + 1.0)), Broadcast(EXP_OVERFLOW + 1.0), x));
+    const Pack n = Round(Mul(clamped, Broadcast(LOG2_E)));
+    const Pack r = Sub(Sub(clamped, Mul(n, Broadcast(LN2_HIGH))), Mul(n, Broadcast(LN2_LOW)));
+
+    Pack p = Broadcast(1.0 / 6227020800.0);  // 1/13!
+    p = Add(Mul(p, r), Broadcast(1.0 / 479001600.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 39916800.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 3628800.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 362880.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 40320.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 5040.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 720.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 120.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 24.0));
+    p = Add(Mul(p, r), Broadcast(1.0 / 6.0));
+    p = Add(Mul(p, r), Broadcast(0.5));
+    p = Add(Mul(p, r), Broadcast(1.0));
+    p = Add(Mul(p, r), Broadcast(1.0));
+
+    // 2^n in two factors so that results near overflow and in the subnormal range stay exact
+    const Pack half = Round(Mul(n, Broadcast(0.5)));
+    Pack result = Mul(Mul(p, Pow2(half)), Pow2(Sub(n, half)));
+
+    result = Select(Greater(x, Broadcast(EXP_OVERFLOW)), Broadcast(INFINITE), result);
+    result = Select(Greater(Broadcast(EXP_UNDERFLOW), x), Broadcast(0.0), result);
+    return Select(NotEqual(x, x), x, result);  // NaN in, NaN out
+}
+
+// Plain loops rather than std::fill/std::copy: any out-of-line library
+// function emitted by an AVX translation unit could be the copy the linker
+// keeps for everyone
+template <typename Kernel>
+void Apply(Kernel kernel, const double* x, double* result, int count) {
+    int i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        Store(result + i, kernel(Load(x + i)));
+    }
+    if (i < count) {
+        double tail[LANES];
+        for (int l = 0; l < LANES; ++l) {
+            tail[l] = x[i + (i + l < count ? l : 0)];
+        }
+        Store(tail, kernel(Load(tail)));
+        for (int l = 0; i + l < count; ++l) {
+            result[i + l] = tail[l];
+        }
+    }
+}
+
+void BesselJ0Array(const double* x, double* result, int count) {
+    Apply(J0Kernel, x, result, count);
+}
+
+void BesselJ1Array(const double* x, double* result, int count) {
+    Apply(J1Kernel, x, result, count);
+}
+
+void ExpArray(const double* x, double* result, int count) {
+    Apply(ExpKernel, x, result, count);
+}
+
+// The kernels of this translation unit's instruction set
+SpecialFunctionKernels::Table KernelTable() {
+    return SpecialFunctionKernels::Table{&BesselJ0Array, &BesselJ1Array, &ExpArray, INSTRUCTION_SET};
+}
+
+} // namespace
+
+} // namespace Pavement
@@ -0,0 +1,47 @@
+#pragma once
+
+/**
+ * @file SpecialFunctionKernels.h
+ * @brief Per-instruction-set builds of the SpecialFunctions kernels
+ *
+ * The same kernels (SimdSpecialFunctions.h) are compiled for baseline
+ * x86-64 (SSE2), AVX2 and AVX-512 in separate translation units.
+ * SpecialFunctions chooses the widest one the CPU supports on first use.
+ *
+ * Internal header: include it from source files and tests only.
+ */
+
+namespace Pavement {
+namespace SpecialFunctionKernels {
+
+/** result[i] = f(x[i]) for i < count (result may alias x) */
+using ArrayFunction = void (*)(const double* x, double* result, int count);
+
+/** Kernels of one instruction set */
+struct Table {
+    ArrayFunction besselJ0;
+    ArrayFunction besselJ1;
+    ArrayFunction exp;
+    const char* instructionSet;  ///< Simd::INSTRUCTION_SET the kernels were compiled for
+};
+
+/** Kernels built for the library's baseline target (SSE2 on x86-64) */
+Table Baseline();
+
+/** Kernels built with AVX2 (only run them if CpuSupportsAvx2()) */
+Table Avx2();
+
+/** Kernels built with AVX-512F (only run them if CpuSupportsAvx512()) */
+Table Avx512();
+
+/** True if the CPU and operating system support AVX2 */
+bool CpuSupportsAvx2();
+
+/** True if the CPU and operating system support AVX-512F */
+bool CpuSupportsAvx512();
+
+/** Table chosen for this CPU, selected once */
+const Table& Selected();
+
+} // namespace SpecialFunctionKernels
+} // namespace Pavement
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+
+namespace Pavement {
+
+/**
+ * Vectorised Bessel functions J0, J1 and the exponential for the Hankel
+ * integrands.
+ *
+ * The array forms evaluate Simd::LANES arguments per instruction stream.
+ * The kernels are built for SSE2, AVX2 and AVX-512 (SpecialFunctionKernels.h)
+ * and the widest one the CPU supports is chosen on first use, so one binary
+ * runs everywhere. All three are branch-free polynomial kernels:
+ *
+ * - J0, J1 for |x| < 8: Chebyshev expansions in x^2 (J1 as x * g(x^2)).
+ * - J0, J1 for |x| >= 8: Hankel form sqrt(2/(pi x)) (P cos(chi) - Q sin(chi))
+ *   with P and Q as Chebyshev expansions in 64/x^2 and chi reduced by pi/2
+ *   with a two-part constant.
+ * - exp: reduction by ln 2 (two-part constant), degree-13 polynomial on
+ *   |r| <= ln(2)/2 and scaling by 2^n through the exponent field.
+ *
+ * The coefficients were computed from 120-digit series and asymptotic
+ * evaluations. The absolute error of J0 and J1 is a few units of 1e-16,
+ * the relative error of exp a few ulp; arguments must be finite for J0 and
+ * J1. Exp follows std::exp for overflow (+inf), underflow (0) and NaN.
+ */
+class SpecialFunctions {
+public:
+    /**
+     * result[i] = J0(x[i]) for i < count (result may alias x).
+     */
+    static void BesselJ0(const double* x, double* result, int count);
+
+    /**
+     * result[i] = J1(x[i]) for i < count (result may alias x).
+     */
+    static void BesselJ1(const double* x, double* result, int count);
+
+    /**
+     * result[i] = exp(x[i]) for i < count (result may alias x).
+     */
+    static void Exp(const double* x, double* result, int count);
+
+    /** J0(x) by the vector kernel */
+    static double BesselJ0(double x);
+
+    /** J1(x) by the vector kernel */
+    static double BesselJ1(double x);
+
+    /**
+     * First positive zeros of J0 or J1.
+     *
+     * Zeros are generated on demand (McMahon's asymptotic expansion polished
+     * by Newton steps on the kernels above) and cached for the whole
+     * process; a request only computes the zeros not cached yet.
+     * Thread-safe.
+     *
+     * @param order Bessel function order (0 or 1)
+     * @param count Number of zeros to return
+     * @return The first count zeros, ascending
+     * @throws std::invalid_argument for another order or a negative count
+     */
+    static std::vector<double> BesselZeros(int order, int count);
+
+    /** Instruction set of the kernels chosen for this CPU ("AVX-512", "AVX2", "SSE2" or "scalar") */
+    static const char* InstructionSet();
+};
+
+} // namespace Pavement
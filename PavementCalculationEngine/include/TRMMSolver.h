@@ -1,53 +1,110 @@
 ﻿#pragma once
 
 #include <Eigen/Dense>
+#include <memory>
 #include <vector>
-#include "PavementAPI.h"
-#include "Logger.h"
+#include "PavementData.h"
+#include "HankelIntegrator.h"
+#include "MatrixOperations.h"
+#include "Constants.h"
+
+namespace Pavement {
+class ThreadPool;
+}
 
 namespace PavementCalculation {
 
+/**
+ * Transmission and Reflection Matrix Method (TRMM) for layered elastic
+ * half-spaces.
+ *
+ * Inside every layer the Hankel-transformed solution is split into a part
+ * decaying downward from the layer top (amplitudes B, D) and a part decaying
+ * upward from the layer bottom (amplitudes A, C), each written in the local
+ * depth measured from its own boundary. The only exponentials are then
+ * exp(-m*h) <= 1 and every polynomial factor is of the form m*s*exp(-m*s),
+ * bounded by 1/e, so no entry overflows whatever m*h.
+ *
+ * For each Hankel parameter m one sweep from the half-space upward solves,
+ * interface by interface, a 4x4 continuity system for the reflection matrix
+ * R (up amplitudes of a layer from its down amplitudes) and the transmission
+ * matrix T (down amplitudes of the layer below). The surface conditions then
+ * fix the top layer and T carries the solution down: O(n) per m.
+ *
+ * The responses are integrated over m with the engine's adaptive
+ * Gauss-Kronrod HankelIntegrator, by default with the tail past the zeros of
+ * J1(m*a) extrapolated to infinity.
+ */
 class TRMMSolver {
 public:
-    struct LayerMatrices {
-        Eigen::Matrix3d T;
-        Eigen::Matrix3d R;
-        double thickness;
-        double m_parameter;
-        double young_modulus;
-        double poisson_ratio;
-        
-        bool IsStable() const;
-        double GetConditionNumber() const;
-    };
-    
+    /**
+     * Amplitudes of every layer for one m, one column per layer:
+     * (A, C) of the upward-decaying part, then (B, D) of the downward one.
+     * Storage is fixed-capacity, so solving allocates nothing.
+     */
+    using Amplitudes = Eigen::Matrix<double, 4, Eigen::Dynamic, Eigen::ColMajor,
+                                     4, Pavement::Constants::MAX_LAYER_COUNT>;
+
     struct TRMMConfig {
-        double stability_threshold = 700.0;
-        bool verbose_logging = false;
-        double tolerance = 1e-8;
+        Pavement::HankelIntegrationOptions integration;  ///< Tolerances of the m-integral (tail extrapolated by default)
+        int thread_count = 1;                            ///< Threads for the m-points (1 = serial, <= 0 = all cores)
+        bool verbose_logging = false;                    ///< Log the integration report of every calculation
+
+        TRMMConfig() { integration.extrapolateTail = true; }
     };
-    
+
     TRMMSolver();
     explicit TRMMSolver(const TRMMConfig& config);
     ~TRMMSolver() = default;
-    
-    bool CalculateStable(const PavementInputC& input, PavementOutputC& output);
-    
+
+    /**
+     * Responses on the axis of the loaded wheel at the given depths.
+     *
+     * A twin load adds the second wheel at input.wheelSpacing along the axle
+     * (x); horizontal results are then the components along the axle. The
+     * last layer is a half-space (its thickness is ignored); interfaces with
+     * interfaceTypes 2 are frictionless, the others bonded. A depth on an
+     * interface is evaluated in the upper layer, or in the lower one when the
+     * previous depth is the same interface (bottom of a layer, then top of
+     * the next).
+     *
+     * @param input Structure and load (validated)
+     * @param depths Depths from the surface (m, >= 0)
+     * @return One entry per depth: sigmaZ and sigmaT in MPa, positive in
+     *         compression; epsilonZ and epsilonT in microstrain, positive in
+     *         extension; deflection in mm, positive downward. The
+     *         integration report covers all depths.
+     * @throws std::invalid_argument if the input is invalid, depths is empty
+     *         or a depth is negative
+     */
+    Pavement::CalculationOutput Calculate(const Pavement::CalculationInput& input,
+                                          const std::vector<double>& depths);
+
+    /**
+     * Reflection/transmission sweep for one Hankel parameter under a unit
+     * transformed surface pressure (sigma_z = 1, tau_rz = 0 at z = 0).
+     *
+     * @param m Hankel parameter (1/m, > 0)
+     * @param input Structure (validated)
+     * @param amplitudes Amplitudes of every layer (resized to input.layerCount)
+     * @return SolveStatus::Ok, or Singular if an interface or the surface
+     *         system could not be solved
+     */
+    static Pavement::SolveStatus SolveAmplitudes(double m, const Pavement::CalculationInput& input,
+                                                 Amplitudes& amplitudes) noexcept;
+
     const TRMMConfig& GetConfig() const { return config_; }
-    void SetConfig(const TRMMConfig& config) { config_ = config; }
+    void SetConfig(const TRMMConfig& config);
+
+    /**
+     * Run the m-points on an existing pool instead of a pool of our own.
+     * config.thread_count follows the pool; null runs serially.
+     */
+    void SetThreadPool(std::shared_ptr<Pavement::ThreadPool> pool);
 
 private:
-    LayerMatrices BuildLayerMatrices(double E, double nu, double h, double m);
-    double CalculateMParameter(double E, double nu, double radius);
-    bool CheckNumericalStability(double m, double h);
-    bool ValidateLayerMatrices(const LayerMatrices& matrices);
-    void ComputeResponses(const PavementInputC& input, const std::vector<LayerMatrices>& layers, PavementOutputC& output);
-    
     TRMMConfig config_;
-    Pavement::Logger* logger_;
-    mutable size_t total_layers_processed_;
-    mutable size_t stability_warnings_;
-    mutable double max_condition_number_;
+    std::shared_ptr<Pavement::ThreadPool> pool_;  ///< Null when running serially
 };
 
 }
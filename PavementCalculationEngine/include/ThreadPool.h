@@ -0,0 +1,65 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Pavement {
+
+/**
+ * Fixed-size worker pool for data-parallel loops in the calculation engine.
+ *
+ * ParallelFor lets the calling thread take part in the loop, so a loop
+ * issued from inside a worker (nested parallelism) always makes progress
+ * even when every worker is busy.
+ */
+class ThreadPool {
+public:
+    /**
+     * Start the worker threads.
+     *
+     * @param threadCount Total threads including the caller; <= 0 selects
+     *                    std::thread::hardware_concurrency()
+     */
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Number of threads that execute ParallelFor iterations (workers + caller).
+     */
+    int GetThreadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * Run task(i) for every i in [0, count) and wait for completion.
+     * Iterations are claimed dynamically; each index runs exactly once.
+     *
+     * @param count Number of iterations
+     * @param task Loop body (must be safe to call concurrently for distinct i)
+     * @throws Rethrows the first exception raised by any iteration
+     */
+    void ParallelFor(int count, const std::function<void(int)>& task);
+
+    /**
+     * Queue a fire-and-forget job on a worker thread.
+     *
+     * @param job Work item (exceptions must be handled by the job itself)
+     */
+    void Enqueue(std::function<void()> job);
+
+private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    bool stopping_;
+};
+
+} // namespace Pavement
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Eigen/Dense>
+#include "Constants.h"
+
+namespace Pavement {
+
+/**
+ * Wynn's epsilon algorithm, applied componentwise to a sequence of vectors.
+ *
+ * Feed it the partial sums of a slowly converging series, e.g. the integral
+ * of an oscillatory Hankel kernel up to each of its zeros; Estimate() is the
+ * extrapolated limit. Only the last anti-diagonal of the epsilon table is
+ * kept, so each term costs O(maxColumns) per component. A component whose
+ * differences vanish to rounding is cut at that column (the sequence has
+ * converged there) instead of dividing by zero.
+ */
+class WynnEpsilon {
+public:
+    /**
+     * @param maxColumns Columns of the epsilon table built (>= 3); once the
+     *                   table is that deep, further terms extend only the
+     *                   columns it has and no deeper ones are formed
+     * @throws std::invalid_argument if maxColumns < 3
+     */
+    explicit WynnEpsilon(int maxColumns = Constants::WYNN_EPSILON_MAX_COLUMNS);
+
+    /**
+     * Append the next partial sum.
+     *
+     * @param partialSum Next element of the sequence (same size every call)
+     * @throws std::invalid_argument if the size differs from the first term
+     */
+    void Add(const Eigen::VectorXd& partialSum);
+
+    /** Number of partial sums added so far */
+    int Terms() const { return terms_; }
+
+    /** Extrapolated limit after the last Add (empty before the first) */
+    const Eigen::VectorXd& Estimate() const { return estimate_; }
+
+    /**
+     * Max-norm error estimate of Estimate(): the distance to the two
+     * previous estimates. Infinite until three terms have been added.
+     */
+    double ErrorEstimate() const { return error_; }
+
+private:
+    int maxColumns_;
+    int terms_ = 0;
+    Eigen::MatrixXd diagonal_;  ///< Last anti-diagonal, one row per component
+    Eigen::VectorXi depth_;     ///< Valid columns of diagonal_ per component
+    Eigen::VectorXd estimate_;
+    Eigen::VectorXd previous_;
+    Eigen::VectorXd beforePrevious_;
+    Eigen::VectorXd scratch_;   ///< New anti-diagonal of one component
+    double error_;
+};
+
+} // namespace Pavement
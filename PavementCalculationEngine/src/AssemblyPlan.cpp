@@ -0,0 +1,116 @@
+#include "AssemblyPlan.h"
+#include "Logger.h"
+#include <stdexcept>
+#include <string>
+
+namespace Pavement {
+
+namespace {
+
+// Interface type of CalculationInput without shear transfer
+constexpr int FRICTIONLESS_INTERFACE = 2;
+
+double Compliance(const CalculationInput& input, int layer) {
+    return (1.0 + input.poissonRatios[layer]) / input.youngModuli[layer];
+}
+
+} // namespace
+
+AssemblyPlan::AssemblyPlan(const CalculationInput& input)
+    : layerCount_(input.layerCount),
+      size_(4 * input.layerCount - 2),
+      pressure_(input.pressure) {
+    if (layerCount_ < Constants::MIN_LAYER_COUNT || layerCount_ > Constants::MAX_LAYER_COUNT ||
+        input.thicknesses.size() != static_cast<size_t>(layerCount_)) {
+        throw std::invalid_argument("Cannot plan system assembly for " +
+                                    std::to_string(layerCount_) + " layers");
+    }
+
+    // The half-space has no thickness
+    thicknesses_.assign(input.thicknesses.begin(), input.thicknesses.end() - 1);
+
+    // 8 surface entries, at most 32 per interface
+    entries_.reserve(8 + 32 * (layerCount_ - 1));
+
+    AddSurfaceBoundary(input);
+    for (int i = 0; i < layerCount_ - 1; ++i) {
+        AddInterface(i, input);
+    }
+
+    LOG_DEBUG("Assembly plan: " + std::to_string(size_) + "x" + std::to_string(size_) +
+              " system with " + std::to_string(entries_.size()) + " non-zero entries");
+}
+
+void AssemblyPlan::AddPart(int row, int state, int layer, Part part, double slope, int decayLayer,
+                           double scale, const CalculationInput& input) {
+    // Both bases are affine in t: entry = B(0) + m * slope * (B(1) - B(0))
+    const double nu = input.poissonRatios[layer];
+    const bool upward = part == Part::Upward;
+    const Basis atZero = upward ? UpwardBasis(nu, 0.0) : DownwardBasis(nu, 0.0);
+    const Basis atOne = upward ? UpwardBasis(nu, 1.0) : DownwardBasis(nu, 1.0);
+    const int col = upward ? UpwardColumn(layer) : DownwardColumn(layer);
+    for (int amplitude = 0; amplitude < 2; ++amplitude) {
+        const double constant = atZero(state, amplitude);
+        const double linear = slope * (atOne(state, amplitude) - constant);
+        entries_.push_back(Entry{row, col + amplitude, decayLayer, Term{scale * constant, scale * linear}});
+    }
+}
+
+void AssemblyPlan::AddSurfaceBoundary(const CalculationInput& input) {
+    // State at the top of layer 0: its downward part at t = 0, its upward
+    // part at t = -m*h_0 (the surface layer is never the half-space)
+    // Row 0: zero shear stress, tau_rz(0) = 0
+    // Row 1: applied normal stress, -sigma_z(0) = -p (compression positive)
+    const double h = thicknesses_[0];
+    const int rows[2] = {0, 1};
+    const int states[2] = {1, 0};
+    const double scales[2] = {1.0, -1.0};
+    for (int j = 0; j < 2; ++j) {
+        AddPart(rows[j], states[j], 0, Part::Downward, 0.0, -1, scales[j], input);
+        AddPart(rows[j], states[j], 0, Part::Upward, -h, 0, scales[j], input);
+    }
+}
+
+void AssemblyPlan::AddInterface(int layerIndex, const CalculationInput& input) {
+    const int row = 2 + layerIndex * 4;  // Starting row for this interface
+    const int upper = layerIndex;
+    const int lower = layerIndex + 1;
+    const bool lowerIsHalfSpace = lower == layerCount_ - 1;
+
+    // Displacements are in units of each layer's compliance: the lower
+    // layer's are rescaled to the upper one's
+    const double complianceRatio = Compliance(input, lower) / Compliance(input, upper);
+
+    // Adds state `state` of the upper layer at its bottom minus that of
+    // the lower layer at its top, either side optional
+    auto addState = [&](int r, int state, bool withUpper, bool withLower) {
+        if (withUpper) {
+            AddPart(r, state, upper, Part::Downward, thicknesses_[upper], upper, 1.0, input);
+            AddPart(r, state, upper, Part::Upward, 0.0, -1, 1.0, input);
+        }
+        if (withLower) {
+            const double scale = state >= 2 ? -complianceRatio : -1.0;
+            AddPart(r, state, lower, Part::Downward, 0.0, -1, scale, input);
+            if (!lowerIsHalfSpace) {
+                AddPart(r, state, lower, Part::Upward, -thicknesses_[lower], lower, scale, input);
+            }
+        }
+    };
+
+    // Interface type: 0 = bonded, 1 = semi-bonded (treated as bonded), 2 = frictionless
+    if (input.interfaceTypes[layerIndex] != FRICTIONLESS_INTERFACE) {
+        // Continuity of sigma_z, tau_rz, u and w
+        for (int state = 0; state < 4; ++state) {
+            addState(row + state, state, true, true);
+        }
+    } else {
+        // Continuity of sigma_z and w, no shear on either face
+        // (u is discontinuous across the slip plane)
+        addState(row, 0, true, true);
+        addState(row + 1, 3, true, true);
+        addState(row + 2, 1, true, false);
+        addState(row + 3, 1, false, true);
+    }
+}
+
+} // namespace Pavement
@@ -0,0 +1,308 @@
+#include "BandedLU.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Pavement {
+
+// BandedMatrix Implementation
+
+BandedMatrix::BandedMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper),
+      storage_(Eigen::MatrixXd::Zero(2 * lower + upper + 1, size)) {
+    if (size <= 0 || lower < 0 || upper < 0) {
+        throw std::invalid_argument("Invalid banded matrix dimensions");
+    }
+}
+
+double& BandedMatrix::operator()(int i, int j) {
+    if (i < 0 || j < 0 || i >= size_ || j >= size_ || !InBand(i, j)) {
+        throw std::out_of_range("Banded matrix element (" + std::to_string(i) + ", " +
+                                std::to_string(j) + ") lies outside the band");
+    }
+    return Raw(i, j);
+}
+
+double BandedMatrix::operator()(int i, int j) const {
+    if (i < 0 || j < 0 || i >= size_ || j >= size_) {
+        throw std::out_of_range("Banded matrix index out of range");
+    }
+    return InBand(i, j) ? Raw(i, j) : 0.0;
+}
+
+void BandedMatrix::ScaleRow(int i, double s) {
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; ++j) {
+        Raw(i, j) *= s;
+    }
+}
+
+void BandedMatrix::ScaleCol(int j, double s) {
+    const int first = std::max(0, j - upper_);
+    const int last = std::min(size_ - 1, j + lower_);
+    for (int i = first; i <= last; ++i) {
+        Raw(i, j) *= s;
+    }
+}
+
+double BandedMatrix::RowMaxAbs(int i) const {
+    double result = 0.0;
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; ++j) {
+        result = std::max(result, std::abs(Raw(i, j)));
+    }
+    return result;
+}
+
+double BandedMatrix::ColMaxAbs(int j) const {
+    double result = 0.0;
+    const int first = std::max(0, j - upper_);
+    const int last = std::min(size_ - 1, j + lower_);
+    for (int i = first; i <= last; ++i) {
+        result = std::max(result, std::abs(Raw(i, j)));
+    }
+    return result;
+}
+
+double BandedMatrix::Norm1() const {
+    double result = 0.0;
+    for (int j = 0; j < size_; ++j) {
+        double columnSum = 0.0;
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            columnSum += std::abs(Raw(i, j));
+        }
+        result = std::max(result, columnSum);
+    }
+    return result;
+}
+
+Eigen::VectorXd BandedMatrix::Multiply(const Eigen::VectorXd& x) const {
+    Eigen::VectorXd y = Eigen::VectorXd::Zero(size_);
+    for (int j = 0; j < size_; ++j) {
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            y(i) += Raw(i, j) * x(j);
+        }
+    }
+    return y;
+}
+
+Eigen::VectorXd BandedMatrix::Residual(const Eigen::VectorXd& x, const Eigen::VectorXd& b) const {
+    Eigen::VectorXd r(size_);
+    for (int i = 0; i < size_; ++i) {
+        CompensatedResidual sum(b(i));
+        const int first = std::max(0, i - lower_);
+        const int last = std::min(size_ - 1, i + upper_);
+        for (int j = first; j <= last; ++j) {
+            sum.Subtract(Raw(i, j), x(j));
+        }
+        r(i) = sum.Value();
+    }
+    return r;
+}
+
+Eigen::MatrixXd BandedMatrix::ToDense() const {
+    Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(size_, size_);
+    for (int j = 0; j < size_; ++j) {
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            dense(i, j) = Raw(i, j);
+        }
+    }
+    return dense;
+}
+
+// BandedLU Implementation
+
+BandedLU::BandedLU(const BandedMatrix& A)
+    : lu_(A), norm1_(A.Norm1()), pivots_(A.size_), singularColumn_(-1) {
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    int lastUpdatedCol = 0;  // Rightmost column reached by fill-in so far
+
+    for (int j = 0; j < n; ++j) {
+        const int below = std::min(kl, n - 1 - j);
+
+        // Partial pivoting restricted to the subdiagonal band
+        int pivotOffset = 0;
+        double pivotAbs = std::abs(lu_.Raw(j, j));
+        for (int i = 1; i <= below; ++i) {
+            const double candidate = std::abs(lu_.Raw(j + i, j));
+            if (candidate > pivotAbs) {
+                pivotAbs = candidate;
+                pivotOffset = i;
+            }
+        }
+        pivots_[j] = j + pivotOffset;
+
+        if (pivotAbs == 0.0) {
+            if (singularColumn_ < 0) {
+                singularColumn_ = j;
+            }
+            continue;
+        }
+
+        lastUpdatedCol = std::max(lastUpdatedCol, std::min(j + lu_.upper_ + pivotOffset, n - 1));
+
+        if (pivotOffset != 0) {
+            for (int c = j; c <= lastUpdatedCol; ++c) {
+                std::swap(lu_.Raw(j, c), lu_.Raw(j + pivotOffset, c));
+            }
+        }
+
+        if (below > 0) {
+            const double inversePivot = 1.0 / lu_.Raw(j, j);
+            for (int i = 1; i <= below; ++i) {
+                lu_.Raw(j + i, j) *= inversePivot;
+            }
+            for (int c = j + 1; c <= lastUpdatedCol; ++c) {
+                const double u = lu_.Raw(j, c);
+                if (u == 0.0) {
+                    continue;
+                }
+                for (int i = 1; i <= below; ++i) {
+                    lu_.Raw(j + i, c) -= lu_.Raw(j + i, j) * u;
+                }
+            }
+        }
+    }
+}
+
+double BandedLU::ReciprocalCondition() const {
+    if (!IsInvertible() || norm1_ == 0.0) {
+        return 0.0;
+    }
+    const double inverseNorm = InverseNorm1Estimate();
+    if (!(inverseNorm > 0.0) || !std::isfinite(inverseNorm)) {
+        return 0.0;
+    }
+    return (1.0 / inverseNorm) / norm1_;
+}
+
+double BandedLU::InverseNorm1Estimate() const {
+    const int n = lu_.size_;
+    auto signs = [](const Eigen::VectorXd& v) {
+        return v.unaryExpr([](double x) { return x >= 0.0 ? 1.0 : -1.0; }).eval();
+    };
+
+    // Start from the uniform vector: ||A^-1 e/n||_1 is already a lower bound
+    Eigen::VectorXd v = Solve(Eigen::VectorXd::Constant(n, 1.0 / n));
+    double estimate = v.lpNorm<1>();
+    if (n == 1) {
+        return estimate;
+    }
+
+    Eigen::VectorXd sign = signs(v);
+    int index = 0;
+    SolveTranspose(sign).cwiseAbs().maxCoeff(&index);
+
+    // Hager iteration: move to the unit vector that maximises the gradient
+    constexpr int MAX_ITERATIONS = 5;
+    for (int k = 0; k < MAX_ITERATIONS; ++k) {
+        v = Solve(Eigen::VectorXd::Unit(n, index));
+        const double previous = estimate;
+        estimate = v.lpNorm<1>();
+        if (estimate <= previous) {
+            estimate = previous;
+            break;
+        }
+
+        Eigen::VectorXd newSign = signs(v);
+        if (newSign == sign) {
+            break;
+        }
+        sign = newSign;
+
+        const int previousIndex = index;
+        SolveTranspose(sign).cwiseAbs().maxCoeff(&index);
+        if (index == previousIndex) {
+            break;
+        }
+    }
+
+    // Higham's safeguard against the rare matrices that fool the iteration
+    Eigen::VectorXd alternating(n);
+    for (int i = 0; i < n; ++i) {
+        alternating(i) = ((i % 2 == 0) ? 1.0 : -1.0) * (1.0 + static_cast<double>(i) / (n - 1));
+    }
+    const double alternatingEstimate = 2.0 * Solve(alternating).lpNorm<1>() / (3.0 * n);
+
+    return std::max(estimate, alternatingEstimate);
+}
+
+Eigen::VectorXd BandedLU::Solve(const Eigen::VectorXd& b) const {
+    if (!IsInvertible()) {
+        throw std::runtime_error("Banded LU: matrix is singular at column " +
+                                 std::to_string(singularColumn_));
+    }
+
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    const int bandU = lu_.lower_ + lu_.upper_;
+    Eigen::VectorXd x = b;
+
+    // Forward substitution with L, applying the interchanges as they were made
+    for (int j = 0; j < n - 1; ++j) {
+        if (pivots_[j] != j) {
+            std::swap(x(j), x(pivots_[j]));
+        }
+        const int below = std::min(kl, n - 1 - j);
+        for (int i = 1; i <= below; ++i) {
+            x(j + i) -= lu_.Raw(j + i, j) * x(j);
+        }
+    }
+
+    // Back substitution with U (upper bandwidth lower + upper)
+    for (int j = n - 1; j >= 0; --j) {
+        x(j) /= lu_.Raw(j, j);
+        for (int i = std::max(0, j - bandU); i < j; ++i) {
+            x(i) -= lu_.Raw(i, j) * x(j);
+        }
+    }
+
+    return x;
+}
+
+Eigen::VectorXd BandedLU::SolveTranspose(const Eigen::VectorXd& b) const {
+    if (!IsInvertible()) {
+        throw std::runtime_error("Banded LU: matrix is singular at column " +
+                                 std::to_string(singularColumn_));
+    }
+
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    const int bandU = lu_.lower_ + lu_.upper_;
+    Eigen::VectorXd x = b;
+
+    // U^T y = b
+    for (int j = 0; j < n; ++j) {
+        double sum = x(j);
+        for (int i = std::max(0, j - bandU); i < j; ++i) {
+            sum -= lu_.Raw(i, j) * x(i);
+        }
+        x(j) = sum / lu_.Raw(j, j);
+    }
+
+    // L^T x = y, undoing the interchanges in reverse order
+    for (int j = n - 2; j >= 0; --j) {
+        const int below = std::min(kl, n - 1 - j);
+        for (int i = 1; i <= below; ++i) {
+            x(j) -= lu_.Raw(j + i, j) * x(j + i);
+        }
+        if (pivots_[j] != j) {
+            std::swap(x(j), x(pivots_[j]));
+        }
+    }
+
+    return x;
+}
+
+} // namespace Pavement
@@ -0,0 +1,426 @@
+#include "BatchedLU.h"
+#include "SimdPack.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace Pavement {
+
+using namespace Simd;
+
+namespace {
+
+static_assert(BatchedBandedMatrix::LANES == LANES, "Batched matrices hold one Simd::Pack per element");
+
+// Column l of a lane-vector block as a plain vector
+Eigen::VectorXd LaneColumn(const BatchedBandedMatrix::LaneVectors& x, int lane) {
+    return x.col(lane);
+}
+
+int ArgMaxAbs(const Eigen::VectorXd& v) {
+    int index = 0;
+    v.cwiseAbs().maxCoeff(&index);
+    return index;
+}
+
+Eigen::VectorXd Signs(const Eigen::VectorXd& v) {
+    return v.unaryExpr([](double x) { return x >= 0.0 ? 1.0 : -1.0; });
+}
+
+} // namespace
+
+// BatchedBandedMatrix Implementation
+
+BatchedBandedMatrix::BatchedBandedMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper), rowsStored_(2 * lower + upper + 1) {
+    if (size <= 0 || lower < 0 || upper < 0) {
+        throw std::invalid_argument("Invalid banded matrix dimensions");
+    }
+    storage_.assign(static_cast<size_t>(rowsStored_) * size_ * LANES, 0.0);
+}
+
+double& BatchedBandedMatrix::operator()(int i, int j, int lane) {
+    if (i < 0 || j < 0 || i >= size_ || j >= size_ || !InBand(i, j)) {
+        throw std::out_of_range("Banded matrix element (" + std::to_string(i) + ", " +
+                                std::to_string(j) + ") lies outside the band");
+    }
+    if (lane < 0 || lane >= LANES) {
+        throw std::out_of_range("Batched matrix lane " + std::to_string(lane) + " out of range");
+    }
+    return Raw(i, j)[lane];
+}
+
+double BatchedBandedMatrix::operator()(int i, int j, int lane) const {
+    if (i < 0 || j < 0 || i >= size_ || j >= size_ || lane < 0 || lane >= LANES) {
+        throw std::out_of_range("Batched matrix index out of range");
+    }
+    return InBand(i, j) ? Raw(i, j)[lane] : 0.0;
+}
+
+void BatchedBandedMatrix::ScaleRows(int i, const double* scales) {
+    const Pack s = Load(scales);
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; ++j) {
+        Store(Raw(i, j), Mul(Load(Raw(i, j)), s));
+    }
+}
+
+void BatchedBandedMatrix::ScaleCols(int j, const double* scales) {
+    const Pack s = Load(scales);
+    const int first = std::max(0, j - upper_);
+    const int last = std::min(size_ - 1, j + lower_);
+    for (int i = first; i <= last; ++i) {
+        Store(Raw(i, j), Mul(Load(Raw(i, j)), s));
+    }
+}
+
+void BatchedBandedMatrix::RowMaxAbs(int i, double* result) const {
+    Pack maximum = Broadcast(0.0);
+    const int first = std::max(0, i - lower_);
+    const int last = std::min(size_ - 1, i + upper_);
+    for (int j = first; j <= last; ++j) {
+        maximum = Max(Abs(Load(Raw(i, j))), maximum);
+    }
+    Store(result, maximum);
+}
+
+void BatchedBandedMatrix::ColMaxAbs(int j, double* result) const {
+    Pack maximum = Broadcast(0.0);
+    const int first = std::max(0, j - upper_);
+    const int last = std::min(size_ - 1, j + lower_);
+    for (int i = first; i <= last; ++i) {
+        maximum = Max(Abs(Load(Raw(i, j))), maximum);
+    }
+    Store(result, maximum);
+}
+
+void BatchedBandedMatrix::Norm1(double* result) const {
+    Pack maximum = Broadcast(0.0);
+    for (int j = 0; j < size_; ++j) {
+        Pack columnSum = Broadcast(0.0);
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            columnSum = Add(columnSum, Abs(Load(Raw(i, j))));
+        }
+        maximum = Max(columnSum, maximum);
+    }
+    Store(result, maximum);
+}
+
+BatchedBandedMatrix::LaneVectors BatchedBandedMatrix::Multiply(const LaneVectors& x) const {
+    LaneVectors y = LaneVectors::Zero(size_, LANES);
+    for (int j = 0; j < size_; ++j) {
+        const Pack xj = Load(&x(j, 0));
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            Store(&y(i, 0), Add(Load(&y(i, 0)), Mul(Load(Raw(i, j)), xj)));
+        }
+    }
+    return y;
+}
+
+BatchedBandedMatrix::LaneVectors BatchedBandedMatrix::Residual(const LaneVectors& x,
+                                                              const LaneVectors& b) const {
+    // Lanes run one after another, with the arithmetic of BandedMatrix::Residual
+    LaneVectors r(size_, LANES);
+    for (int i = 0; i < size_; ++i) {
+        const int first = std::max(0, i - lower_);
+        const int last = std::min(size_ - 1, i + upper_);
+        for (int l = 0; l < LANES; ++l) {
+            CompensatedResidual sum(b(i, l));
+            for (int j = first; j <= last; ++j) {
+                sum.Subtract(Raw(i, j)[l], x(j, l));
+            }
+            r(i, l) = sum.Value();
+        }
+    }
+    return r;
+}
+
+BandedMatrix BatchedBandedMatrix::ExtractLane(int lane) const {
+    if (lane < 0 || lane >= LANES) {
+        throw std::out_of_range("Batched matrix lane " + std::to_string(lane) + " out of range");
+    }
+    BandedMatrix result(size_, lower_, upper_);
+    for (int j = 0; j < size_; ++j) {
+        const int first = std::max(0, j - upper_);
+        const int last = std::min(size_ - 1, j + lower_);
+        for (int i = first; i <= last; ++i) {
+            result(i, j) = Raw(i, j)[lane];
+        }
+    }
+    return result;
+}
+
+// BatchedBandedLU Implementation
+
+BatchedBandedLU::BatchedBandedLU(const BatchedBandedMatrix& A)
+    : lu_(A), pivots_(A.size_) {
+    A.Norm1(norm1_.data());
+    singularColumn_.fill(-1);
+
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    const Pack zero = Broadcast(0.0);
+    const Pack one = Broadcast(1.0);
+    int lastUpdatedCol = 0;  // Rightmost column reached by fill-in in any lane
+
+    for (int j = 0; j < n; ++j) {
+        const int below = std::min(kl, n - 1 - j);
+
+        // Lane-wise partial pivoting restricted to the subdiagonal band
+        Pack pivotAbs = Abs(Load(lu_.Raw(j, j)));
+        Pack pivotOffset = zero;
+        for (int i = 1; i <= below; ++i) {
+            const Pack candidate = Abs(Load(lu_.Raw(j + i, j)));
+            const Mask larger = Greater(candidate, pivotAbs);
+            pivotAbs = Select(larger, candidate, pivotAbs);
+            pivotOffset = Select(larger, Broadcast(static_cast<double>(i)), pivotOffset);
+        }
+
+        double offsets[LANES];
+        double pivotMagnitudes[LANES];
+        Store(offsets, pivotOffset);
+        Store(pivotMagnitudes, pivotAbs);
+        int maxOffset = -1;  // Largest interchange distance among lanes with a pivot
+        for (int l = 0; l < LANES; ++l) {
+            pivots_[j][l] = j + static_cast<int>(offsets[l]);
+            if (pivotMagnitudes[l] == 0.0) {
+                if (singularColumn_[l] < 0) {
+                    singularColumn_[l] = j;
+                }
+            } else {
+                maxOffset = std::max(maxOffset, static_cast<int>(offsets[l]));
+            }
+        }
+        if (maxOffset < 0) {
+            continue;  // Zero pivot in every lane
+        }
+
+        lastUpdatedCol = std::max(lastUpdatedCol, std::min(j + lu_.upper_ + maxOffset, n - 1));
+
+        // Row interchanges as lane-wise selects (zero-pivot lanes have offset 0)
+        for (int i = 1; i <= below; ++i) {
+            const Mask swap = Equal(pivotOffset, Broadcast(static_cast<double>(i)));
+            if (!Any(swap)) {
+                continue;
+            }
+            for (int c = j; c <= lastUpdatedCol; ++c) {
+                const Pack top = Load(lu_.Raw(j, c));
+                const Pack row = Load(lu_.Raw(j + i, c));
+                Store(lu_.Raw(j, c), Select(swap, row, top));
+                Store(lu_.Raw(j + i, c), Select(swap, top, row));
+            }
+        }
+
+        if (below > 0) {
+            // Zero multipliers leave the zero-pivot lanes untouched
+            const Pack pivot = Load(lu_.Raw(j, j));
+            const Pack inversePivot = Select(Equal(pivot, zero), zero, Div(one, pivot));
+            for (int i = 1; i <= below; ++i) {
+                Store(lu_.Raw(j + i, j), Mul(Load(lu_.Raw(j + i, j)), inversePivot));
+            }
+            for (int c = j + 1; c <= lastUpdatedCol; ++c) {
+                const Pack u = Load(lu_.Raw(j, c));
+                if (!Any(NotEqual(u, zero))) {
+                    continue;
+                }
+                for (int i = 1; i <= below; ++i) {
+                    Store(lu_.Raw(j + i, c),
+                          Sub(Load(lu_.Raw(j + i, c)), Mul(Load(lu_.Raw(j + i, j)), u)));
+                }
+            }
+        }
+    }
+}
+
+std::array<double, BatchedBandedLU::LANES> BatchedBandedLU::ReciprocalCondition() const {
+    const int n = lu_.size_;
+    std::array<double, LANES> result;
+    result.fill(0.0);
+
+    bool anyLane = false;
+    std::array<bool, LANES> estimated;  // Lanes that get a Hager estimate
+    for (int l = 0; l < LANES; ++l) {
+        estimated[l] = IsInvertible(l) && norm1_[l] != 0.0;
+        anyLane = anyLane || estimated[l];
+    }
+    if (!anyLane) {
+        return result;
+    }
+
+    // Hager/Higham iteration of BandedLU::InverseNorm1Estimate, lane by lane
+    // on the decisions, batched on the solves
+    std::array<double, LANES> estimate;
+    LaneVectors v = Solve(LaneVectors::Constant(n, LANES, 1.0 / n));
+    for (int l = 0; l < LANES; ++l) {
+        estimate[l] = LaneColumn(v, l).lpNorm<1>();
+    }
+
+    if (n > 1) {
+        LaneVectors sign(n, LANES);
+        std::array<int, LANES> index;
+        for (int l = 0; l < LANES; ++l) {
+            sign.col(l) = Signs(LaneColumn(v, l));
+        }
+        const LaneVectors gradient = SolveTranspose(sign);
+        for (int l = 0; l < LANES; ++l) {
+            index[l] = ArgMaxAbs(LaneColumn(gradient, l));
+        }
+
+        std::array<bool, LANES> iterating = estimated;
+        constexpr int MAX_ITERATIONS = 5;
+        for (int k = 0; k < MAX_ITERATIONS; ++k) {
+            if (std::none_of(iterating.begin(), iterating.end(), [](bool b) { return b; })) {
+                break;
+            }
+
+            LaneVectors unit = LaneVectors::Zero(n, LANES);
+            for (int l = 0; l < LANES; ++l) {
+                if (iterating[l]) {
+                    unit(index[l], l) = 1.0;
+                }
+            }
+            v = Solve(unit);
+
+            bool anyMoved = false;
+            std::array<bool, LANES> moved;
+            moved.fill(false);
+            for (int l = 0; l < LANES; ++l) {
+                if (!iterating[l]) {
+                    continue;
+                }
+                const Eigen::VectorXd column = LaneColumn(v, l);
+                const double next = column.lpNorm<1>();
+                if (next <= estimate[l]) {
+                    iterating[l] = false;
+                    continue;
+                }
+                estimate[l] = next;
+
+                const Eigen::VectorXd newSign = Signs(column);
+                if (newSign == LaneColumn(sign, l)) {
+                    iterating[l] = false;
+                    continue;
+                }
+                sign.col(l) = newSign;
+                moved[l] = true;
+                anyMoved = true;
+            }
+
+            if (anyMoved) {
+                const LaneVectors nextGradient = SolveTranspose(sign);
+                for (int l = 0; l < LANES; ++l) {
+                    if (!moved[l]) {
+                        continue;
+                    }
+                    const int previousIndex = index[l];
+                    index[l] = ArgMaxAbs(LaneColumn(nextGradient, l));
+                    if (index[l] == previousIndex) {
+                        iterating[l] = false;
+                    }
+                }
+            }
+        }
+
+        // Higham's safeguard against the rare matrices that fool the iteration
+        LaneVectors alternating(n, LANES);
+        for (int i = 0; i < n; ++i) {
+            alternating.row(i).setConstant(((i % 2 == 0) ? 1.0 : -1.0) *
+                                           (1.0 + static_cast<double>(i) / (n - 1)));
+        }
+        const LaneVectors alternatingSolution = Solve(alternating);
+        for (int l = 0; l < LANES; ++l) {
+            const double alternatingEstimate =
+                2.0 * LaneColumn(alternatingSolution, l).lpNorm<1>() / (3.0 * n);
+            estimate[l] = std::max(estimate[l], alternatingEstimate);
+        }
+    }
+
+    for (int l = 0; l < LANES; ++l) {
+        const double inverseNorm = estimate[l];
+        if (estimated[l] && inverseNorm > 0.0 && std::isfinite(inverseNorm)) {
+            result[l] = (1.0 / inverseNorm) / norm1_[l];
+        }
+    }
+    return result;
+}
+
+BatchedBandedLU::LaneVectors BatchedBandedLU::Solve(const LaneVectors& b) const {
+    if (b.rows() != lu_.size_) {
+        throw std::invalid_argument("Batched LU: right-hand side has wrong size");
+    }
+
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    const int bandU = lu_.lower_ + lu_.upper_;
+    LaneVectors x = b;
+
+    // Forward substitution with L, applying each lane's interchanges as they were made
+    for (int j = 0; j < n - 1; ++j) {
+        for (int l = 0; l < LANES; ++l) {
+            if (pivots_[j][l] != j) {
+                std::swap(x(j, l), x(pivots_[j][l], l));
+            }
+        }
+        const Pack xj = Load(&x(j, 0));
+        const int below = std::min(kl, n - 1 - j);
+        for (int i = 1; i <= below; ++i) {
+            Store(&x(j + i, 0), Sub(Load(&x(j + i, 0)), Mul(Load(lu_.Raw(j + i, j)), xj)));
+        }
+    }
+
+    // Back substitution with U (upper bandwidth lower + upper)
+    for (int j = n - 1; j >= 0; --j) {
+        const Pack xj = Div(Load(&x(j, 0)), Load(lu_.Raw(j, j)));
+        Store(&x(j, 0), xj);
+        for (int i = std::max(0, j - bandU); i < j; ++i) {
+            Store(&x(i, 0), Sub(Load(&x(i, 0)), Mul(Load(lu_.Raw(i, j)), xj)));
+        }
+    }
+
+    return x;
+}
+
+BatchedBandedLU::LaneVectors BatchedBandedLU::SolveTranspose(const LaneVectors& b) const {
+    if (b.rows() != lu_.size_) {
+        throw std::invalid_argument("Batched LU: right-hand side has wrong size");
+    }
+
+    const int n = lu_.size_;
+    const int kl = lu_.lower_;
+    const int bandU = lu_.lower_ + lu_.upper_;
+    LaneVectors x = b;
+
+    // U^T y = b
+    for (int j = 0; j < n; ++j) {
+        Pack sum = Load(&x(j, 0));
+        for (int i = std::max(0, j - bandU); i < j; ++i) {
+            sum = Sub(sum, Mul(Load(lu_.Raw(i, j)), Load(&x(i, 0))));
+        }
+        Store(&x(j, 0), Div(sum, Load(lu_.Raw(j, j))));
+    }
+
+    // L^T x = y, undoing the interchanges in reverse order
+    for (int j = n - 2; j >= 0; --j) {
+        Pack xj = Load(&x(j, 0));
+        const int below = std::min(kl, n - 1 - j);
+        for (int i = 1; i <= below; ++i) {
+            xj = Sub(xj, Mul(Load(lu_.Raw(j + i, j)), Load(&x(j + i, 0))));
+        }
+        Store(&x(j, 0), xj);
+        for (int l = 0; l < LANES; ++l) {
+            if (pivots_[j][l] != j) {
+                std::swap(x(j, l), x(pivots_[j][l], l));
+            }
+        }
+    }
+
+    return x;
+}
+
+} // namespace Pavement
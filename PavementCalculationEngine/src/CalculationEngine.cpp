@@ -0,0 +1,265 @@
+#include "CalculationEngine.h"
+#include "Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <utility>
+
+namespace Pavement {
+
+struct CalculationEngine::Workspace {
+    PavementCalculator calculator;
+    PavementCalculation::TRMMSolver trmm;
+};
+
+struct CalculationEngine::ResultCache {
+    struct Entry {
+        std::vector<double> key;
+        std::uint64_t hash;
+        CalculationOutput output;
+    };
+
+    mutable std::mutex mutex;
+    std::list<Entry> entries;
+    std::size_t capacity = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+struct CalculationEngine::Job {
+    std::atomic<bool> cancelled{false};
+    bool finishing = false;  ///< Completion handler started (guarded by jobMutex_)
+};
+
+namespace {
+
+std::uint64_t HashKey(const std::vector<double>& key) {
+    std::uint64_t hash = 14695981039346656037ull;  // FNV-1a over the bit patterns
+    for (double value : key) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        hash = (hash ^ bits) * 1099511628211ull;
+    }
+    return hash;
+}
+
+} // namespace
+
+CalculationEngine::CalculationEngine() : CalculationEngine(EngineConfig()) {
+}
+
+CalculationEngine::CalculationEngine(const EngineConfig& config)
+    : config_(config), cache_(std::make_unique<ResultCache>()) {
+    if (config_.threadCount != 1) {
+        pool_ = std::make_shared<ThreadPool>(config_.threadCount);
+    }
+    config_.threadCount = GetThreadCount();
+    config_.calculator.threadCount = config_.threadCount;
+    config_.trmm.thread_count = config_.threadCount;
+    cache_->capacity = config_.resultCacheCapacity;
+
+    LOG_INFO("Calculation engine created with " + std::to_string(config_.threadCount) + " thread(s)");
+}
+
+CalculationEngine::~CalculationEngine() {
+    // Jobs use the members below; cancel them and wait before those go
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    for (auto& entry : jobs_) {
+        entry.second->cancelled = true;
+    }
+    jobFinished_.wait(lock, [this] { return jobs_.empty(); });
+}
+
+CalculationOutput CalculationEngine::Calculate(const CalculationInput& input, const std::vector<double>& depths) {
+    CalculationOutput output;
+    Calculate(input, depths, output);
+    return output;
+}
+
+void CalculationEngine::Calculate(const CalculationInput& input, const std::vector<double>& depths,
+                                  CalculationOutput& output) {
+    input.Validate();
+
+    // Keys are built in per-thread storage so that a cache hit allocates nothing
+    thread_local std::vector<double> key;
+    std::uint64_t hash = 0;
+    if (cache_->capacity > 0) {
+        MakeCacheKey(input, depths, key);
+        hash = HashKey(key);
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        for (auto it = cache_->entries.begin(); it != cache_->entries.end(); ++it) {
+            if (it->hash == hash && it->key == key) {
+                ++cache_->hits;
+                cache_->entries.splice(cache_->entries.begin(), cache_->entries, it);
+                output = it->output;
+                return;
+            }
+        }
+        ++cache_->misses;
+    }
+
+    // Solve outside every lock; the workspace goes back even if the solver throws
+    std::unique_ptr<Workspace> workspace = AcquireWorkspace();
+    try {
+        output = config_.solver == Solver::Stable
+            ? workspace->trmm.Calculate(input, depths)
+            : workspace->calculator.Calculate(input);
+    } catch (...) {
+        ReleaseWorkspace(std::move(workspace));
+        throw;
+    }
+    ReleaseWorkspace(std::move(workspace));
+
+    if (cache_->capacity > 0) {
+        std::lock_guard<std::mutex> lock(cache_->mutex);
+        auto same = std::find_if(cache_->entries.begin(), cache_->entries.end(),
+                                 [&](const ResultCache::Entry& e) { return e.hash == hash && e.key == key; });
+        if (same == cache_->entries.end()) {
+            cache_->entries.push_front({key, hash, output});
+            while (cache_->entries.size() > cache_->capacity) {
+                cache_->entries.pop_back();
+            }
+        }
+    }
+}
+
+void CalculationEngine::ParallelFor(int count, const std::function<void(int)>& task) {
+    if (pool_) {
+        pool_->ParallelFor(count, task);
+        return;
+    }
+    for (int i = 0; i < count; ++i) {
+        task(i);
+    }
+}
+
+CalculationEngine::JobId CalculationEngine::Submit(int count, std::function<void(int)> task,
+                                                   std::function<void(bool)> finished) {
+    auto job = std::make_shared<Job>();
+    JobId id;
+    ThreadPool* runner;
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        id = nextJob_++;
+        jobs_.emplace(id, job);
+        if (!pool_ && !jobRunner_) {
+            jobRunner_ = std::make_unique<ThreadPool>(2);  // The caller plus one worker
+        }
+        runner = pool_ ? pool_.get() : jobRunner_.get();
+    }
+
+    runner->Enqueue([this, id, job, count, task = std::move(task), finished = std::move(finished)] {
+        try {
+            ParallelFor(count, [&](int i) {
+                if (!job->cancelled) {
+                    task(i);
+                }
+            });
+        } catch (...) {
+        }
+
+        // From here on Cancel reports the job as finished, so a successful
+        // Cancel is always seen by the handler
+        bool cancelled;
+        {
+            std::lock_guard<std::mutex> lock(jobMutex_);
+            cancelled = job->cancelled;
+            job->finishing = true;
+        }
+        try {
+            if (finished) {
+                finished(cancelled);
+            }
+        } catch (...) {
+        }
+
+        // Notify under the lock: once it is released the destructor may run
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.erase(id);
+        jobFinished_.notify_all();
+    });
+    return id;
+}
+
+bool CalculationEngine::Cancel(JobId job) {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    auto it = jobs_.find(job);
+    if (it == jobs_.end() || it->second->finishing) {
+        return false;
+    }
+    it->second->cancelled = true;
+    return true;
+}
+
+bool CalculationEngine::Wait(JobId job) {
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    if (jobs_.find(job) == jobs_.end()) {
+        return false;
+    }
+    jobFinished_.wait(lock, [&] { return jobs_.find(job) == jobs_.end(); });
+    return true;
+}
+
+CalculationEngine::ResultCacheStats CalculationEngine::GetResultCacheStats() const {
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    ResultCacheStats stats;
+    stats.hits = cache_->hits;
+    stats.misses = cache_->misses;
+    stats.entries = cache_->entries.size();
+    stats.capacity = cache_->capacity;
+    return stats;
+}
+
+void CalculationEngine::ClearResultCache() {
+    std::lock_guard<std::mutex> lock(cache_->mutex);
+    cache_->entries.clear();
+    cache_->hits = 0;
+    cache_->misses = 0;
+}
+
+std::unique_ptr<CalculationEngine::Workspace> CalculationEngine::AcquireWorkspace() {
+    {
+        std::lock_guard<std::mutex> lock(workspaceMutex_);
+        if (!idleWorkspaces_.empty()) {
+            std::unique_ptr<Workspace> workspace = std::move(idleWorkspaces_.back());
+            idleWorkspaces_.pop_back();
+            return workspace;
+        }
+    }
+
+    // More concurrent callers than ever before: build solvers on the shared
+    // pool. Its thread count matches the configs, so SetConfig keeps it.
+    auto workspace = std::make_unique<Workspace>();
+    workspace->calculator.SetThreadPool(pool_);
+    workspace->calculator.SetConfig(config_.calculator);
+    workspace->trmm.SetThreadPool(pool_);
+    workspace->trmm.SetConfig(config_.trmm);
+    return workspace;
+}
+
+void CalculationEngine::ReleaseWorkspace(std::unique_ptr<Workspace> workspace) {
+    std::lock_guard<std::mutex> lock(workspaceMutex_);
+    idleWorkspaces_.push_back(std::move(workspace));
+}
+
+void CalculationEngine::MakeCacheKey(const CalculationInput& input, const std::vector<double>& depths,
+                                     std::vector<double>& key) const {
+    key.clear();
+    key.push_back(static_cast<double>(input.layerCount));
+    key.insert(key.end(), input.poissonRatios.begin(), input.poissonRatios.end());
+    key.insert(key.end(), input.youngModuli.begin(), input.youngModuli.end());
+    key.insert(key.end(), input.thicknesses.begin(), input.thicknesses.end());
+    for (int type : input.interfaceTypes) {
+        key.push_back(static_cast<double>(type));
+    }
+    key.push_back(static_cast<double>(input.wheelType));
+    key.push_back(input.pressure);
+    key.push_back(input.contactRadius);
+    key.push_back(input.wheelSpacing);
+    if (config_.solver == Solver::Stable) {
+        key.insert(key.end(), depths.begin(), depths.end());
+    }
+}
+
+} // namespace Pavement
@@ -0,0 +1,149 @@
+#include "ChebyshevInterpolant.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Pavement {
+
+namespace {
+
+// Compare the interpolant with exact.col(i) at checks[i] and record the
+// verdict; true if accepted
+bool CheckFit(const ChebyshevInterpolant& interpolant, const std::vector<double>& checks,
+              const Eigen::MatrixXd& exact, const ChebyshevOptions& options,
+              ChebyshevFitReport& result) {
+    for (size_t i = 0; i < checks.size(); ++i) {
+        const double error = interpolant.RelativeError(checks[i], exact.col(i));
+        if (std::isnan(error) || error > result.checkError) {  // A NaN sticks and fails the check
+            result.checkError = error;
+        }
+    }
+
+    result.accepted = result.checkError <= options.relativeTolerance;
+    if (!result.accepted) {
+        LOG_DEBUG("Chebyshev fit on [" + std::to_string(interpolant.Lower()) + ", " +
+                  std::to_string(interpolant.Upper()) + "] rejected: check error " +
+                  std::to_string(result.checkError));
+    }
+    return result.accepted;
+}
+
+} // namespace
+
+ChebyshevInterpolant::ChebyshevInterpolant(double lower, double upper, std::vector<double> nodes,
+                                           Eigen::MatrixXd nodeValues)
+    : lower_(lower), upper_(upper), nodes_(std::move(nodes)), nodeValues_(std::move(nodeValues)) {
+    const int n = static_cast<int>(nodes_.size());
+    if (!(upper > lower) || n < 1 || n != nodeValues_.cols()) {
+        throw std::invalid_argument("Chebyshev interpolant needs a non-empty interval and one value per node");
+    }
+
+    // w_j = 1 / prod_{k != j} (x_j - x_k) on the interval mapped to length 4,
+    // where the products neither overflow nor underflow
+    const double capacity = 4.0 / (upper - lower);
+    weights_.resize(n);
+    for (int j = 0; j < n; ++j) {
+        double product = 1.0;
+        for (int k = 0; k < n; ++k) {
+            if (k != j) {
+                product *= (nodes_[j] - nodes_[k]) * capacity;
+            }
+        }
+        weights_[j] = 1.0 / product;
+    }
+    scale_ = nodeValues_.cwiseAbs().rowwise().maxCoeff();
+}
+
+Eigen::VectorXd ChebyshevInterpolant::Evaluate(double m) const {
+    // Second barycentric form: sum(w_k f_k / (m - x_k)) / sum(w_k / (m - x_k))
+    const int n = NodeCount();
+    Eigen::VectorXd numerator = Eigen::VectorXd::Zero(nodeValues_.rows());
+    double denominator = 0.0;
+    for (int k = 0; k < n; ++k) {
+        const double difference = m - nodes_[k];
+        if (difference == 0.0) {
+            return nodeValues_.col(k);
+        }
+        const double t = weights_[k] / difference;
+        numerator += t * nodeValues_.col(k);
+        denominator += t;
+    }
+    return numerator / denominator;
+}
+
+double ChebyshevInterpolant::RelativeError(double m, const Eigen::Ref<const Eigen::VectorXd>& exact) const {
+    const Eigen::VectorXd error = (Evaluate(m) - exact).cwiseAbs();
+    double worst = 0.0;
+    for (int i = 0; i < error.size(); ++i) {
+        // A component that vanishes at every node is judged absolutely
+        const double scale = (scale_(i) > 0.0) ? scale_(i) : 1.0;
+        const double relative = error(i) / scale;
+        if (std::isnan(relative)) {
+            return relative;
+        }
+        worst = std::max(worst, relative);
+    }
+    return worst;
+}
+
+std::unique_ptr<ChebyshevInterpolant> ChebyshevInterpolant::FitSamples(
+    double lower, double upper,
+    std::vector<double> nodes,
+    Eigen::MatrixXd nodeValues,
+    const std::vector<double>& checks,
+    const Eigen::MatrixXd& checkValues,
+    const ChebyshevOptions& options,
+    ChebyshevFitReport* report)
+{
+    if (nodes.size() < 2 || checks.empty() || checkValues.cols() != static_cast<int>(checks.size())) {
+        throw std::invalid_argument("Chebyshev sample fit needs at least 2 nodes and a value per check point");
+    }
+
+    ChebyshevFitReport local;
+    ChebyshevFitReport& result = report ? *report : local;
+    result = ChebyshevFitReport();
+
+    auto interpolant = std::make_unique<ChebyshevInterpolant>(
+        lower, upper, std::move(nodes), std::move(nodeValues));
+    if (!CheckFit(*interpolant, checks, checkValues, options, result)) {
+        return nullptr;
+    }
+    return interpolant;
+}
+
+std::vector<double> ChebyshevInterpolant::SampleCheckPoints(const std::vector<double>& nodes,
+                                                            const std::vector<double>& candidates,
+                                                            int count) {
+    std::vector<std::pair<double, size_t>> distance;  // (distance to nearest node, candidate)
+    distance.reserve(candidates.size());
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const double m = candidates[i];
+        const auto next = std::lower_bound(nodes.begin(), nodes.end(), m);
+        double nearest = std::numeric_limits<double>::infinity();
+        if (next != nodes.end()) {
+            nearest = *next - m;
+        }
+        if (next != nodes.begin()) {
+            nearest = std::min(nearest, m - *(next - 1));
+        }
+        distance.emplace_back(nearest, i);
+    }
+    const size_t chosen = std::min(distance.size(), static_cast<size_t>(std::max(count, 0)));
+    std::partial_sort(distance.begin(), distance.begin() + chosen, distance.end(),
+                      [](const std::pair<double, size_t>& a, const std::pair<double, size_t>& b) {
+                          return a.first > b.first || (a.first == b.first && a.second < b.second);
+                      });
+
+    std::vector<double> points;
+    for (size_t i = 0; i < chosen; ++i) {
+        points.push_back(candidates[distance[i].second]);
+    }
+    std::sort(points.begin(), points.end());
+    return points;
+}
+
+} // namespace Pavement
@@ -0,0 +1,359 @@
+#include "HankelIntegrator.h"
+#include "SpecialFunctions.h"
+#include "ThreadPool.h"
+#include "WynnEpsilon.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace Pavement {
+
+void HankelIntegrator::KronrodNodes(double lower, double upper, double* nodes)
+{
+    const double centre = 0.5 * (lower + upper);
+    const double halfLength = 0.5 * (upper - lower);
+    nodes[0] = centre;
+    for (int j = 0; j < 7; ++j) {
+        const double dx = halfLength * Constants::GAUSS_KRONROD_NODES_15[j];
+        nodes[1 + 2 * j] = centre - dx;
+        nodes[2 + 2 * j] = centre + dx;
+    }
+}
+
+void HankelIntegrator::EvaluateSegments(
+    const BatchIntegrand& f,
+    int batchSize,
+    std::vector<Segment>& segments,
+    ThreadPool* pool,
+    const SegmentObserver& observer)
+{
+    constexpr int NODES = KRONROD_NODES;
+
+    if (observer) {
+        std::vector<std::pair<double, double>> bounds;
+        bounds.reserve(segments.size());
+        for (const Segment& segment : segments) {
+            bounds.emplace_back(segment.lower, segment.upper);
+        }
+        observer(bounds);
+    }
+
+    std::vector<double> nodes(segments.size() * NODES);
+    for (size_t s = 0; s < segments.size(); ++s) {
+        KronrodNodes(segments[s].lower, segments[s].upper, &nodes[s * NODES]);
+    }
+
+    // Each group writes only its own slots, so evaluation order cannot change the result
+    const int nodeCount = static_cast<int>(nodes.size());
+    const int groups = (nodeCount + batchSize - 1) / batchSize;
+    std::vector<Eigen::VectorXd> values(nodes.size());
+    auto evaluate = [&](int g) {
+        const int first = g * batchSize;
+        f(&nodes[first], std::min(batchSize, nodeCount - first), &values[first]);
+    };
+    if (pool) {
+        pool->ParallelFor(groups, evaluate);
+    } else {
+        for (int g = 0; g < groups; ++g) {
+            evaluate(g);
+        }
+    }
+
+    // Combine in a fixed order (centre shared by the Kronrod and Gauss rules)
+    for (size_t s = 0; s < segments.size(); ++s) {
+        Eigen::VectorXd* fs = &values[s * NODES];
+        const double halfLength = 0.5 * (segments[s].upper - segments[s].lower);
+
+        // A failed node must not poison the sums; the segment keeps the count
+        segments[s].failed = 0;
+        for (int j = 0; j < NODES; ++j) {
+            if (!fs[j].allFinite()) {
+                fs[j] = fs[j].unaryExpr([](double v) { return std::isfinite(v) ? v : 0.0; });
+                ++segments[s].failed;
+            }
+        }
+
+        Eigen::VectorXd kronrod = Constants::GAUSS_KRONROD_WEIGHTS_15[7] * fs[0];
+        Eigen::VectorXd gauss = Constants::GAUSS_WEIGHTS_7[3] * fs[0];
+        for (int j = 0; j < 7; ++j) {
+            Eigen::VectorXd pair = fs[1 + 2 * j] + fs[2 + 2 * j];
+            kronrod += Constants::GAUSS_KRONROD_WEIGHTS_15[j] * pair;
+            if (j % 2 == 1) {
+                gauss += Constants::GAUSS_WEIGHTS_7[j / 2] * pair;
+            }
+        }
+
+        segments[s].value = kronrod * halfLength;
+        segments[s].error = ((kronrod - gauss) * halfLength).cwiseAbs().maxCoeff();
+    }
+}
+
+HankelIntegrationResult HankelIntegrator::Integrate(
+    const Integrand& f,
+    const std::vector<double>& breakpoints,
+    const HankelIntegrationOptions& options,
+    ThreadPool* pool,
+    const SegmentObserver& observer)
+{
+    auto single = [&f](const double* m, int count, Eigen::VectorXd* values) {
+        for (int i = 0; i < count; ++i) {
+            values[i] = f(m[i]);
+        }
+    };
+    return IntegrateBatched(single, 1, breakpoints, options, pool, observer);
+}
+
+HankelIntegrationResult HankelIntegrator::IntegrateBatched(
+    const BatchIntegrand& f,
+    int batchSize,
+    const std::vector<double>& breakpoints,
+    const HankelIntegrationOptions& options,
+    ThreadPool* pool,
+    const SegmentObserver& observer)
+{
+    if (batchSize < 1) {
+        throw std::invalid_argument("Hankel integration batch size must be at least 1");
+    }
+    if (breakpoints.size() < 2) {
+        throw std::invalid_argument("Hankel integration requires at least 2 breakpoints");
+    }
+
+    std::vector<Segment> initial;
+    for (size_t i = 0; i + 1 < breakpoints.size(); ++i) {
+        if (breakpoints[i + 1] <= breakpoints[i]) {
+            continue;  // Skip empty or reversed intervals
+        }
+        initial.push_back(Segment{breakpoints[i], breakpoints[i + 1], Eigen::VectorXd(), 0.0});
+    }
+
+    if (initial.empty()) {
+        throw std::invalid_argument("Hankel integration range is empty");
+    }
+
+    if (options.extrapolateTail) {
+        return Extrapolate(f, batchSize, initial, options, pool, observer);
+    }
+
+    HankelIntegrationResult result;
+    const std::vector<Segment> segments =
+        Refine(f, batchSize, std::move(initial), options.absoluteTolerance, options.relativeTolerance,
+               options.maxEvaluations, result.evaluations, pool, observer);
+
+    // Re-sum in interval order so the result does not depend on refinement history
+    result.value = Eigen::VectorXd::Zero(segments.front().value.size());
+    result.errorEstimate = 0.0;
+    for (const Segment& segment : segments) {
+        result.value += segment.value;
+        result.errorEstimate += segment.error;
+        result.failedEvaluations += segment.failed;
+    }
+    result.intervals = static_cast<int>(segments.size());
+    result.converged = result.failedEvaluations == 0 && result.errorEstimate <= std::max(
+        options.absoluteTolerance,
+        options.relativeTolerance * result.value.cwiseAbs().maxCoeff());
+
+    if (result.failedEvaluations > 0) {
+        LOG_WARNING("Hankel integration not converged: " + std::to_string(result.failedEvaluations) +
+                    " integrand evaluation(s) failed and were integrated as zero");
+    } else if (!result.converged) {
+        LOG_WARNING("Hankel integration did not reach tolerance: error estimate " +
+                    std::to_string(result.errorEstimate) + " after " +
+                    std::to_string(result.evaluations) + " evaluations");
+    }
+
+    return result;
+}
+
+std::vector<HankelIntegrator::Segment> HankelIntegrator::Refine(
+    const BatchIntegrand& f,
+    int batchSize,
+    std::vector<Segment> initial,
+    double absoluteTolerance,
+    double relativeTolerance,
+    int maxEvaluations,
+    int& evaluations,
+    ThreadPool* pool,
+    const SegmentObserver& observer)
+{
+    constexpr int EVALUATIONS_PER_SEGMENT = KRONROD_NODES;
+
+    auto byError = [](const Segment& a, const Segment& b) { return a.error < b.error; };
+    std::priority_queue<Segment, std::vector<Segment>, decltype(byError)> queue(byError);
+
+    EvaluateSegments(f, batchSize, initial, pool, observer);
+    evaluations += EVALUATIONS_PER_SEGMENT * static_cast<int>(initial.size());
+
+    Eigen::VectorXd total = Eigen::VectorXd::Zero(initial.front().value.size());
+    double totalError = 0.0;
+    for (Segment& segment : initial) {
+        total += segment.value;
+        totalError += segment.error;
+        queue.push(std::move(segment));
+    }
+
+    auto tolerance = [&]() {
+        return std::max(absoluteTolerance, relativeTolerance * total.cwiseAbs().maxCoeff());
+    };
+
+    // Bisect the worst subinterval until the global error meets the tolerance
+    while (totalError > tolerance() &&
+           evaluations + 2 * EVALUATIONS_PER_SEGMENT <= maxEvaluations) {
+        Segment worst = queue.top();
+        queue.pop();
+
+        const double mid = 0.5 * (worst.lower + worst.upper);
+        if (mid <= worst.lower || mid >= worst.upper) {
+            // Interval cannot be split further in double precision
+            queue.push(std::move(worst));
+            break;
+        }
+
+        std::vector<Segment> halves = {
+            Segment{worst.lower, mid, Eigen::VectorXd(), 0.0},
+            Segment{mid, worst.upper, Eigen::VectorXd(), 0.0}
+        };
+        EvaluateSegments(f, batchSize, halves, pool, observer);
+        evaluations += 2 * EVALUATIONS_PER_SEGMENT;
+
+        total += halves[0].value + halves[1].value - worst.value;
+        totalError += halves[0].error + halves[1].error - worst.error;
+        queue.push(std::move(halves[0]));
+        queue.push(std::move(halves[1]));
+    }
+
+    std::vector<Segment> segments;
+    segments.reserve(queue.size());
+    while (!queue.empty()) {
+        segments.push_back(queue.top());
+        queue.pop();
+    }
+    std::sort(segments.begin(), segments.end(),
+              [](const Segment& a, const Segment& b) { return a.lower < b.lower; });
+    return segments;
+}
+
+HankelIntegrationResult HankelIntegrator::Extrapolate(
+    const BatchIntegrand& f,
+    int batchSize,
+    const std::vector<Segment>& intervals,
+    const HankelIntegrationOptions& options,
+    ThreadPool* pool,
+    const SegmentObserver& observer)
+{
+    constexpr int EVALUATIONS_PER_SEGMENT = KRONROD_NODES;
+    constexpr int ROUND = Constants::HANKEL_EXTRAPOLATION_ROUND;
+    static_assert(ROUND >= 3, "The first round must give the epsilon table three terms");
+
+    const int count = static_cast<int>(intervals.size());
+    if (count < 3) {
+        throw std::invalid_argument("Partition-extrapolation requires at least 3 intervals");
+    }
+
+    auto tolerance = [&](const Eigen::VectorXd& value) {
+        return std::max(options.absoluteTolerance,
+                        options.relativeTolerance * value.cwiseAbs().maxCoeff());
+    };
+
+    HankelIntegrationResult result;
+    WynnEpsilon epsilon;
+    Eigen::VectorXd partialSum;
+    double quadratureError = 0.0;
+
+    for (int first = 0; first < count; first += ROUND) {
+        const int last = std::min(count, first + ROUND);
+        if (first > 0 && result.evaluations + EVALUATIONS_PER_SEGMENT * (last - first) > options.maxEvaluations) {
+            break;
+        }
+
+        // Each round may spend a quarter of the tolerance on quadrature
+        const double absoluteTolerance = first > 0
+            ? 0.25 * tolerance(epsilon.Estimate())
+            : 0.25 * options.absoluteTolerance;
+        const std::vector<Segment> segments = Refine(
+            f, batchSize, std::vector<Segment>(intervals.begin() + first, intervals.begin() + last),
+            absoluteTolerance, 0.25 * options.relativeTolerance, options.maxEvaluations,
+            result.evaluations, pool, observer);
+
+        // Partial sum up to the end of every interval of the round
+        if (partialSum.size() == 0) {
+            partialSum = Eigen::VectorXd::Zero(segments.front().value.size());
+        }
+        int next = first;
+        for (const Segment& segment : segments) {
+            partialSum += segment.value;
+            quadratureError += segment.error;
+            result.failedEvaluations += segment.failed;
+            if (segment.upper == intervals[next].upper) {
+                epsilon.Add(partialSum);
+                ++next;
+            }
+        }
+        result.intervals += static_cast<int>(segments.size());
+        result.partitions = next;
+
+        if (result.failedEvaluations > 0) {
+            break;  // Extrapolating a partial sum with missing points cannot converge
+        }
+        if (epsilon.ErrorEstimate() + quadratureError <= tolerance(epsilon.Estimate())) {
+            result.converged = true;
+            break;
+        }
+    }
+
+    result.value = epsilon.Estimate();
+    result.extrapolationError = epsilon.ErrorEstimate();
+    result.errorEstimate = quadratureError + result.extrapolationError;
+
+    if (result.failedEvaluations > 0) {
+        LOG_WARNING("Hankel integration not converged: " + std::to_string(result.failedEvaluations) +
+                    " integrand evaluation(s) failed and were integrated as zero");
+    } else if (!result.converged) {
+        LOG_WARNING("Hankel integration did not reach tolerance: error estimate " +
+                    std::to_string(result.errorEstimate) + " after " +
+                    std::to_string(result.partitions) + " extrapolated intervals (" +
+                    std::to_string(result.evaluations) + " evaluations)");
+    }
+
+    return result;
+}
+
+std::vector<double> HankelIntegrator::BesselJ1Breakpoints(double contactRadius, double upperBound)
+{
+    // j_{1,k} > k pi, so every zero below the bound is among the first count
+    const int count = std::max(0, static_cast<int>(upperBound * contactRadius / M_PI) + 1);
+    const std::vector<double> zeros = SpecialFunctions::BesselZeros(1, count);
+
+    std::vector<double> breakpoints;
+    breakpoints.push_back(0.0);
+    for (double zero : zeros) {
+        const double m = zero / contactRadius;
+        if (m >= upperBound) {
+            break;
+        }
+        breakpoints.push_back(m);
+    }
+
+    breakpoints.push_back(upperBound);
+    return breakpoints;
+}
+
+std::vector<double> HankelIntegrator::BesselJ1ZeroBreakpoints(double contactRadius, int intervals)
+{
+    const std::vector<double> zeros = SpecialFunctions::BesselZeros(1, intervals);
+
+    std::vector<double> breakpoints;
+    breakpoints.reserve(intervals + 1);
+    breakpoints.push_back(0.0);
+    for (double zero : zeros) {
+        breakpoints.push_back(zero / contactRadius);
+    }
+    return breakpoints;
+}
+
+} // namespace Pavement
@@ -1,90 +1,125 @@
 #include "MatrixOperations.h"
 #include "Logger.h"
 #include "Constants.h"
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
-#include <iostream>
-#include <fstream>
+#include <limits>
 
 namespace Pavement {
 
+namespace {
+
+// b - M x for a dense matrix, accumulated in double-double
+template <typename Matrix, typename Vector>
+Vector ExtendedResidual(const Matrix& M, const Vector& x, const Vector& b) {
+    Vector r(b.size());
+    for (int i = 0; i < M.rows(); ++i) {
+        CompensatedResidual sum(b(i));
+        for (int j = 0; j < M.cols(); ++j) {
+            sum.Subtract(M(i, j), x(j));
+        }
+        r(i) = sum.Value();
+    }
+    return r;
+}
+
+// Iterative refinement x += A^-1 r when the residual misses the tolerance.
+// correction(r) solves with the existing factors, residualOf(x) is b - M x in
+// extended precision. Stops when the residual stops decreasing.
+template <typename Vector, typename Correction, typename ResidualOf>
+int RefineSolution(Vector& x, double& residual, int maxSteps,
+                   const Correction& correction, const ResidualOf& residualOf) {
+    if (residual <= Constants::RESIDUAL_TOLERANCE || maxSteps <= 0) {
+        return 0;
+    }
+    Vector residualVector = residualOf(x);
+    residual = residualVector.norm();
+    
+    int steps = 0;
+    while (!(residual <= Constants::RESIDUAL_TOLERANCE) && steps < maxSteps) {
+        ++steps;
+        const Vector candidate = x + correction(residualVector);
+        const Vector candidateResidual = residualOf(candidate);
+        const double candidateNorm = candidateResidual.norm();
+        if (!(candidateNorm < residual)) {
+            break;
+        }
+        x = candidate;
+        residualVector = candidateResidual;
+        residual = candidateNorm;
+    }
+    return steps;
+}
+
+std::string ResidualError(double residual, int refinementSteps) {
+    return "Matrix solution failed: residual = " + std::to_string(residual) +
+           " (tolerance: " + std::to_string(Constants::RESIDUAL_TOLERANCE) + ") after " +
+           std::to_string(refinementSteps) + " refinement steps";
+}
+
+} // namespace
+
 Eigen::MatrixXd MatrixOperations::AssembleSystemMatrix(
     double m, 
     const CalculationInput& input) 
 {
-    int k = 4 * input.layerCount - 2;  // System size
-    Eigen::MatrixXd M = Eigen::MatrixXd::Zero(k, k);
-    
-    auto depths = ComputeLayerDepths(input.thicknesses);
-    
-    // Assemble surface boundary conditions
-    AssembleSurfaceBoundary(M, m, input);
-    
-    LOG_INFO("Assembling " + std::to_string(input.layerCount - 1) + " interfaces");
-    
-    // Assemble interface blocks for each layer
-    int currentRow = 2; // Start after surface conditions
-    for (int i = 0; i < input.layerCount - 1; ++i) {
-        AssembleInterfaceBlock(M, i, m, input, depths);
-        currentRow += 4; // Each interface adds 4 equations
-    }
-    
-    LOG_INFO("Matrix assembly complete");
-    
+    const AssemblyPlan plan(input);
+    Eigen::MatrixXd M = Eigen::MatrixXd::Zero(plan.Size(), plan.Size());
+    plan.Fill(m, M);
+    return M;
+}
+
+BandedMatrix MatrixOperations::AssembleBandedSystem(
+    double m, 
+    const AssemblyPlan& plan) 
+{
+    BandedMatrix M(plan.Size(), SYSTEM_LOWER_BANDWIDTH, SYSTEM_UPPER_BANDWIDTH);
+    plan.Fill(m, M);
     return M;
 }
 
 Eigen::VectorXd MatrixOperations::SolveCoefficients(
     double m, 
-    const CalculationInput& input) 
+    const CalculationInput& input,
+    SolveReport* report,
+    const SolveOptions& options) 
 {
-    Eigen::MatrixXd M = AssembleSystemMatrix(m, input);
-    
-    int k = 4 * input.layerCount - 2;
-    Eigen::VectorXd b = Eigen::VectorXd::Zero(k);
-    
-    // Proper surface boundary conditions
-    b(0) = 0.0;  // Zero shear stress at surface
-    b(1) = -input.pressure;  // Applied normal stress (negative for compression)
-    
-    // Debug to file and console
-    std::ofstream debugFile("C:\\Temp\\PavementDebug.txt", std::ios::app);
-    
-    auto logToAll = [&](const std::string& msg) {
-        std::cout << msg << std::endl;
-        if (debugFile.is_open()) {
-            debugFile << msg << std::endl;
-        }
-    };
-    
-    logToAll("=== MATRIX SOLVE DEBUG (m=" + std::to_string(m) + ") ===");
-    logToAll("Matrix size: " + std::to_string(M.rows()) + "x" + std::to_string(M.cols()));
-    logToAll("Pressure value: " + std::to_string(input.pressure) + " MPa");
-    
-    std::string rhsStr = "Right-hand side vector (size " + std::to_string(k) + "): [";
-    for (int i = 0; i < std::min(k, 10); ++i) {
-        rhsStr += std::to_string(b(i));
-        if (i < std::min(k, 10) - 1) rhsStr += ", ";
-    }
-    if (k > 10) rhsStr += ", ...";
-    rhsStr += "]";
-    logToAll(rhsStr);
-    
-    // Log ALL rows of matrix to see what's being assembled
-    for (int row = 0; row < M.rows(); ++row) {
-        std::string rowStr = "M[" + std::to_string(row) + "]: [";
-        for (int col = 0; col < M.cols(); ++col) {  // Show ALL columns
-            rowStr += std::to_string(M(row, col));
-            if (col < M.cols() - 1) rowStr += ", ";
-        }
-        rowStr += "]";
-        logToAll(rowStr);
-    }
-    
-    if (debugFile.is_open()) {
-        debugFile.close();
+    return SolveCoefficients(m, AssemblyPlan(input), report, options);
+}
+
+Eigen::VectorXd MatrixOperations::SolveCoefficients(
+    double m, 
+    const AssemblyPlan& plan,
+    SolveReport* report,
+    const SolveOptions& options) 
+{
+    SolveReport local;
+    SolveReport& diagnostics = report ? *report : local;
+    Eigen::VectorXd x;
+    if (TrySolveCoefficients(m, plan, x, &diagnostics, options) != SolveStatus::Ok) {
+        ThrowSolveFailure(diagnostics, m);
     }
+    WarnIfIllConditioned(diagnostics.reciprocalCondition, m);
+    return x;
+}
+
+SolveStatus MatrixOperations::TrySolveCoefficients(
+    double m,
+    const AssemblyPlan& plan,
+    Eigen::VectorXd& coefficients,
+    SolveReport* report,
+    const SolveOptions& options)
+{
+    SolveReport local;
+    SolveReport& diagnostics = report ? *report : local;
+    diagnostics = SolveReport();
+    BandedMatrix M = AssembleBandedSystem(m, plan);
     
+    int k = plan.Size();
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(k);
+    b(1) = -plan.Pressure();  // Applied normal stress (negative for compression)
+
     // SOLUTION 1: Row and column scaling for numerical stability
     // This is critical for ill-conditioned matrices with exponential terms
     Eigen::VectorXd rowScales = Eigen::VectorXd::Ones(k);
@@ -92,7 +127,7 @@ Eigen::VectorXd MatrixOperations::SolveCoefficients(
     
     // Compute row scaling factors (largest absolute value in each row)
     for (int i = 0; i < k; ++i) {
-        double maxRowVal = M.row(i).cwiseAbs().maxCoeff();
+        double maxRowVal = M.RowMaxAbs(i);
         if (maxRowVal > 1e-15) {  // Avoid division by near-zero
             rowScales(i) = 1.0 / maxRowVal;
         }
@@ -100,440 +135,336 @@ Eigen::VectorXd MatrixOperations::SolveCoefficients(
     
     // Compute column scaling factors (largest absolute value in each column)
     for (int j = 0; j < k; ++j) {
-        double maxColVal = M.col(j).cwiseAbs().maxCoeff();
+        double maxColVal = M.ColMaxAbs(j);
         if (maxColVal > 1e-15) {
             colScales(j) = 1.0 / maxColVal;
         }
     }
     
     // Apply scaling to matrix: M_scaled = diag(rowScales) * M * diag(colScales)
-    Eigen::MatrixXd M_scaled = M;
+    BandedMatrix M_scaled = M;
     for (int i = 0; i < k; ++i) {
-        M_scaled.row(i) *= rowScales(i);
+        M_scaled.ScaleRow(i, rowScales(i));
     }
     for (int j = 0; j < k; ++j) {
-        M_scaled.col(j) *= colScales(j);
+        M_scaled.ScaleCol(j, colScales(j));
     }
     
     // Apply row scaling to right-hand side
     Eigen::VectorXd b_scaled = b.cwiseProduct(rowScales);
     
-    // Log scaling info
-    LOG_INFO("Matrix scaling applied - max row scale: " + std::to_string(rowScales.maxCoeff()) +
-             ", min row scale: " + std::to_string(rowScales.minCoeff()));
-    
-    // Check matrix condition for numerical stability
-    double conditionNumber = CheckConditionNumber(M_scaled);
-    if (conditionNumber > Constants::CONDITION_NUMBER_WARNING_THRESHOLD) {
-        LOG_WARNING("High condition number " + std::to_string(conditionNumber) + 
-                   " - results may be inaccurate");
-        std::cerr << "Warning: High condition number " << conditionNumber 
-                  << " - results may be inaccurate" << std::endl;
+    // Banded LU with partial pivoting inside the band on the SCALED matrix
+    BandedLU lu(M_scaled);
+    if (!lu.IsInvertible()) {
+        diagnostics.status = SolveStatus::Singular;
+        return diagnostics.status;
     }
     
-    // Use partial pivoting LU decomposition (stable and fast) on SCALED matrix
-    Eigen::PartialPivLU<Eigen::MatrixXd> lu = M_scaled.partialPivLu();
-    Eigen::VectorXd x_scaled = lu.solve(b_scaled);
+    // Stability monitoring from the factors: a few extra O(k) solves, no SVD
+    const double reciprocalCondition = lu.ReciprocalCondition();
+    diagnostics.reciprocalCondition = reciprocalCondition;
+    
+    Eigen::VectorXd x_scaled = lu.Solve(b_scaled);
     
     // Unscale the solution: x = diag(colScales) * x_scaled
     Eigen::VectorXd x = x_scaled.cwiseProduct(colScales);
     
-    // Check solution validity using ORIGINAL matrix and RHS
-    double residual = (M * x - b).norm();
-    if (residual > Constants::RESIDUAL_TOLERANCE) {
-        std::string error = "Matrix solution failed: residual = " + std::to_string(residual) +
-                          " (tolerance: " + std::to_string(Constants::RESIDUAL_TOLERANCE) + ")";
-        LOG_ERROR(error);
-        throw std::runtime_error(error);
+    // Check solution validity using ORIGINAL matrix and RHS, refining if needed
+    // (negated tests so a NaN residual from a singular factorisation is rejected too)
+    double residual = (M.Multiply(x) - b).norm();
+    const int refinementSteps = RefineSolution(
+        x, residual, options.maxRefinementSteps,
+        [&](const Eigen::VectorXd& r) {
+            return lu.Solve(r.cwiseProduct(rowScales)).cwiseProduct(colScales).eval();
+        },
+        [&](const Eigen::VectorXd& candidate) { return M.Residual(candidate, b); });
+    diagnostics.residual = residual;
+    diagnostics.refinementSteps = refinementSteps;
+    if (!(residual <= Constants::RESIDUAL_TOLERANCE)) {
+        diagnostics.status = SolveStatus::ResidualTooLarge;
+        return diagnostics.status;
     }
     
-    return x;
+    if (options.exactConditionNumber) {
+        diagnostics.exactConditionNumber = CheckConditionNumber(M_scaled.ToDense());
+    }
+    coefficients = x;
+    return SolveStatus::Ok;
 }
 
-std::vector<double> MatrixOperations::ComputeLayerDepths(
-    const std::vector<double>& thicknesses) 
+BatchSolveResult MatrixOperations::SolveCoefficientsBatch(
+    const double* m,
+    int count,
+    const AssemblyPlan& plan,
+    const SolveOptions& options) 
 {
-    std::vector<double> depths;
-    depths.reserve(thicknesses.size() + 1);
+    constexpr int L = BATCH_SIZE;
+    using LaneVectors = BatchedBandedMatrix::LaneVectors;
     
-    depths.push_back(0.0);  // Surface depth
-    double cumulativeDepth = 0.0;
+    if (count < 1 || count > L) {
+        throw std::invalid_argument("Batched solve takes 1 to " + std::to_string(L) +
+                                    " parameters, got " + std::to_string(count));
+    }
     
-    for (size_t i = 0; i < thicknesses.size() - 1; ++i) {  // Exclude platform
-        cumulativeDepth += thicknesses[i];
-        depths.push_back(cumulativeDepth);
+    // Unused lanes repeat the last parameter and are discarded
+    double lanes[L];
+    for (int l = 0; l < L; ++l) {
+        lanes[l] = m[std::min(l, count - 1)];
     }
     
-    return depths;
-}
-
-void MatrixOperations::AssembleInterfaceBlock(
-    Eigen::MatrixXd& M,
-    int layerIndex,
-    double m,
-    const CalculationInput& input,
-    const std::vector<double>& depths) 
-{
-    int row = 2 + layerIndex * 4;  // Starting row for this interface
+    const int k = plan.Size();
+    BatchedBandedMatrix M(k, SYSTEM_LOWER_BANDWIDTH, SYSTEM_UPPER_BANDWIDTH);
+    for (int l = 0; l < L; ++l) {
+        BatchedBandedMatrix::LaneView lane = M.Lane(l);
+        plan.Fill(lanes[l], lane);
+    }
     
-    // Get interface type (0=bonded, 1=semi-bonded, 2=unbonded)
-    int interfaceType = input.interfaceTypes[layerIndex];
+    LaneVectors b = LaneVectors::Zero(k, L);
+    b.row(1).setConstant(-plan.Pressure());  // Applied normal stress (negative for compression)
     
-    // CRITICAL: Platform layer (last layer) interface MUST be unbonded
-    // because the platform only has 2 coefficients (A, B), not 4
-    // Bonded/semi-bonded interfaces require 4×4 coefficient continuity
-    bool isPlatformInterface = (layerIndex == input.layerCount - 2);
-    if (isPlatformInterface) {
-        interfaceType = 2; // Force unbonded for platform interface
+    // Same row/column equilibration as SolveCoefficients, per lane
+    LaneVectors rowScales = LaneVectors::Ones(k, L);
+    LaneVectors colScales = LaneVectors::Ones(k, L);
+    double maxima[L];
+    for (int i = 0; i < k; ++i) {
+        M.RowMaxAbs(i, maxima);
+        for (int l = 0; l < L; ++l) {
+            if (maxima[l] > 1e-15) {
+                rowScales(i, l) = 1.0 / maxima[l];
+            }
+        }
+    }
+    for (int j = 0; j < k; ++j) {
+        M.ColMaxAbs(j, maxima);
+        for (int l = 0; l < L; ++l) {
+            if (maxima[l] > 1e-15) {
+                colScales(j, l) = 1.0 / maxima[l];
+            }
+        }
     }
     
-    LOG_INFO(
-        "Assembling interface " + std::to_string(layerIndex) +
-        ", type=" + std::to_string(interfaceType) +
-        ", row=" + std::to_string(row) +
-        ", isPlatform=" + std::to_string(isPlatformInterface));
+    BatchedBandedMatrix M_scaled = M;
+    for (int i = 0; i < k; ++i) {
+        M_scaled.ScaleRows(i, &rowScales(i, 0));
+    }
+    for (int j = 0; j < k; ++j) {
+        M_scaled.ScaleCols(j, &colScales(j, 0));
+    }
     
-    if (interfaceType == 0 || interfaceType == 1) {
-        // Bonded or semi-bonded interface
-        AssembleBondedInterface(M, row, layerIndex, m, input, depths);
-    } else if (interfaceType == 2) {
-        // Unbonded interface
-        AssembleUnbondedInterface(M, row, layerIndex, m, input, depths);
+    const BatchedBandedLU lu(M_scaled);
+    const std::array<double, L> reciprocalCondition = lu.ReciprocalCondition();
+    LaneVectors x = lu.Solve(b.cwiseProduct(rowScales)).cwiseProduct(colScales);
+    LaneVectors residuals = M.Multiply(x) - b;
+    
+    // Iterative refinement of the lanes that miss the tolerance, with
+    // extended-precision residuals; the other lanes get a zero correction
+    double residual[L];
+    int refinementSteps[L] = {};
+    bool refining[L];
+    bool anyRefining = false;
+    for (int l = 0; l < L; ++l) {
+        residual[l] = residuals.col(l).norm();
+        refining[l] = l < count && lu.IsInvertible(l) &&
+                      !(residual[l] <= Constants::RESIDUAL_TOLERANCE);
+        anyRefining = anyRefining || refining[l];
+    }
+    if (anyRefining && options.maxRefinementSteps > 0) {
+        residuals = M.Residual(x, b);
+        for (int l = 0; l < L; ++l) {
+            if (refining[l]) {
+                residual[l] = residuals.col(l).norm();
+            }
+        }
+    }
+    for (int step = 0; anyRefining && step < options.maxRefinementSteps; ++step) {
+        LaneVectors rhs = LaneVectors::Zero(k, L);
+        bool anyLane = false;
+        for (int l = 0; l < L; ++l) {
+            refining[l] = refining[l] && !(residual[l] <= Constants::RESIDUAL_TOLERANCE);
+            if (refining[l]) {
+                rhs.col(l) = residuals.col(l).cwiseProduct(rowScales.col(l));
+                anyLane = true;
+            }
+        }
+        if (!anyLane) {
+            break;
+        }
+        
+        const LaneVectors candidate = x + lu.Solve(rhs).cwiseProduct(colScales);
+        const LaneVectors candidateResiduals = M.Residual(candidate, b);
+        for (int l = 0; l < L; ++l) {
+            if (!refining[l]) {
+                continue;
+            }
+            ++refinementSteps[l];
+            const double candidateNorm = candidateResiduals.col(l).norm();
+            if (!(candidateNorm < residual[l])) {
+                refining[l] = false;
+                continue;
+            }
+            x.col(l) = candidate.col(l);
+            residuals.col(l) = candidateResiduals.col(l);
+            residual[l] = candidateNorm;
+        }
     }
+    
+    BatchSolveResult result;
+    result.coefficients = x.leftCols(count);
+    result.reports.resize(count);
+    for (int l = 0; l < count; ++l) {
+        if (!lu.IsInvertible(l)) {
+            result.reports[l].status = SolveStatus::Singular;
+            continue;
+        }
+        
+        result.reports[l].reciprocalCondition = reciprocalCondition[l];
+        result.reports[l].residual = residual[l];
+        result.reports[l].refinementSteps = refinementSteps[l];
+        
+        // (negated test so a NaN residual is rejected too)
+        if (!(residual[l] <= Constants::RESIDUAL_TOLERANCE)) {
+            result.reports[l].status = SolveStatus::ResidualTooLarge;
+            continue;
+        }
+        if (options.exactConditionNumber) {
+            result.reports[l].exactConditionNumber =
+                CheckConditionNumber(M_scaled.ExtractLane(l).ToDense());
+        }
+    }
+    
+    return result;
 }
 
-void MatrixOperations::AssembleBondedInterface(
-    Eigen::MatrixXd& M,
-    int row,
-    int layerIndex,
-    double m,
-    const CalculationInput& input,
-    const std::vector<double>& depths) 
+template <int LayerCount>
+MatrixOperations::FixedCoefficients<LayerCount> MatrixOperations::SolveCoefficientsFixed(
+    double m, 
+    const AssemblyPlan& plan,
+    SolveReport* report,
+    const SolveOptions& options) 
 {
-    // Complete bonded interface implementation based on layered elastic theory
-    // 4 continuity equations: vertical displacement, radial displacement, vertical stress, shear stress
-    
-    double h = depths[layerIndex + 1]; // Interface depth
-    double E1 = input.youngModuli[layerIndex];     // Upper layer modulus
-    double E2 = input.youngModuli[layerIndex + 1]; // Lower layer modulus
-    double nu1 = input.poissonRatios[layerIndex];
-    double nu2 = input.poissonRatios[layerIndex + 1];
-    
-    // Shear moduli
-    double G1 = E1 / (2.0 * (1.0 + nu1));
-    double G2 = E2 / (2.0 * (1.0 + nu2));
-    
-    // SOLUTION 3: Stabilisation selon littérature académique
-    // "formulation contain only non-positive exponents, which are critical for numerical stability"
-    double mh = m * h;
-    
-    // Technique de stabilisation CRITIQUE: Pour m*h > 30, exp(m*h) déborde
-    // On reformule en utilisant UNIQUEMENT les termes décroissants
-    // Principe: Si exp(mh) est énorme, les termes en exp(-mh) dominent de toute façon
-    double exp_neg_mh, exp_pos_mh;
-    
-    if (mh > 30.0) {
-        // Pour grand mh: exp(mh) >> exp(-mh), donc termes positifs négligeables
-        // On met exp_pos_mh = 0 et on garde seulement exp_neg_mh
-        exp_neg_mh = std::exp(-mh);
-        exp_pos_mh = 0.0;  // Négligeable comparé à exp(mh) qui déborderait
-    } else {
-        // Pour petit/moyen mh: calcul normal
-        exp_neg_mh = std::exp(-mh);
-        exp_pos_mh = std::exp(mh);
+    if (plan.LayerCount() != LayerCount) {
+        throw std::invalid_argument("Fixed-size solver for " + std::to_string(LayerCount) +
+                                    " layers called with " + std::to_string(plan.LayerCount()));
     }
-
     
-    int col1 = layerIndex * 4;       // Upper layer coefficients
-    int col2 = (layerIndex + 1) * 4; // Lower layer coefficients
-    
-    // Check if we have room for the next layer's coefficients
-    // For the last non-platform layer interfacing with platform, platform has no full coefficient set
-    const int maxCol = M.cols() - 1;
-    const bool hasNextLayerCoeffs = (col2 + 3) <= maxCol;
-    
-    if (!hasNextLayerCoeffs) {
-        // Platform layer interface - should not happen for bonded interface
-        // but add safety check
-        throw std::runtime_error(
-            "Bonded interface not supported for platform layer at layerIndex=" + 
-            std::to_string(layerIndex));
-    }
-    
-    // Equation 1: Continuity of vertical displacement w
-    // w_upper(h) = w_lower(h)
-    M(row, col1) = exp_neg_mh;
-    M(row, col1 + 1) = h * exp_neg_mh;
-    M(row, col1 + 2) = exp_pos_mh;
-    M(row, col1 + 3) = h * exp_pos_mh;
-    
-    M(row, col2) = -exp_neg_mh;
-    M(row, col2 + 1) = -h * exp_neg_mh;
-    M(row, col2 + 2) = -exp_pos_mh;
-    M(row, col2 + 3) = -h * exp_pos_mh;
-    
-    // Equation 2: Continuity of radial displacement u
-    // u_upper(h) = u_lower(h)
-    double term1_1 = ((1.0 - nu1) / m) * exp_neg_mh;
-    double term1_2 = ((1.0 - nu1) * h / m - 1.0 / (m * m)) * exp_neg_mh;
-    double term1_3 = -((1.0 - nu1) / m) * exp_pos_mh;
-    double term1_4 = -((1.0 - nu1) * h / m + 1.0 / (m * m)) * exp_pos_mh;
-    
-    double term2_1 = -((1.0 - nu2) / m) * exp_neg_mh;
-    double term2_2 = -((1.0 - nu2) * h / m - 1.0 / (m * m)) * exp_neg_mh;
-    double term2_3 = ((1.0 - nu2) / m) * exp_pos_mh;
-    double term2_4 = ((1.0 - nu2) / h / m + 1.0 / (m * m)) * exp_pos_mh;
-    
-    M(row + 1, col1) = term1_1;
-    M(row + 1, col1 + 1) = term1_2;
-    M(row + 1, col1 + 2) = term1_3;
-    M(row + 1, col1 + 3) = term1_4;
-    
-    M(row + 1, col2) = term2_1;
-    M(row + 1, col2 + 1) = term2_2;
-    M(row + 1, col2 + 2) = term2_3;
-    M(row + 1, col2 + 3) = term2_4;
-    
-    // Equation 3: Continuity of vertical stress σ_z
-    // σ_z_upper(h) = σ_z_lower(h)
-    double sigma_z1_1 = E1 * ((1.0 - nu1) + nu1 * m * h) * exp_neg_mh;
-    double sigma_z1_2 = E1 * ((1.0 - nu1) * h + nu1 * (m * h * h - 1.0 / m)) * exp_neg_mh;
-    double sigma_z1_3 = E1 * ((1.0 - nu1) - nu1 * m * h) * exp_pos_mh;
-    double sigma_z1_4 = E1 * ((1.0 - nu1) * h - nu1 * (m * h * h + 1.0 / m)) * exp_pos_mh;
-    
-    double sigma_z2_1 = -E2 * ((1.0 - nu2) + nu2 * m * h) * exp_neg_mh;
-    double sigma_z2_2 = -E2 * ((1.0 - nu2) * h + nu2 * (m * h * h - 1.0 / m)) * exp_neg_mh;
-    double sigma_z2_3 = -E2 * ((1.0 - nu2) - nu2 * m * h) * exp_pos_mh;
-    double sigma_z2_4 = -E2 * ((1.0 - nu2) * h - nu2 * (m * h * h + 1.0 / m)) * exp_pos_mh;
-    
-    M(row + 2, col1) = sigma_z1_1;
-    M(row + 2, col1 + 1) = sigma_z1_2;
-    M(row + 2, col1 + 2) = sigma_z1_3;
-    M(row + 2, col1 + 3) = sigma_z1_4;
-    
-    M(row + 2, col2) = sigma_z2_1;
-    M(row + 2, col2 + 1) = sigma_z2_2;
-    M(row + 2, col2 + 2) = sigma_z2_3;
-    M(row + 2, col2 + 3) = sigma_z2_4;
-    
-    // Equation 4: Continuity of shear stress τ_rz
-    // τ_rz_upper(h) = τ_rz_lower(h)
-    double tau_rz1_1 = G1 * m * (1.0 - m * h) * exp_neg_mh;
-    double tau_rz1_2 = G1 * m * (-h + m * h * h - 2.0 / m) * exp_neg_mh;
-    double tau_rz1_3 = -G1 * m * (1.0 + m * h) * exp_pos_mh;
-    double tau_rz1_4 = -G1 * m * (h + m * h * h + 2.0 / m) * exp_pos_mh;
-    
-    double tau_rz2_1 = -G2 * m * (1.0 - m * h) * exp_neg_mh;
-    double tau_rz2_2 = -G2 * m * (-h + m * h * h - 2.0 / m) * exp_neg_mh;
-    double tau_rz2_3 = G2 * m * (1.0 + m * h) * exp_pos_mh;
-    double tau_rz2_4 = G2 * m * (h + m * h * h + 2.0 / m) * exp_pos_mh;
-    
-    M(row + 3, col1) = tau_rz1_1;
-    M(row + 3, col1 + 1) = tau_rz1_2;
-    M(row + 3, col1 + 2) = tau_rz1_3;
-    M(row + 3, col1 + 3) = tau_rz1_4;
-    
-    M(row + 3, col2) = tau_rz2_1;
-    M(row + 3, col2 + 1) = tau_rz2_2;
-    M(row + 3, col2 + 2) = tau_rz2_3;
-    M(row + 3, col2 + 3) = tau_rz2_4;
+    SolveReport local;
+    SolveReport& diagnostics = report ? *report : local;
+    FixedCoefficients<LayerCount> x;
+    if (TrySolveCoefficientsFixed<LayerCount>(m, plan, x, &diagnostics, options) != SolveStatus::Ok) {
+        ThrowSolveFailure(diagnostics, m);
+    }
+    WarnIfIllConditioned(diagnostics.reciprocalCondition, m);
+    return x;
 }
 
-void MatrixOperations::AssembleUnbondedInterface(
-    Eigen::MatrixXd& M,
-    int row,
-    int layerIndex,
+template <int LayerCount>
+SolveStatus MatrixOperations::TrySolveCoefficientsFixed(
     double m,
-    const CalculationInput& input,
-    const std::vector<double>& depths) 
+    const AssemblyPlan& plan,
+    FixedCoefficients<LayerCount>& x,
+    SolveReport* report,
+    const SolveOptions& options)
 {
-    // Unbonded interface boundary conditions (slip interface):
-    // 1. Continuity of vertical displacement: w_upper(h) = w_lower(h)
-    // 2. Continuity of vertical stress: σ_z_upper(h) = σ_z_lower(h)
-    // 3. Zero shear stress in upper layer: τ_rz_upper(h) = 0
-    // 4. Zero shear stress in lower layer: τ_rz_lower(h) = 0
-    // NOTE: Radial displacement u is discontinuous at unbonded interface
-    
-    const double h = depths[layerIndex + 1];
-    const double E1 = input.youngModuli[layerIndex];
-    const double nu1 = input.poissonRatios[layerIndex];
-    const double E2 = input.youngModuli[layerIndex + 1];
-    const double nu2 = input.poissonRatios[layerIndex + 1];
-    const int col = layerIndex * 4;
-    
-    // Check if lower layer is platform (semi-infinite foundation)
-    // Platform has only 2 coefficients (A, B) starting at column 4*(layerCount-1)
-    // For 4 layers: layers 0,1,2 have 4 coeffs each (0-11), platform has 2 (12-13)
-    const bool isPlatformInterface = (layerIndex == input.layerCount - 2);
-    const int platformCol = isPlatformInterface ? (4 * (input.layerCount - 1)) : 0;
-    
-    LOG_INFO("Unbonded interface: layerIndex=" + std::to_string(layerIndex) +
-             ", row=" + std::to_string(row) +
-             ", col=" + std::to_string(col) +
-             ", isPlatform=" + std::to_string(isPlatformInterface) +
-             ", platformCol=" + std::to_string(platformCol));
-    
-    // Check if we have room for the next layer's FULL coefficient set (4 coefficients)
-    const int maxCol = M.cols() - 1;
-    const bool hasNextLayerCoeffs = !isPlatformInterface && ((col + 7) <= maxCol);
-    
-    // SOLUTION 3: Stabilisation académique des exponentielles (UNIFORMISÉE avec AssembleBondedInterface)
-    // "formulation contain only non-positive exponents, which are critical for numerical stability"
-    const double mh = m * h;
-    
-    // Technique de stabilisation CRITIQUE: Pour m*h > 30, exp(m*h) déborde
-    // On reformule en utilisant UNIQUEMENT les termes décroissants
-    // Principe: Si exp(mh) est énorme, les termes en exp(-mh) dominent de toute façon
-    double exp_neg_mh, exp_pos_mh;
-    
-    if (mh > 30.0) {
-        // Pour grand mh: exp(mh) >> exp(-mh), donc termes positifs négligeables
-        // On met exp_pos_mh = 0 et on garde seulement exp_neg_mh
-        exp_neg_mh = std::exp(-mh);
-        exp_pos_mh = 0.0;  // Négligeable comparé à exp(mh) qui déborderait
-    } else {
-        // Pour petit/moyen mh: calcul normal
-        exp_neg_mh = std::exp(-mh);
-        exp_pos_mh = std::exp(mh);
+    constexpr int k = 4 * LayerCount - 2;
+    using Matrix = FixedSystemMatrix<LayerCount>;
+    using Vector = FixedCoefficients<LayerCount>;
+    
+    SolveReport local;
+    SolveReport& diagnostics = report ? *report : local;
+    diagnostics = SolveReport();
+    if (plan.LayerCount() != LayerCount) {
+        diagnostics.status = SolveStatus::InvalidInput;
+        return diagnostics.status;
     }
-
     
-    if (isPlatformInterface) {
-        LOG_INFO("Platform interface: m=" + std::to_string(m) + ", h=" + std::to_string(h) +
-                 ", exp_neg_mh=" + std::to_string(exp_neg_mh) +
-                 ", exp_pos_mh=" + std::to_string(exp_pos_mh));
-    }
-    
-    // Equation 1: Continuity of vertical displacement w_upper(h) = w_lower(h)
-    // w = (A + Bz)e^(-mz) + (C + Dz)e^(mz)
-    // Upper layer (layer i): w_i(h) = (A_i + B_i*h)exp(-m*h) + (C_i + D_i*h)exp(m*h)
-    M(row, col) = exp_neg_mh;                    // A_i coefficient
-    M(row, col + 1) = h * exp_neg_mh;            // B_i coefficient
-    M(row, col + 2) = exp_pos_mh;                // C_i coefficient
-    M(row, col + 3) = h * exp_pos_mh;            // D_i coefficient
-    
-    if (isPlatformInterface) {
-        // Platform layer: Only A and B coefficients (decreasing exponential only)
-        // w_platform(h) = (A_platform + B_platform*h)exp(-m*h)
-        LOG_INFO("Writing platform equation 1: M(" + std::to_string(row) + "," + std::to_string(platformCol) + ") = " + std::to_string(-exp_neg_mh));
-        M(row, platformCol) = -exp_neg_mh;       // A_platform coefficient
-        M(row, platformCol + 1) = -h * exp_neg_mh; // B_platform coefficient
-        LOG_INFO("After write: M(" + std::to_string(row) + "," + std::to_string(platformCol) + ") = " + std::to_string(M(row, platformCol)));
-    } else if (hasNextLayerCoeffs) {
-        // Normal layer: All 4 coefficients
-        M(row, col + 4) = -exp_neg_mh;               // A_{i+1} coefficient
-        M(row, col + 5) = -h * exp_neg_mh;           // B_{i+1} coefficient
-        M(row, col + 6) = -exp_pos_mh;               // C_{i+1} coefficient
-        M(row, col + 7) = -h * exp_pos_mh;           // D_{i+1} coefficient
-    }
-    
-    // Equation 2: Continuity of vertical stress σ_z_upper(h) = σ_z_lower(h)
-    // σ_z = -E * ∂w/∂z (simplified vertical stress)
-    // ∂w/∂z = [-m*A + B - m*B*z]e^(-mz) + [m*C + D + m*D*z]e^(mz)
-    
-    // Upper layer vertical stress coefficients
-    M(row + 1, col) = -E1 * (-m * exp_neg_mh);                    // A_i: -E1*(-m)e^(-mh)
-    M(row + 1, col + 1) = -E1 * (exp_neg_mh - m * h * exp_neg_mh); // B_i: -E1*(1 - m*h)e^(-mh)
-    M(row + 1, col + 2) = -E1 * (m * exp_pos_mh);                  // C_i: -E1*m*e^(mh)
-    M(row + 1, col + 3) = -E1 * (exp_pos_mh + m * h * exp_pos_mh); // D_i: -E1*(1 + m*h)e^(mh)
-    
-    if (isPlatformInterface) {
-        // Platform stress: Only decreasing exponential terms
-        // ∂w_platform/∂z = [-m*A_platform + B_platform - m*B_platform*h]e^(-mh)
-        M(row + 1, platformCol) = E2 * (-m * exp_neg_mh);                    // A_platform
-        M(row + 1, platformCol + 1) = E2 * (exp_neg_mh - m * h * exp_neg_mh); // B_platform
-    } else if (hasNextLayerCoeffs) {
-        // Normal layer: All stress terms
-        M(row + 1, col + 4) = E2 * (-m * exp_neg_mh);                    // A_{i+1}
-        M(row + 1, col + 5) = E2 * (exp_neg_mh - m * h * exp_neg_mh);   // B_{i+1}
-        M(row + 1, col + 6) = E2 * (m * exp_pos_mh);                     // C_{i+1}
-        M(row + 1, col + 7) = E2 * (exp_pos_mh + m * h * exp_pos_mh);   // D_{i+1}
-    }
-    
-    // Equation 3: Zero shear stress in upper layer τ_rz_upper(h) = 0
-    // τ_rz = G * (∂u/∂z - ∂w/∂r) ≈ G * [∂u/∂z - m*w] (simplified)
-    // At unbonded interface, shear must vanish in upper layer
-    
-    const double G1 = E1 / (2.0 * (1.0 + nu1));
-    
-    // Shear stress upper layer: G1 * [derivative terms]
-    M(row + 2, col) = G1 * exp_neg_mh;           // A_i coefficient
-    M(row + 2, col + 1) = G1 * h * exp_neg_mh;   // B_i coefficient
-    M(row + 2, col + 2) = -G1 * exp_pos_mh;      // C_i coefficient (sign change for positive exponential)
-    M(row + 2, col + 3) = -G1 * h * exp_pos_mh;  // D_i coefficient
-    
-    // Equation 4: Zero shear stress in lower layer τ_rz_lower(h) = 0
-    const double G2 = E2 / (2.0 * (1.0 + nu2));
-    
-    if (isPlatformInterface) {
-        // Platform shear stress: Only A and B coefficients
-        M(row + 3, platformCol) = G2 * exp_neg_mh;       // A_platform coefficient
-        M(row + 3, platformCol + 1) = G2 * h * exp_neg_mh; // B_platform coefficient
-    } else if (hasNextLayerCoeffs) {
-        // Normal layer: All shear terms
-        M(row + 3, col + 4) = G2 * exp_neg_mh;       // A_{i+1} coefficient
-        M(row + 3, col + 5) = G2 * h * exp_neg_mh;   // B_{i+1} coefficient
-        M(row + 3, col + 6) = -G2 * exp_pos_mh;      // C_{i+1} coefficient
-        M(row + 3, col + 7) = -G2 * h * exp_pos_mh;  // D_{i+1} coefficient
+    Matrix M = Matrix::Zero();
+    plan.Fill(m, M);
+    
+    Vector b = Vector::Zero();
+    b(1) = -plan.Pressure();  // Applied normal stress (negative for compression)
+    
+    // Same row/column equilibration as the banded path
+    Vector rowScales = Vector::Ones();
+    Vector colScales = Vector::Ones();
+    for (int i = 0; i < k; ++i) {
+        double maxRowVal = M.row(i).cwiseAbs().maxCoeff();
+        if (maxRowVal > 1e-15) {
+            rowScales(i) = 1.0 / maxRowVal;
+        }
+    }
+    for (int j = 0; j < k; ++j) {
+        double maxColVal = M.col(j).cwiseAbs().maxCoeff();
+        if (maxColVal > 1e-15) {
+            colScales(j) = 1.0 / maxColVal;
+        }
+    }
+    const Matrix M_scaled = rowScales.asDiagonal() * M * colScales.asDiagonal();
+    
+    const Eigen::PartialPivLU<Matrix> lu(M_scaled);
+    if (!(lu.matrixLU().diagonal().cwiseAbs().minCoeff() > 0.0)) {
+        diagnostics.status = SolveStatus::Singular;
+        return diagnostics.status;
+    }
+    
+    // Hager/Higham 1-norm estimate reusing the LU factors
+    diagnostics.reciprocalCondition = lu.rcond();
+    
+    x = lu.solve(b.cwiseProduct(rowScales)).cwiseProduct(colScales);
+    
+    // (negated tests so a NaN residual is rejected too)
+    double residual = (M * x - b).norm();
+    const int refinementSteps = RefineSolution(
+        x, residual, options.maxRefinementSteps,
+        [&](const Vector& r) { return Vector(lu.solve(r.cwiseProduct(rowScales)).cwiseProduct(colScales)); },
+        [&](const Vector& candidate) { return ExtendedResidual(M, candidate, b); });
+    diagnostics.residual = residual;
+    diagnostics.refinementSteps = refinementSteps;
+    if (!(residual <= Constants::RESIDUAL_TOLERANCE)) {
+        diagnostics.status = SolveStatus::ResidualTooLarge;
+        return diagnostics.status;
+    }
+    
+    if (options.exactConditionNumber) {
+        diagnostics.exactConditionNumber = CheckConditionNumber(Eigen::MatrixXd(M_scaled));
     }
+    return SolveStatus::Ok;
 }
 
-void MatrixOperations::AssembleSurfaceBoundary(
-    Eigen::MatrixXd& M,
-    double m,
-    const CalculationInput& input) 
+const char* MatrixOperations::StatusMessage(SolveStatus status) noexcept
 {
-    // Surface boundary conditions at z = 0 (pavement surface):
-    // Row 0: Zero shear stress at free surface: τ_rz(z=0) = 0
-    // Row 1: Applied normal stress at surface: σ_z(z=0) = -P (pressure)
-    
-    // For the first layer (layer 0), at surface z = 0:
-    // Displacement field: w = (A_1 + B_1*z)e^(-m*z) + (C_1 + D_1*z)e^(m*z)
-    //                     u = (radial displacement expression)
-    
-    // At z = 0: e^(-m*0) = 1, e^(m*0) = 1, z = 0
-    
-    // Equation 1: Zero shear stress at surface τ_rz(0) = 0
-    // τ_rz = G * (∂u/∂z - ∂w/∂r)
-    // For axisymmetric case with Hankel transform approach:
-    // The shear stress boundary condition simplifies to a relationship
-    // between the coefficients A_1 and C_1
-    // Typical form: A_1 - C_1 = 0  OR  τ_rz ~ (A_1 - C_1) terms
-    
-    M(0, 0) = 1.0;   // A_1 coefficient (positive contribution)
-    M(0, 1) = 0.0;   // B_1 coefficient (zero at z=0)
-    M(0, 2) = -1.0;  // C_1 coefficient (negative for zero shear)
-    M(0, 3) = 0.0;   // D_1 coefficient (zero at z=0)
-    
-    // Equation 2: Applied normal stress at surface σ_z(0) = -P
-    // σ_z = -E/(1-ν²) * [(1-ν)∂w/∂z + ν*m*u]
-    // Simplified for surface: σ_z ≈ -E * ∂w/∂z
-    // ∂w/∂z|_{z=0} = -m*A_1 + B_1 + m*C_1 + D_1
-    // Setting σ_z(0) = -P gives: -E_1*(-m*A_1 + B_1 + m*C_1 + D_1) = -P
-    // Simplifying: E_1*(m*A_1 - B_1 - m*C_1 - D_1) = P
-    
-    const double E1 = input.youngModuli[0];
-    // Parameter 'm' now properly passed from Hankel integration loop
-    // Surface boundary equations now use correct varying 'm' value instead of hardcoded 1.0
-    
-    // Surface stress boundary condition form:
-    // E1*m*A_1 - E1*B_1 - E1*m*C_1 - E1*D_1 = P
-    
-    // Now using correct varying 'm' parameter instead of simplified form:
-    M(1, 0) = E1 * m;    // A_1 coefficient: E1*m*A_1 term
-    M(1, 1) = -E1;       // B_1 coefficient: -E1*B_1 term (derivative)
-    M(1, 2) = -E1 * m;   // C_1 coefficient: -E1*m*C_1 term
-    M(1, 3) = -E1;       // D_1 coefficient: -E1*D_1 term (derivative)
-    
-    // Note: The right-hand side vector b will contain:
-    // b(0) = 0.0 (zero shear stress)
-    // b(1) = -input.pressure (applied normal stress)
+    switch (status) {
+        case SolveStatus::Ok: return "solved";
+        case SolveStatus::Singular: return "singular system";
+        case SolveStatus::ResidualTooLarge: return "residual above tolerance after refinement";
+        case SolveStatus::NumericallySingular: return "numerically singular system";
+        case SolveStatus::InvalidInput: return "layer count does not match the solver";
+    }
+    return "unknown status";
+}
+
+void MatrixOperations::ThrowSolveFailure(const SolveReport& report, double m)
+{
+    std::string error = report.status == SolveStatus::ResidualTooLarge
+        ? ResidualError(report.residual, report.refinementSteps)
+        : "Matrix solution failed: " + std::string(StatusMessage(report.status)) +
+          " at m = " + std::to_string(m);
+    LOG_ERROR(error);
+    throw std::runtime_error(error);
+}
+
+void MatrixOperations::WarnIfIllConditioned(double reciprocalCondition, double m) 
+{
+    if (reciprocalCondition * Constants::CONDITION_NUMBER_WARNING_THRESHOLD < 1.0) {
+        LOG_WARNING("High condition number estimate " + std::to_string(1.0 / reciprocalCondition) + 
+                   " at m=" + std::to_string(m) + " - results may be inaccurate");
+    }
 }
 
 double MatrixOperations::CheckConditionNumber(const Eigen::MatrixXd& M) 
 {
-    // Estimate condition number using SVD (expensive but accurate)
-    Eigen::JacobiSVD<Eigen::MatrixXd> svd(M, Eigen::ComputeThinU | Eigen::ComputeThinV);
+    // Exact condition number from the singular values (expensive; diagnostic
+    // only). The systems are square, so the QR preconditioner is not needed.
+    Eigen::JacobiSVD<Eigen::MatrixXd, Eigen::NoQRPreconditioner> svd(M);
     auto singularValues = svd.singularValues();
     
     double maxSV = singularValues.maxCoeff();
@@ -546,4 +477,26 @@ double MatrixOperations::CheckConditionNumber(const Eigen::MatrixXd& M)
     return maxSV / minSV;
 }
 
+// Fixed-size solvers for the common layer counts
+template MatrixOperations::FixedCoefficients<2> MatrixOperations::SolveCoefficientsFixed<2>(
+    double, const AssemblyPlan&, SolveReport*, const SolveOptions&);
+template SolveStatus MatrixOperations::TrySolveCoefficientsFixed<2>(
+    double, const AssemblyPlan&, FixedCoefficients<2>&, SolveReport*, const SolveOptions&);
+template MatrixOperations::FixedCoefficients<3> MatrixOperations::SolveCoefficientsFixed<3>(
+    double, const AssemblyPlan&, SolveReport*, const SolveOptions&);
+template SolveStatus MatrixOperations::TrySolveCoefficientsFixed<3>(
+    double, const AssemblyPlan&, FixedCoefficients<3>&, SolveReport*, const SolveOptions&);
+template MatrixOperations::FixedCoefficients<4> MatrixOperations::SolveCoefficientsFixed<4>(
+    double, const AssemblyPlan&, SolveReport*, const SolveOptions&);
+template SolveStatus MatrixOperations::TrySolveCoefficientsFixed<4>(
+    double, const AssemblyPlan&, FixedCoefficients<4>&, SolveReport*, const SolveOptions&);
+template MatrixOperations::FixedCoefficients<5> MatrixOperations::SolveCoefficientsFixed<5>(
+    double, const AssemblyPlan&, SolveReport*, const SolveOptions&);
+template SolveStatus MatrixOperations::TrySolveCoefficientsFixed<5>(
+    double, const AssemblyPlan&, FixedCoefficients<5>&, SolveReport*, const SolveOptions&);
+template MatrixOperations::FixedCoefficients<6> MatrixOperations::SolveCoefficientsFixed<6>(
+    double, const AssemblyPlan&, SolveReport*, const SolveOptions&);
+template SolveStatus MatrixOperations::TrySolveCoefficientsFixed<6>(
+    double, const AssemblyPlan&, FixedCoefficients<6>&, SolveReport*, const SolveOptions&);
+
 } // namespace Pavement
@@ -16,15 +16,21 @@
 #include "PavementAPI.h"
 #include "PavementData.h"
 #include "PavementCalculator.h"
+#include "CalculationEngine.h"
 #include "TRMMSolver.h"
 #include "PyMasticSolver.h"
 #include "PyMasticPythonBridge.h"
 #include "Logger.h"
 #include <cstring>
 #include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
 #include <string>
+#include <vector>
 #include <chrono>
-#include <fstream>
 #include <iostream>
 
 // Alias for convenience
@@ -50,17 +56,21 @@ static void SetLastError(const char* message) {
 }
 
 /**
- * @brief Convert C input structure to C++ CalculationInput
+ * @brief Convert C input structure to C++ CalculationInput (no logging)
  */
-static bool ConvertInputToCpp(const PavementInputC* input, PavementData& data) {
+static bool ConvertInputData(const PavementInputC* input, PavementData& data) {
     if (!input) {
         SetLastError("Input pointer is NULL");
         return false;
     }
     
     // Basic validation
-    if (input->nlayer < 1 || input->nlayer > 20) {
-        SetLastError("Number of layers must be between 1 and 20");
+    if (input->nlayer < Pavement::Constants::MIN_LAYER_COUNT ||
+        input->nlayer > Pavement::Constants::MAX_LAYER_COUNT) {
+        const std::string message = "Number of layers must be between " +
+            std::to_string(Pavement::Constants::MIN_LAYER_COUNT) + " and " +
+            std::to_string(Pavement::Constants::MAX_LAYER_COUNT);
+        SetLastError(message.c_str());
         return false;
     }
     
@@ -91,8 +101,10 @@ static bool ConvertInputToCpp(const PavementInputC* input, PavementData& data) {
     data.youngModuli.assign(input->young_modulus, input->young_modulus + input->nlayer);
     data.thicknesses.assign(input->thickness, input->thickness + input->nlayer);
     
-    if (input->nlayer > 1) {
-        data.interfaceTypes.assign(input->bonded_interface, input->bonded_interface + (input->nlayer - 1));
+    // C API: 1=bonded, 0=unbonded; C++: 0=bonded, 2=unbonded
+    data.interfaceTypes.clear();
+    for (int i = 0; i + 1 < input->nlayer; ++i) {
+        data.interfaceTypes.push_back(input->bonded_interface[i] ? 0 : 2);
     }
     
     data.wheelType = input->wheel_type + 1;  // C API: 0=simple, 1=twin; C++: 1=isolated, 2=twin
@@ -100,40 +112,28 @@ static bool ConvertInputToCpp(const PavementInputC* input, PavementData& data) {
     data.contactRadius = input->wheel_radius_m;
     data.wheelSpacing = input->wheel_spacing_m;
     
-    // Debug print to both console and file
-    std::ofstream debugFile("C:\\Temp\\PavementDebug.txt", std::ios::app);
-    
-    auto logToAll = [&](const std::string& msg) {
-        std::cout << msg << std::endl;
-        if (debugFile.is_open()) {
-            debugFile << msg << std::endl;
-        }
-    };
-    
-    logToAll("=== API INPUT DEBUG ===");
-    logToAll("  Layer count: " + std::to_string(data.layerCount));
-    logToAll("  Pressure: " + std::to_string(input->pressure_kpa) + " kPa = " + std::to_string(data.pressure) + " MPa");
-    logToAll("  Contact radius: " + std::to_string(data.contactRadius) + " m");
-    
-    std::string moduliStr = "  Young's moduli: [";
-    for (int i = 0; i < data.layerCount; ++i) {
-        moduliStr += std::to_string(data.youngModuli[i]);
-        if (i < data.layerCount - 1) moduliStr += ", ";
+    return true;
+}
+
+/**
+ * @brief Convert C input structure to C++ CalculationInput and log it at DEBUG level
+ */
+static bool ConvertInputToCpp(const PavementInputC* input, PavementData& data) {
+    if (!ConvertInputData(input, data)) {
+        return false;
     }
-    moduliStr += "] MPa";
-    logToAll(moduliStr);
     
-    std::string poissonStr = "  Poisson ratios: [";
+    std::string moduliStr = "[";
+    std::string poissonStr = "[";
     for (int i = 0; i < data.layerCount; ++i) {
-        poissonStr += std::to_string(data.poissonRatios[i]);
-        if (i < data.layerCount - 1) poissonStr += ", ";
-    }
-    poissonStr += "]";
-    logToAll(poissonStr);
-    
-    if (debugFile.is_open()) {
-        debugFile.close();
+        const char* separator = i < data.layerCount - 1 ? ", " : "";
+        moduliStr += std::to_string(data.youngModuli[i]) + separator;
+        poissonStr += std::to_string(data.poissonRatios[i]) + separator;
     }
+    LOG_DEBUG("API input: " + std::to_string(data.layerCount) + " layers, pressure " +
+              std::to_string(input->pressure_kpa) + " kPa = " + std::to_string(data.pressure) +
+              " MPa, contact radius " + std::to_string(data.contactRadius) + " m, Young's moduli " +
+              moduliStr + "] MPa, Poisson ratios " + poissonStr + "]");
     
     return true;
 }
@@ -178,212 +178,479 @@ static bool AllocateOutputArrays(PavementOutputC* output, const PavementOutput&
     return true;
 }
 
+/**
+ * @brief Reject results whose Hankel integral is missing points
+ * 
+ * A Hankel parameter whose system could not be solved is integrated as
+ * zero, so the results would be silently incomplete.
+ * 
+ * @return PAVEMENT_SUCCESS, or PAVEMENT_ERROR_CALCULATION with the message in g_last_error
+ */
+static int CheckIntegration(const PavementOutput& results) {
+    if (results.integration.failedEvaluations > 0) {
+        const std::string message = "Calculation failed: " +
+            std::to_string(results.integration.failedEvaluations) +
+            " Hankel integration point(s) could not be solved";
+        SetLastError(message.c_str());
+        return PAVEMENT_ERROR_CALCULATION;
+    }
+    return PAVEMENT_SUCCESS;
+}
+
+/**
+ * @brief Message of a successful calculation, noting an integral that stopped short of its tolerance
+ */
+static std::string CompletionMessage(const std::string& calculation, const PavementOutput& results) {
+    if (!results.integration.converged) {
+        return calculation + " completed; integration tolerance not met (error estimate " +
+               std::to_string(results.integration.errorEstimate) + ")";
+    }
+    return calculation + " completed successfully";
+}
+
 // ============================================================================
-// Public API Implementation
+// Engine Handle
 // ============================================================================
 
-extern "C" {
+/**
+ * @brief Object behind the opaque PavementEngine handle
+ */
+struct PavementEngine {
+    std::unique_ptr<Pavement::CalculationEngine> engine;
+};
 
-PAVEMENT_API int PavementCalculate(
-    const PavementInputC* input,
-    PavementOutputC* output
-) {
-    // Clear previous error
-    g_last_error[0] = '\0';
-    
-    // Validate pointers
-    if (!input) {
-        SetLastError("Input pointer is NULL");
-        if (output) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_NULL_POINTER;
-            strncpy(output->error_message, "Input pointer is NULL", sizeof(output->error_message) - 1);
-        }
-        return PAVEMENT_ERROR_NULL_POINTER;
+/**
+ * @brief Record a failed calculation in the output structure and the thread-local error
+ */
+static int FailCalculation(PavementOutputC* output, int error_code, const std::string& message) {
+    output->success = 0;
+    output->error_code = error_code;
+    strncpy(output->error_message, message.c_str(), sizeof(output->error_message) - 1);
+    SetLastError(message.c_str());
+    return error_code;
+}
+
+/**
+ * @brief Calculate one converted structure on an engine at depths.size() points
+ * 
+ * @return PAVEMENT_SUCCESS, or an error code with the message in g_last_error
+ * @throws std::bad_alloc if storage could not be allocated
+ */
+static int SolveOnEngine(Pavement::CalculationEngine& engine,
+                         const PavementData& inputData,
+                         const std::vector<double>& depths,
+                         PavementOutput& results) {
+    try {
+        engine.Calculate(inputData, depths, results);
+    } catch (const std::invalid_argument& e) {
+        SetLastError(e.what());
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    } catch (const std::bad_alloc&) {
+        throw;
+    } catch (const std::exception& e) {
+        std::string error_msg = std::string("Calculation failed: ") + e.what();
+        SetLastError(error_msg.c_str());
+        return PAVEMENT_ERROR_CALCULATION;
     }
     
-    if (!output) {
-        SetLastError("Output pointer is NULL");
-        return PAVEMENT_ERROR_NULL_POINTER;
+    if (results.deflection.size() < depths.size()) {
+        SetLastError("nz exceeds the 2*nlayer-1 interface results of the standard solver");
+        return PAVEMENT_ERROR_INVALID_INPUT;
     }
-    
-    // Initialize output structure
-    memset(output, 0, sizeof(PavementOutputC));
-    
+    return CheckIntegration(results);
+}
+
+/**
+ * @brief Convert one structure and calculate it on an engine
+ * 
+ * inputData, depths and results are overwritten in place, so buffers kept
+ * by the caller are reused from call to call.
+ * 
+ * @return PAVEMENT_SUCCESS, or an error code with the message in g_last_error
+ * @throws std::bad_alloc if storage could not be allocated
+ */
+static int CalculateOnEngine(Pavement::CalculationEngine& engine,
+                             const PavementInputC* input,
+                             PavementData& inputData,
+                             std::vector<double>& depths,
+                             PavementOutput& results) {
+    if (!ConvertInputData(input, inputData)) {
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    depths.assign(input->z_coords, input->z_coords + input->nz);
+    return SolveOnEngine(engine, inputData, depths, results);
+}
+
+/**
+ * @brief Calculate one converted structure on an engine into a zeroed output structure
+ * 
+ * Per-call work is limited to the output arrays: no console dump, no INFO
+ * logging, no solver construction.
+ * 
+ * @param evaluations Receives the Hankel integrand evaluations (can be NULL)
+ */
+static int RunConvertedCalculation(Pavement::CalculationEngine& engine,
+                                   const PavementData& inputData,
+                                   const std::vector<double>& depths,
+                                   PavementOutputC* output,
+                                   long long* evaluations) {
     try {
-        // Start timing
         auto start_time = std::chrono::high_resolution_clock::now();
         
-        // Convert input
-        PavementData inputData;
-        if (!ConvertInputToCpp(input, inputData)) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_INVALID_INPUT;
-            strncpy(output->error_message, g_last_error, sizeof(output->error_message) - 1);
-            std::string error_msg = std::string("Input conversion failed: ") + g_last_error;
-            Pavement::Logger::GetInstance().Error(error_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_ERROR_INVALID_INPUT;
-        }
-        
-        // Validate input
-        try {
-            inputData.Validate();
-        } catch (const std::exception& e) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_INVALID_INPUT;
-            strncpy(output->error_message, e.what(), sizeof(output->error_message) - 1);
-            SetLastError(e.what());
-            std::string error_msg = std::string("Input validation failed: ") + e.what();
-            Pavement::Logger::GetInstance().Error(error_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_ERROR_INVALID_INPUT;
-        }
-        
-        // Perform calculation
-        std::string calc_start_msg = "Starting pavement calculation via C API for " + std::to_string(inputData.layerCount) + " layers";
-        Pavement::Logger::GetInstance().Info(calc_start_msg.c_str(), __FILE__, __LINE__);
-        
-        PavementCalc calculator;
         PavementOutput outputData;
-        
-        try {
-            outputData = calculator.Calculate(inputData);
-        } catch (const std::exception& e) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_CALCULATION;
-            std::string error_msg = std::string("Calculation failed: ") + e.what();
-            strncpy(output->error_message, error_msg.c_str(), sizeof(output->error_message) - 1);
-            SetLastError(error_msg.c_str());
-            Pavement::Logger::GetInstance().Error(error_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_ERROR_CALCULATION;
+        const int result = SolveOnEngine(engine, inputData, depths, outputData);
+        if (result != PAVEMENT_SUCCESS) {
+            return FailCalculation(output, result, g_last_error);
+        }
+        if (evaluations) {
+            *evaluations = outputData.integration.evaluations;
         }
         
-        // Allocate and populate output arrays
-        if (!AllocateOutputArrays(output, outputData, input->nz)) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_ALLOCATION;
-            strncpy(output->error_message, g_last_error, sizeof(output->error_message) - 1);
-            std::string error_msg = std::string("Output allocation failed: ") + g_last_error;
-            Pavement::Logger::GetInstance().Error(error_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_ERROR_ALLOCATION;
+        const int nz = static_cast<int>(depths.size());
+        if (!AllocateOutputArrays(output, outputData, nz)) {
+            return FailCalculation(output, PAVEMENT_ERROR_ALLOCATION, g_last_error);
         }
         
-        // Calculate elapsed time
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
         output->calculation_time_ms = duration.count() / 1000.0;
         
-        // Success
         output->success = 1;
         output->error_code = PAVEMENT_SUCCESS;
-        strncpy(output->error_message, "Calculation completed successfully", 
+        strncpy(output->error_message, CompletionMessage("Calculation", outputData).c_str(),
                 sizeof(output->error_message) - 1);
-        
-        std::string success_msg = "Calculation completed successfully in " + std::to_string(output->calculation_time_ms) + " ms";
-        Pavement::Logger::GetInstance().Info(success_msg.c_str(), __FILE__, __LINE__);
-        
         return PAVEMENT_SUCCESS;
         
-    } catch (const std::bad_alloc& e) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_ALLOCATION;
-        strncpy(output->error_message, "Memory allocation failed", sizeof(output->error_message) - 1);
-        SetLastError("Memory allocation failed");
-        std::string error_msg = std::string("Bad alloc exception in PavementCalculate: ") + e.what();
-        Pavement::Logger::GetInstance().Critical(error_msg.c_str(), __FILE__, __LINE__);
-        return PAVEMENT_ERROR_ALLOCATION;
+    } catch (const std::bad_alloc&) {
+        PavementFreeOutput(output);
+        return FailCalculation(output, PAVEMENT_ERROR_ALLOCATION, "Memory allocation failed");
         
     } catch (const std::exception& e) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_UNKNOWN;
-        std::string error_msg = std::string("Exception: ") + e.what();
-        strncpy(output->error_message, error_msg.c_str(), sizeof(output->error_message) - 1);
-        SetLastError(error_msg.c_str());
-        std::string critical_msg = std::string("Exception in PavementCalculate: ") + e.what();
-        Pavement::Logger::GetInstance().Critical(critical_msg.c_str(), __FILE__, __LINE__);
-        return PAVEMENT_ERROR_UNKNOWN;
+        PavementFreeOutput(output);
+        return FailCalculation(output, PAVEMENT_ERROR_UNKNOWN, std::string("Exception: ") + e.what());
         
     } catch (...) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_UNKNOWN;
-        strncpy(output->error_message, "Unknown exception occurred", sizeof(output->error_message) - 1);
-        SetLastError("Unknown exception");
-        LOG_CRITICAL("Unknown exception in PavementCalculate");
-        return PAVEMENT_ERROR_UNKNOWN;
+        PavementFreeOutput(output);
+        return FailCalculation(output, PAVEMENT_ERROR_UNKNOWN, "Unknown exception occurred");
     }
 }
 
-PAVEMENT_API int PavementCalculateStable(
-    const PavementInputC* input,
-    PavementOutputC* output
-) {
-    g_last_error[0] = '\0';
+/**
+ * @brief Calculate one structure on an engine into a zeroed output structure
+ */
+static int RunEngineCalculation(Pavement::CalculationEngine& engine,
+                                const PavementInputC* input,
+                                PavementOutputC* output) {
+    try {
+        PavementData inputData;
+        if (!ConvertInputData(input, inputData)) {
+            return FailCalculation(output, PAVEMENT_ERROR_INVALID_INPUT, g_last_error);
+        }
+        const std::vector<double> depths(input->z_coords, input->z_coords + input->nz);
+        return RunConvertedCalculation(engine, inputData, depths, output, nullptr);
+        
+    } catch (const std::bad_alloc&) {
+        return FailCalculation(output, PAVEMENT_ERROR_ALLOCATION, "Memory allocation failed");
+    }
+}
+
+/**
+ * @brief Background job of PavementSubmitBatch: converted inputs, outputs and callbacks
+ * 
+ * Inputs are copied at submission, so the caller's arrays may be released
+ * as soon as PavementSubmitBatch returns.
+ */
+struct AsyncJob {
+    PavementJobId id = 0;
+    std::vector<PavementData> inputs;
+    std::vector<std::vector<double>> depths;
+    std::vector<int> conversionErrors;       ///< PAVEMENT_SUCCESS, or why the input could not be converted
+    std::vector<std::string> conversionMessages;
+    std::vector<PavementOutputC> outputs;
     
-    if (!input) {
-        SetLastError("Input pointer is NULL");
-        if (output) {
-            output->success = 0;
-            output->error_code = PAVEMENT_ERROR_NULL_POINTER;
-            strncpy(output->error_message, "Input pointer is NULL", sizeof(output->error_message) - 1);
+    PavementCompletionCallback on_complete = nullptr;
+    PavementProgressCallback on_progress = nullptr;
+    void* user_data = nullptr;
+    
+    std::mutex progressMutex;                ///< Serialises progress callbacks
+    PavementProgressC progress = {0, 0, 0};
+};
+
+/**
+ * @brief Calculate structure i of a job and report progress
+ */
+static void RunJobStructure(Pavement::CalculationEngine& engine, AsyncJob& job, int i) {
+    PavementOutputC* output = &job.outputs[i];
+    long long evaluations = 0;
+    if (job.conversionErrors[i] != PAVEMENT_SUCCESS) {
+        FailCalculation(output, job.conversionErrors[i], job.conversionMessages[i]);
+    } else {
+        RunConvertedCalculation(engine, job.inputs[i], job.depths[i], output, &evaluations);
+    }
+    
+    std::lock_guard<std::mutex> lock(job.progressMutex);
+    ++job.progress.completed_structures;
+    job.progress.integration_points += evaluations;
+    if (job.on_progress) {
+        job.on_progress(job.id, &job.progress, job.user_data);
+    }
+}
+
+/**
+ * @brief Hand the outputs of a finished job to its completion callback, then free them
+ */
+static void CompleteJob(AsyncJob& job, bool cancelled) {
+    int status = cancelled ? PAVEMENT_ERROR_CANCELLED : PAVEMENT_SUCCESS;
+    for (const PavementOutputC& output : job.outputs) {
+        if (status != PAVEMENT_SUCCESS) {
+            break;
         }
-        return PAVEMENT_ERROR_NULL_POINTER;
+        status = output.error_code;
     }
     
+    PavementJobId id;
+    {
+        // An empty job can finish before PavementSubmitBatch has stored its id
+        std::lock_guard<std::mutex> lock(job.progressMutex);
+        id = job.id;
+    }
+    if (job.on_complete) {
+        job.on_complete(id, status, job.outputs.data(), static_cast<int>(job.outputs.size()), job.user_data);
+    }
+    for (PavementOutputC& output : job.outputs) {
+        PavementFreeOutput(&output);
+    }
+}
+
+/**
+ * @brief Per-thread conversion buffers of PavementCalculateInto, reused between calls
+ */
+struct CalculationScratch {
+    PavementData input;
+    std::vector<double> depths;
+    PavementOutput results;
+};
+
+static CalculationScratch& ThreadScratch() {
+    thread_local CalculationScratch scratch;
+    return scratch;
+}
+
+/**
+ * @brief Check that every quantity of a result buffer fits nz points
+ */
+static bool CheckResultBuffer(const PavementResultBufferC* buffer, int nz) {
+    if (!buffer->block) {
+        SetLastError("Result block cannot be NULL");
+        return false;
+    }
+    if (buffer->point_stride < 1) {
+        SetLastError("Point stride must be at least 1");
+        return false;
+    }
+    
+    const int offsets[] = {buffer->deflection_offset, buffer->vertical_stress_offset,
+                           buffer->horizontal_strain_offset, buffer->radial_strain_offset,
+                           buffer->shear_stress_offset};
+    const long long span = static_cast<long long>(nz - 1) * buffer->point_stride;
+    for (int offset : offsets) {
+        if (offset < -1) {
+            SetLastError("Quantity offsets must be >= 0, or -1 to skip the quantity");
+            return false;
+        }
+        if (offset >= 0 && offset + span >= buffer->block_length) {
+            SetLastError("Result block is too small for nz points at the given offsets and stride");
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write one quantity into a result buffer (skipped for offset -1)
+ */
+static void WriteQuantity(const PavementResultBufferC* buffer, int offset,
+                          const std::vector<double>& values, double scale, int nz) {
+    if (offset < 0) {
+        return;
+    }
+    double* target = buffer->block + offset;
+    for (int i = 0; i < nz; ++i) {
+        target[static_cast<size_t>(i) * buffer->point_stride] = values.empty() ? 0.0 : values[i] * scale;
+    }
+}
+
+/**
+ * @brief Convert and check a C engine configuration
+ */
+static bool ConvertEngineConfig(const PavementEngineConfigC& config, Pavement::CalculationEngine::EngineConfig& data) {
+    if (config.solver != PAVEMENT_SOLVER_STANDARD && config.solver != PAVEMENT_SOLVER_STABLE) {
+        SetLastError("Unknown solver type");
+        return false;
+    }
+    if (!(config.absolute_tolerance > 0.0) || !(config.relative_tolerance > 0.0)) {
+        SetLastError("Integration tolerances must be positive");
+        return false;
+    }
+    if (config.max_evaluations < 1) {
+        SetLastError("Evaluation budget must be at least 1");
+        return false;
+    }
+    if (config.result_cache_capacity < 0) {
+        SetLastError("Result cache capacity cannot be negative");
+        return false;
+    }
+    
+    data.solver = config.solver == PAVEMENT_SOLVER_STABLE
+        ? Pavement::CalculationEngine::Solver::Stable
+        : Pavement::CalculationEngine::Solver::Standard;
+    data.threadCount = config.thread_count;
+    for (Pavement::HankelIntegrationOptions* integration : {&data.calculator.integration, &data.trmm.integration}) {
+        integration->absoluteTolerance = config.absolute_tolerance;
+        integration->relativeTolerance = config.relative_tolerance;
+        integration->maxEvaluations = config.max_evaluations;
+    }
+    data.resultCacheCapacity = static_cast<size_t>(config.result_cache_capacity);
+    return true;
+}
+
+/**
+ * @brief Body of the one-shot PavementCalculate and PavementCalculateStable
+ * 
+ * Checks the pointers, zeroes output, converts and validates input, runs
+ * solve and fills the output arrays. Every failure is recorded through
+ * FailCalculation and logged.
+ * 
+ * @param function API function name (for logs)
+ * @param calculation Calculation name (for messages)
+ * @param solve Solver run on the converted, validated input
+ */
+static int RunStandaloneCalculation(const PavementInputC* input,
+                                    PavementOutputC* output,
+                                    const char* function,
+                                    const std::string& calculation,
+                                    const std::function<PavementOutput(const PavementData&)>& solve) {
+    g_last_error[0] = '\0';
+    
     if (!output) {
         SetLastError("Output pointer is NULL");
         return PAVEMENT_ERROR_NULL_POINTER;
     }
-    
     memset(output, 0, sizeof(PavementOutputC));
+    if (!input) {
+        return FailCalculation(output, PAVEMENT_ERROR_NULL_POINTER, "Input pointer is NULL");
+    }
     
     try {
         auto start_time = std::chrono::high_resolution_clock::now();
         
-        Pavement::Logger::GetInstance().Info("Starting TRMM calculation via C API", __FILE__, __LINE__);
+        PavementData inputData;
+        if (!ConvertInputToCpp(input, inputData)) {
+            Pavement::Logger::GetInstance().Error(
+                (std::string("Input conversion failed: ") + g_last_error).c_str(), __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_INVALID_INPUT, g_last_error);
+        }
+        try {
+            inputData.Validate();
+        } catch (const std::exception& e) {
+            Pavement::Logger::GetInstance().Error(
+                (std::string("Input validation failed: ") + e.what()).c_str(), __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_INVALID_INPUT, e.what());
+        }
         
-        PavementCalculation::TRMMSolver solver;
-        bool success = solver.CalculateStable(*input, *output);
+        PavementOutput outputData;
+        try {
+            outputData = solve(inputData);
+        } catch (const std::bad_alloc&) {
+            throw;
+        } catch (const std::exception& e) {
+            const std::string message = calculation + " failed: " + e.what();
+            Pavement::Logger::GetInstance().Error(message.c_str(), __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_CALCULATION, message);
+        }
+        if (CheckIntegration(outputData) != PAVEMENT_SUCCESS) {
+            Pavement::Logger::GetInstance().Error(g_last_error, __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_CALCULATION, g_last_error);
+        }
+        if (outputData.deflection.size() < static_cast<size_t>(input->nz)) {
+            const char* message = "nz exceeds the 2*nlayer-1 interface results of the standard solver";
+            Pavement::Logger::GetInstance().Error(message, __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_INVALID_INPUT, message);
+        }
+
+        if (!AllocateOutputArrays(output, outputData, input->nz)) {
+            Pavement::Logger::GetInstance().Error(
+                (std::string("Output allocation failed: ") + g_last_error).c_str(), __FILE__, __LINE__);
+            return FailCalculation(output, PAVEMENT_ERROR_ALLOCATION, g_last_error);
+        }
         
         auto end_time = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
         output->calculation_time_ms = duration.count() / 1000.0;
         
-        if (success) {
-            std::string success_msg = "TRMM calculation completed successfully in " + std::to_string(output->calculation_time_ms) + " ms";
-            Pavement::Logger::GetInstance().Info(success_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_SUCCESS;
-        } else {
-            std::string error_msg = "TRMM calculation failed: " + std::string(output->error_message);
-            Pavement::Logger::GetInstance().Error(error_msg.c_str(), __FILE__, __LINE__);
-            return PAVEMENT_ERROR_CALCULATION;
-        }
+        output->success = 1;
+        output->error_code = PAVEMENT_SUCCESS;
+        strncpy(output->error_message, CompletionMessage(calculation, outputData).c_str(),
+                sizeof(output->error_message) - 1);
         
-    } catch (const std::bad_alloc& e) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_ALLOCATION;
-        strncpy(output->error_message, "Memory allocation failed", sizeof(output->error_message) - 1);
-        SetLastError("Memory allocation failed");
-        Pavement::Logger::GetInstance().Critical("Bad alloc in PavementCalculateStable", __FILE__, __LINE__);
-        return PAVEMENT_ERROR_ALLOCATION;
+        const std::string success_msg = calculation + " completed successfully in " +
+                                        std::to_string(output->calculation_time_ms) + " ms";
+        Pavement::Logger::GetInstance().Info(success_msg.c_str(), __FILE__, __LINE__);
+        return PAVEMENT_SUCCESS;
+        
+    } catch (const std::bad_alloc&) {
+        PavementFreeOutput(output);
+        Pavement::Logger::GetInstance().Critical(
+            (std::string("Bad alloc in ") + function).c_str(), __FILE__, __LINE__);
+        return FailCalculation(output, PAVEMENT_ERROR_ALLOCATION, "Memory allocation failed");
         
     } catch (const std::exception& e) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_UNKNOWN;
-        std::string error_msg = std::string("Exception: ") + e.what();
-        strncpy(output->error_message, error_msg.c_str(), sizeof(output->error_message) - 1);
-        SetLastError(error_msg.c_str());
-        Pavement::Logger::GetInstance().Critical(error_msg.c_str(), __FILE__, __LINE__);
-        return PAVEMENT_ERROR_UNKNOWN;
+        PavementFreeOutput(output);
+        Pavement::Logger::GetInstance().Critical(
+            (std::string("Exception in ") + function + ": " + e.what()).c_str(), __FILE__, __LINE__);
+        return FailCalculation(output, PAVEMENT_ERROR_UNKNOWN, std::string("Exception: ") + e.what());
         
     } catch (...) {
-        output->success = 0;
-        output->error_code = PAVEMENT_ERROR_UNKNOWN;
-        strncpy(output->error_message, "Unknown exception occurred", sizeof(output->error_message) - 1);
-        SetLastError("Unknown exception");
-        Pavement::Logger::GetInstance().Critical("Unknown exception in PavementCalculateStable", __FILE__, __LINE__);
-        return PAVEMENT_ERROR_UNKNOWN;
+        PavementFreeOutput(output);
+        Pavement::Logger::GetInstance().Critical(
+            (std::string("Unknown exception in ") + function).c_str(), __FILE__, __LINE__);
+        return FailCalculation(output, PAVEMENT_ERROR_UNKNOWN, "Unknown exception occurred");
     }
 }
 
+// ============================================================================
+// Public API Implementation
+// ============================================================================
+
+extern "C" {
+
+PAVEMENT_API int PavementCalculate(
+    const PavementInputC* input,
+    PavementOutputC* output
+) {
+    return RunStandaloneCalculation(input, output, "PavementCalculate", "Calculation",
+                                    [](const PavementData& inputData) {
+        Pavement::Logger::GetInstance().Info(
+            ("Starting pavement calculation via C API for " + std::to_string(inputData.layerCount) + " layers").c_str(),
+            __FILE__, __LINE__);
+        PavementCalc calculator;
+        return calculator.Calculate(inputData);
+    });
+}
+
+PAVEMENT_API int PavementCalculateStable(
+    const PavementInputC* input,
+    PavementOutputC* output
+) {
+    return RunStandaloneCalculation(input, output, "PavementCalculateStable", "TRMM calculation",
+                                    [input](const PavementData& inputData) {
+        Pavement::Logger::GetInstance().Info("Starting TRMM calculation via C API", __FILE__, __LINE__);
+        // TRMM evaluates at the requested depths (one result per z coordinate)
+        PavementCalculation::TRMMSolver solver;
+        return solver.Calculate(inputData, std::vector<double>(input->z_coords, input->z_coords + input->nz));
+    });
+}
+
 PAVEMENT_API void PavementFreeOutput(PavementOutputC* output) {
     if (!output) {
         return;
@@ -679,4 +946,320 @@ PAVEMENT_API int PavementCalculatePyMastic(
     }
 }
 
+PAVEMENT_API void PavementEngineDefaultConfig(PavementEngineConfigC* config) {
+    if (!config) {
+        return;
+    }
+    
+    const Pavement::HankelIntegrationOptions integration;
+    config->solver = PAVEMENT_SOLVER_STANDARD;
+    config->thread_count = 1;
+    config->absolute_tolerance = integration.absoluteTolerance;
+    config->relative_tolerance = integration.relativeTolerance;
+    config->max_evaluations = integration.maxEvaluations;
+    config->result_cache_capacity = 0;
+}
+
+PAVEMENT_API int PavementSetLogLevel(int level) {
+    g_last_error[0] = '\0';
+    
+    if (level < PAVEMENT_LOG_DEBUG || level > PAVEMENT_LOG_CRITICAL) {
+        SetLastError("Unknown log level");
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    Pavement::Logger::GetInstance().SetLevel(static_cast<Pavement::Logger::Level>(level));
+    return PAVEMENT_SUCCESS;
+}
+
+PAVEMENT_API PavementEngine* PavementEngineCreate(const PavementEngineConfigC* config) {
+    g_last_error[0] = '\0';
+    
+    PavementEngineConfigC defaults;
+    PavementEngineDefaultConfig(&defaults);
+    
+    try {
+        Pavement::CalculationEngine::EngineConfig engineConfig;
+        if (!ConvertEngineConfig(config ? *config : defaults, engineConfig)) {
+            return nullptr;
+        }
+        
+        auto handle = std::make_unique<PavementEngine>();
+        handle->engine = std::make_unique<Pavement::CalculationEngine>(engineConfig);
+        return handle.release();
+        
+    } catch (const std::exception& e) {
+        std::string error_msg = std::string("Engine creation failed: ") + e.what();
+        SetLastError(error_msg.c_str());
+        LOG_CRITICAL(error_msg);
+        return nullptr;
+        
+    } catch (...) {
+        SetLastError("Unknown exception in PavementEngineCreate");
+        LOG_CRITICAL("Unknown exception in PavementEngineCreate");
+        return nullptr;
+    }
+}
+
+PAVEMENT_API void PavementEngineDestroy(PavementEngine* engine) {
+    delete engine;
+}
+
+PAVEMENT_API int PavementEngineCalculate(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    PavementOutputC* output
+) {
+    g_last_error[0] = '\0';
+    
+    if (!output) {
+        SetLastError("Output pointer is NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    
+    memset(output, 0, sizeof(PavementOutputC));
+    
+    if (!engine) {
+        return FailCalculation(output, PAVEMENT_ERROR_NULL_POINTER, "Engine pointer is NULL");
+    }
+    if (!input) {
+        return FailCalculation(output, PAVEMENT_ERROR_NULL_POINTER, "Input pointer is NULL");
+    }
+    
+    return RunEngineCalculation(*engine->engine, input, output);
+}
+
+PAVEMENT_API int PavementCalculateBatch(
+    PavementEngine* engine,
+    const PavementInputC* inputs,
+    int count,
+    PavementOutputC* outputs,
+    int* failed_count
+) {
+    g_last_error[0] = '\0';
+    
+    if (failed_count) {
+        *failed_count = 0;
+    }
+    if (!engine) {
+        SetLastError("Engine pointer is NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    if (count < 0) {
+        SetLastError("Structure count cannot be negative");
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    if (count > 0 && (!inputs || !outputs)) {
+        SetLastError("Input and output arrays cannot be NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    if (count == 0) {
+        return PAVEMENT_SUCCESS;
+    }
+    
+    memset(outputs, 0, static_cast<size_t>(count) * sizeof(PavementOutputC));
+    
+    try {
+        std::vector<int> codes(static_cast<size_t>(count), PAVEMENT_SUCCESS);
+        
+        // RunEngineCalculation reports every failure in its output and never throws
+        engine->engine->ParallelFor(count, [&](int i) {
+            codes[i] = RunEngineCalculation(*engine->engine, &inputs[i], &outputs[i]);
+        });
+        
+        // Failures were recorded on the worker threads; report the first one here
+        int failed = 0;
+        int first_error = PAVEMENT_SUCCESS;
+        for (int i = 0; i < count; ++i) {
+            if (codes[i] != PAVEMENT_SUCCESS) {
+                if (failed++ == 0) {
+                    first_error = codes[i];
+                    std::string error_msg = "Structure " + std::to_string(i) + ": " + outputs[i].error_message;
+                    SetLastError(error_msg.c_str());
+                }
+            }
+        }
+        if (failed_count) {
+            *failed_count = failed;
+        }
+        return first_error;
+        
+    } catch (const std::bad_alloc&) {
+        SetLastError("Memory allocation failed");
+        LOG_CRITICAL("Bad alloc in PavementCalculateBatch");
+        return PAVEMENT_ERROR_ALLOCATION;
+        
+    } catch (...) {
+        SetLastError("Unknown exception in PavementCalculateBatch");
+        LOG_CRITICAL("Unknown exception in PavementCalculateBatch");
+        return PAVEMENT_ERROR_UNKNOWN;
+    }
+}
+
+PAVEMENT_API int PavementCalculateInto(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    const PavementResultBufferC* buffer,
+    double* calculation_time_ms
+) {
+    g_last_error[0] = '\0';
+    
+    if (!engine || !input || !buffer) {
+        SetLastError("Engine, input and buffer pointers cannot be NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    if (input->nz < 1) {
+        SetLastError("Number of calculation points must be at least 1");
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    if (!CheckResultBuffer(buffer, input->nz)) {
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    
+    try {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        
+        CalculationScratch& scratch = ThreadScratch();
+        const int result = CalculateOnEngine(*engine->engine, input, scratch.input, scratch.depths, scratch.results);
+        if (result != PAVEMENT_SUCCESS) {
+            return result;
+        }
+        
+        // Same quantities and units as AllocateOutputArrays
+        const PavementOutput& results = scratch.results;
+        const int nz = input->nz;
+        WriteQuantity(buffer, buffer->deflection_offset, results.deflection, 1.0, nz);
+        WriteQuantity(buffer, buffer->vertical_stress_offset, results.sigmaZ, 1000.0, nz);  // MPa -> kPa
+        WriteQuantity(buffer, buffer->horizontal_strain_offset, results.epsilonT, 1.0, nz);
+        WriteQuantity(buffer, buffer->radial_strain_offset, results.epsilonT, 1.0, nz);
+        WriteQuantity(buffer, buffer->shear_stress_offset, {}, 0.0, nz);  // Not computed
+        
+        if (calculation_time_ms) {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            *calculation_time_ms = duration.count() / 1000.0;
+        }
+        return PAVEMENT_SUCCESS;
+        
+    } catch (const std::bad_alloc&) {
+        SetLastError("Memory allocation failed");
+        return PAVEMENT_ERROR_ALLOCATION;
+        
+    } catch (const std::exception& e) {
+        std::string error_msg = std::string("Exception: ") + e.what();
+        SetLastError(error_msg.c_str());
+        return PAVEMENT_ERROR_UNKNOWN;
+        
+    } catch (...) {
+        SetLastError("Unknown exception occurred");
+        return PAVEMENT_ERROR_UNKNOWN;
+    }
+}
+
+PAVEMENT_API PavementJobId PavementSubmitBatch(
+    PavementEngine* engine,
+    const PavementInputC* inputs,
+    int count,
+    PavementCompletionCallback on_complete,
+    PavementProgressCallback on_progress,
+    void* user_data
+) {
+    g_last_error[0] = '\0';
+    
+    if (!engine) {
+        SetLastError("Engine pointer is NULL");
+        return 0;
+    }
+    if (count < 0) {
+        SetLastError("Structure count cannot be negative");
+        return 0;
+    }
+    if (count > 0 && !inputs) {
+        SetLastError("Input array cannot be NULL");
+        return 0;
+    }
+    
+    try {
+        auto job = std::make_shared<AsyncJob>();
+        job->inputs.resize(count);
+        job->depths.resize(count);
+        job->conversionErrors.assign(count, PAVEMENT_SUCCESS);
+        job->conversionMessages.resize(count);
+        job->outputs.resize(count);
+        job->on_complete = on_complete;
+        job->on_progress = on_progress;
+        job->user_data = user_data;
+        job->progress.total_structures = count;
+        
+        // Unfinished structures of a cancelled job keep this status
+        for (PavementOutputC& output : job->outputs) {
+            memset(&output, 0, sizeof(PavementOutputC));
+            output.error_code = PAVEMENT_ERROR_CANCELLED;
+            strncpy(output.error_message, "Calculation cancelled", sizeof(output.error_message) - 1);
+        }
+        
+        for (int i = 0; i < count; ++i) {
+            if (ConvertInputData(&inputs[i], job->inputs[i])) {
+                job->depths[i].assign(inputs[i].z_coords, inputs[i].z_coords + inputs[i].nz);
+            } else {
+                job->conversionErrors[i] = PAVEMENT_ERROR_INVALID_INPUT;
+                job->conversionMessages[i] = g_last_error;
+            }
+        }
+        g_last_error[0] = '\0';
+        
+        // The id is set before any task can read it: the job waits for this lock
+        Pavement::CalculationEngine& calculation = *engine->engine;
+        std::lock_guard<std::mutex> lock(job->progressMutex);
+        job->id = calculation.Submit(
+            count,
+            [&calculation, job](int i) { RunJobStructure(calculation, *job, i); },
+            [job](bool cancelled) { CompleteJob(*job, cancelled); });
+        return job->id;
+        
+    } catch (const std::bad_alloc&) {
+        SetLastError("Memory allocation failed");
+        return 0;
+        
+    } catch (const std::exception& e) {
+        std::string error_msg = std::string("Exception: ") + e.what();
+        SetLastError(error_msg.c_str());
+        return 0;
+    }
+}
+
+PAVEMENT_API PavementJobId PavementSubmit(
+    PavementEngine* engine,
+    const PavementInputC* input,
+    PavementCompletionCallback on_complete,
+    void* user_data
+) {
+    if (!input) {
+        g_last_error[0] = '\0';
+        SetLastError("Input pointer is NULL");
+        return 0;
+    }
+    return PavementSubmitBatch(engine, input, 1, on_complete, nullptr, user_data);
+}
+
+PAVEMENT_API int PavementCancel(PavementEngine* engine, PavementJobId job) {
+    if (!engine) {
+        SetLastError("Engine pointer is NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    if (!engine->engine->Cancel(job)) {
+        SetLastError("Job is unknown or already finished");
+        return PAVEMENT_ERROR_INVALID_INPUT;
+    }
+    return PAVEMENT_SUCCESS;
+}
+
+PAVEMENT_API int PavementWait(PavementEngine* engine, PavementJobId job) {
+    if (!engine) {
+        SetLastError("Engine pointer is NULL");
+        return PAVEMENT_ERROR_NULL_POINTER;
+    }
+    engine->engine->Wait(job);
+    return PAVEMENT_SUCCESS;
+}
+
 } // extern "C"
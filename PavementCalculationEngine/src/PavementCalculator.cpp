@@ -2,13 +2,310 @@
 #include "MatrixOperations.h"
 #include "Logger.h"
 #include "Constants.h"
+#include "SpecialFunctions.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <functional>
 #include <iostream>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
-#include <fstream>
+#include <utility>
 
 namespace Pavement {
 
+namespace {
+
+// Number of result arrays carried by CalculationOutput
+constexpr int RESULT_QUANTITIES = 5;
+
+// Flatten output arrays into one integrand vector: [sigmaT | epsilonT | sigmaZ | epsilonZ | deflection]
+Eigen::VectorXd PackOutput(const CalculationOutput& output) {
+    const int n = static_cast<int>(output.sigmaT.size());
+    Eigen::VectorXd packed(RESULT_QUANTITIES * n);
+    for (int i = 0; i < n; ++i) {
+        packed(i) = output.sigmaT[i];
+        packed(n + i) = output.epsilonT[i];
+        packed(2 * n + i) = output.sigmaZ[i];
+        packed(3 * n + i) = output.epsilonZ[i];
+        packed(4 * n + i) = output.deflection[i];
+    }
+    return packed;
+}
+
+void UnpackOutput(const Eigen::VectorXd& packed, CalculationOutput& output) {
+    const int n = static_cast<int>(output.sigmaT.size());
+    for (int i = 0; i < n; ++i) {
+        output.sigmaT[i] = packed(i);
+        output.epsilonT[i] = packed(n + i);
+        output.sigmaZ[i] = packed(2 * n + i);
+        output.epsilonZ[i] = packed(3 * n + i);
+        output.deflection[i] = packed(4 * n + i);
+    }
+}
+
+// Breakpoints of the load-axis integral: the zeros of J1(m*a) below the
+// truncation bound, or as many as partition-extrapolation may sum
+std::vector<double> HankelBreakpoints(double a, const HankelIntegrationOptions& options) {
+    return options.extrapolateTail
+        ? HankelIntegrator::BesselJ1ZeroBreakpoints(a, options.maxPartitions)
+        : HankelIntegrator::BesselJ1Breakpoints(a, Constants::HANKEL_INTEGRATION_BOUND / a);
+}
+
+// Integrand value of a parameter that could not be solved: the integrator
+// counts it as failed and does not report convergence
+Eigen::VectorXd FailedPoint(int size) {
+    return Eigen::VectorXd::Constant(size, std::numeric_limits<double>::quiet_NaN());
+}
+
+// A numerically singular system satisfies the residual test with arbitrary
+// coefficients; reject it rather than integrate noise. reciprocalCondition is
+// the Hager/Higham estimate of 1/cond_1, not a pivot ratio: pivots can all
+// be benign while the inverse is enormous
+SolveStatus RejectSingularSystem(SolveStatus status, const SolveReport& report) noexcept {
+    if (status == SolveStatus::Ok &&
+        report.reciprocalCondition < Constants::SINGULAR_RECIPROCAL_CONDITION) {
+        return SolveStatus::NumericallySingular;
+    }
+    return status;
+}
+
+// Outcome of the solves of one integration. Nodes only count; the first
+// failing and the first ill-conditioned parameter are kept (by whichever
+// thread counts first) and logged once the integration is over, so the
+// integrand builds no strings.
+class SolveTally {
+public:
+    // True if the coefficients of m may be integrated
+    bool Accept(double m, SolveStatus status, const SolveReport& report) noexcept {
+        if (status != SolveStatus::Ok) {
+            if (failed_.fetch_add(1) == 0) {
+                firstFailure_ = m;
+                firstStatus_ = status;
+            }
+            return false;
+        }
+        if (report.reciprocalCondition * Constants::CONDITION_NUMBER_WARNING_THRESHOLD < 1.0 &&
+            illConditioned_.fetch_add(1) == 0) {
+            firstIllConditioned_ = m;
+            firstReciprocalCondition_ = report.reciprocalCondition;
+        }
+        return true;
+    }
+    
+    void Log() const {
+        if (failed_.load() > 0) {
+            LOG_WARNING(std::to_string(failed_.load()) + " integration point(s) failed, " +
+                        "first at m=" + std::to_string(firstFailure_) + ": " +
+                        MatrixOperations::StatusMessage(firstStatus_));
+        }
+        if (illConditioned_.load() > 0) {
+            LOG_WARNING(std::to_string(illConditioned_.load()) + " integration point(s) with a " +
+                        "high condition number estimate, first " +
+                        std::to_string(1.0 / firstReciprocalCondition_) + " at m=" +
+                        std::to_string(firstIllConditioned_) + " - results may be inaccurate");
+        }
+    }
+
+private:
+    std::atomic<int> failed_{0};
+    std::atomic<int> illConditioned_{0};
+    double firstFailure_ = 0.0;
+    SolveStatus firstStatus_ = SolveStatus::Ok;
+    double firstIllConditioned_ = 0.0;
+    double firstReciprocalCondition_ = 0.0;
+};
+
+// Interpolation of the layer coefficients across the segments of one adaptive
+// integration (CalculatorConfig::interpolation). Every coefficient vector
+// solved exactly is kept as a sample. When the integrator announces a
+// segment that already holds options.minSamples samples (from the rules of
+// the segments it was bisected from), a polynomial through them is checked
+// against the segment's own Kronrod nodes farthest from any sample; if it
+// passes, the remaining nodes are interpolated. The check nodes are needed
+// by the rule anyway, so a rejected fit costs no solve, and the checks of
+// all segments of a step are solved together.
+//
+// Steps are prepared on the integrating thread between integrand calls.
+// During a step every node owns one slot of the step table, which only its
+// own evaluation writes; the solved slots become samples when the next step
+// is prepared. Every decision therefore follows from the refinement history
+// alone, whatever the thread count.
+class SegmentInterpolation {
+public:
+    enum class Source { Solve, Exact, Interpolated };
+    
+    // Exact coefficients at several m, column i for m[i]; throws if any fails
+    using Sampler = std::function<Eigen::MatrixXd(const std::vector<double>& m)>;
+    
+    SegmentInterpolation(int size, const ChebyshevOptions& options, Sampler exact)
+        : size_(size), options_(options), exact_(std::move(exact)) {}
+    
+    // HankelIntegrator::SegmentObserver
+    void Prepare(const std::vector<std::pair<double, double>>& segments) {
+        KeepSolvedNodes();
+        
+        // Step table: all rule nodes, ascending (segments are disjoint)
+        constexpr int RULE = HankelIntegrator::KRONROD_NODES;
+        const int nodeCount = RULE * static_cast<int>(segments.size());
+        std::vector<double> rules(nodeCount);
+        for (size_t s = 0; s < segments.size(); ++s) {
+            HankelIntegrator::KronrodNodes(segments[s].first, segments[s].second, &rules[RULE * s]);
+        }
+        nodes_ = rules;
+        std::sort(nodes_.begin(), nodes_.end());
+        sources_.assign(nodeCount, Source::Solve);
+        values_.resize(size_, nodeCount);
+        
+        // Segments with enough samples, and where to check them
+        struct Fit {
+            double lower;
+            double upper;
+            std::vector<double> nodes;
+            Eigen::MatrixXd values;
+            int firstCheck;
+            int checkCount;
+        };
+        std::vector<Fit> fits;
+        std::vector<double> checks;
+        for (size_t s = 0; s < segments.size(); ++s) {
+            if (segments[s].first <= 0.0) {
+                continue;  // The coefficients vary on ever finer scales as m -> 0
+            }
+            const auto first = std::lower_bound(samples_.begin(), samples_.end(),
+                                                std::make_pair(segments[s].first, -1));
+            const auto last = std::upper_bound(samples_.begin(), samples_.end(),
+                                               std::make_pair(segments[s].second, INT_MAX));
+            const int count = static_cast<int>(last - first);
+            if (count < std::max(2, options_.minSamples)) {
+                continue;
+            }
+            Fit fit{segments[s].first, segments[s].second, {}, Eigen::MatrixXd(size_, count),
+                    static_cast<int>(checks.size()), 0};
+            for (auto sample = first; sample != last; ++sample) {
+                fit.values.col(static_cast<int>(fit.nodes.size())) = Sample(sample->second);
+                fit.nodes.push_back(sample->first);
+            }
+            const std::vector<double> segmentChecks = ChebyshevInterpolant::SampleCheckPoints(
+                fit.nodes, std::vector<double>(&rules[RULE * s], &rules[RULE * (s + 1)]),
+                options_.checkPoints);
+            fit.checkCount = static_cast<int>(segmentChecks.size());
+            checks.insert(checks.end(), segmentChecks.begin(), segmentChecks.end());
+            fits.push_back(std::move(fit));
+        }
+        if (checks.empty()) {
+            return;
+        }
+        
+        Eigen::MatrixXd checkValues;
+        try {
+            checkValues = exact_(checks);
+        } catch (const std::exception&) {
+            // The failing node fails again when the rule solves it, and is tallied there
+            rejectedFits_ += static_cast<int>(fits.size());
+            return;
+        }
+        checkSolves_ += static_cast<int>(checks.size());
+        for (size_t i = 0; i < checks.size(); ++i) {
+            const int node = Find(checks[i]);
+            values_.col(node) = checkValues.col(static_cast<int>(i));
+            sources_[node] = Source::Exact;
+        }
+        
+        for (Fit& fit : fits) {
+            const std::unique_ptr<ChebyshevInterpolant> interpolant = ChebyshevInterpolant::FitSamples(
+                fit.lower, fit.upper, std::move(fit.nodes), std::move(fit.values),
+                std::vector<double>(checks.begin() + fit.firstCheck,
+                                    checks.begin() + fit.firstCheck + fit.checkCount),
+                checkValues.middleCols(fit.firstCheck, fit.checkCount), options_);
+            if (!interpolant) {
+                ++rejectedFits_;
+                continue;
+            }
+            const auto first = std::upper_bound(nodes_.begin(), nodes_.end(), fit.lower);
+            const auto last = std::lower_bound(nodes_.begin(), nodes_.end(), fit.upper);
+            for (auto m = first; m != last; ++m) {
+                const int node = static_cast<int>(m - nodes_.begin());
+                if (sources_[node] == Source::Solve) {
+                    values_.col(node) = interpolant->Evaluate(*m);
+                    sources_[node] = Source::Interpolated;
+                }
+            }
+        }
+    }
+    
+    // Slot of node m in the current step, or -1 if m is not one of its nodes
+    int Find(double m) const {
+        const auto node = std::lower_bound(nodes_.begin(), nodes_.end(), m);
+        return (node != nodes_.end() && *node == m) ? static_cast<int>(node - nodes_.begin()) : -1;
+    }
+    
+    Source SourceOf(int node) const { return sources_[node]; }
+    
+    // The size coefficients of a slot: prepared, or to be written by the solve
+    double* Coefficients(int node) { return values_.col(node).data(); }
+    
+    // The slot now holds exactly solved coefficients
+    void Solved(int node) { sources_[node] = Source::Exact; }
+    
+    int CheckSolves() const { return checkSolves_; }
+    int RejectedFits() const { return rejectedFits_; }
+
+private:
+    Eigen::Map<const Eigen::VectorXd> Sample(int index) const {
+        return Eigen::Map<const Eigen::VectorXd>(&store_[static_cast<size_t>(index) * size_], size_);
+    }
+    
+    // Turn the exact slots of the finished step into samples
+    void KeepSolvedNodes() {
+        std::vector<std::pair<double, int>> added;
+        for (size_t node = 0; node < nodes_.size(); ++node) {
+            if (sources_[node] != Source::Exact) {
+                continue;
+            }
+            added.emplace_back(nodes_[node], static_cast<int>(store_.size() / size_));
+            store_.insert(store_.end(), values_.col(node).data(), values_.col(node).data() + size_);
+        }
+        const size_t middle = samples_.size();
+        samples_.insert(samples_.end(), added.begin(), added.end());  // Already ascending
+        std::inplace_merge(samples_.begin(), samples_.begin() + middle, samples_.end());
+    }
+    
+    const int size_;
+    const ChebyshevOptions& options_;
+    Sampler exact_;
+    std::vector<double> store_;                   // Sample coefficients, size_ per sample
+    std::vector<std::pair<double, int>> samples_;  // (m, index in store_), ascending
+    std::vector<double> nodes_;                   // Nodes of the current step, ascending
+    std::vector<Source> sources_;                 // Per node of the step
+    Eigen::MatrixXd values_;                      // Per node of the step: its coefficients
+    int checkSolves_ = 0;
+    int rejectedFits_ = 0;
+};
+
+} // namespace
+
+PavementCalculator::PavementCalculator() : config_() {}
+
+PavementCalculator::PavementCalculator(const CalculatorConfig& config) {
+    SetConfig(config);
+}
+
+void PavementCalculator::SetConfig(const CalculatorConfig& config) {
+    config_ = config;
+    if (config_.threadCount == 1) {
+        pool_.reset();
+    } else if (!pool_ || pool_->GetThreadCount() != config_.threadCount) {
+        pool_ = std::make_shared<ThreadPool>(config_.threadCount);
+    }
+}
+
+void PavementCalculator::SetThreadPool(std::shared_ptr<ThreadPool> pool) {
+    pool_ = std::move(pool);
+    config_.threadCount = pool_ ? pool_->GetThreadCount() : 1;
+}
+
 CalculationOutput PavementCalculator::Calculate(const CalculationInput& input) {
     // Validate input (throws if invalid)
     LOG_INFO("Starting pavement calculation");
@@ -17,154 +314,474 @@ CalculationOutput PavementCalculator::Calculate(const CalculationInput& input) {
     input.Validate();
     LOG_INFO("Input validation passed");
     
-    // Initialize output
+    // Initialize output (Resize zero-fills every result position)
     CalculationOutput output;
     int resultSize = 2 * input.layerCount - 1;
     output.Resize(resultSize);
-    output.Clear();
     
     LOG_INFO("Initialized output structure with " + std::to_string(resultSize) + " result positions");
-    LOG_DEBUG("Using Gauss-Legendre " + std::to_string(Constants::GAUSS_QUADRATURE_POINTS) + 
-             "-point quadrature for Hankel integration");
-    
-    std::cout << "Starting pavement calculation with " << input.layerCount 
-              << " layers using Eigen-based matrix operations..." << std::endl;
-    
-    // File-based logging for debugging
-    std::ofstream debugFile("C:\\Temp\\PavementDebug.txt", std::ios::trunc); // Clear file at start
-    if (debugFile.is_open()) {
-        debugFile << "=== PAVEMENT CALCULATION START ===" << std::endl;
-        debugFile << "Layer count: " << input.layerCount << std::endl;
-        debugFile << "Pressure: " << input.pressure << " MPa" << std::endl;
-        debugFile << "Contact radius: " << input.contactRadius << " m" << std::endl;
-        debugFile << "Result size: " << resultSize << " positions" << std::endl;
-        debugFile.close();
-    }
-    
-    // Gauss-Legendre quadrature for Hankel transform integration
-    // Integration over [0, infinity] - use practical upper bound
-    const double upperBound = Constants::HANKEL_INTEGRATION_BOUND / input.contactRadius;
-    
-    // Perform Gauss-Legendre integration
-    for (int i = 0; i < Constants::GAUSS_QUADRATURE_POINTS; ++i) {
-        // Transform from [-1,1] to [0, upperBound]
-        double m = (Constants::GAUSS_POINTS_4[i] + 1.0) * 0.5 * upperBound;
-        double weight = Constants::GAUSS_WEIGHTS_4[i] * 0.5 * upperBound;
-        
-        std::cout << "Hankel Integration: Point " << i << ", m = " << m << ", weight = " << weight << std::endl;
+    
+    // Hankel transform over [0, infinity] truncated at a practical upper bound,
+    // split at the zeros of the load kernel J1(m*a) so each subinterval holds
+    // at most one oscillation
+    const double a = input.contactRadius;
+    const std::vector<double> breakpoints = HankelBreakpoints(a, config_.integration);
+    
+    LOG_DEBUG("Adaptive Gauss-Kronrod Hankel integration over " +
+              std::to_string(breakpoints.size() - 1) + " initial intervals, relative tolerance " +
+              std::to_string(config_.integration.relativeTolerance));
+    
+    // Evaluations may run concurrently: each one uses only its own local output
+    SolveTally tally;
+    std::atomic<int> refinementSteps{0};
+    
+    // Dispatch once on the layer count: 2-6 layers run on fixed-size stack kernels
+    const HankelEvaluator evaluate = SelectEvaluator(input.layerCount);
+    
+    // Everything in the system matrix that does not depend on m, computed once
+    const AssemblyPlan plan(input);
+    
+    // Coefficients interpolated between the exact solves of earlier rules
+    // (an order below the integration tolerance, so that interpolation errors
+    // do not show up in the error estimate and force bisections of their own)
+    const bool interpolating = config_.interpolation.enabled;
+    ChebyshevOptions interpolationOptions = config_.interpolation;
+    interpolationOptions.relativeTolerance = std::min(interpolationOptions.relativeTolerance,
+                                                      0.1 * config_.integration.relativeTolerance);
+    SegmentInterpolation interpolation(plan.Size(), interpolationOptions,
+                                       [&](const std::vector<double>& m) {
+                                           return SolveCoefficientColumns(m, plan, refinementSteps);
+                                       });
+    std::atomic<int> interpolatedEvaluations{0};
+    
+    // Coefficients prepared for m (interpolated, or solved as a check): true if
+    // contribution was filled from them. Otherwise m must be solved, and
+    // *keep (null if not interpolating) is the slot its coefficients go to.
+    auto prepared = [&](double m, CalculationOutput& contribution, int* keep) -> bool {
+        *keep = interpolating ? interpolation.Find(m) : -1;
+        if (*keep < 0 || interpolation.SourceOf(*keep) == SegmentInterpolation::Source::Solve) {
+            return false;
+        }
+        CalculateSolicitationsFromCoefficients(
+            Eigen::Map<const Eigen::VectorXd>(interpolation.Coefficients(*keep), plan.Size()),
+            m, input, contribution);
+        if (interpolation.SourceOf(*keep) == SegmentInterpolation::Source::Interpolated) {
+            ++interpolatedEvaluations;
+        }
+        return true;
+    };
+    
+    // Integrand on the load axis (r = 0): responses for unit transform times a*J1(m*a)
+    auto integrand = [&](double m) -> Eigen::VectorXd {
+        CalculationOutput contribution;
+        contribution.Resize(resultSize);
         
-        // Log to file
-        std::ofstream debugFile("C:\\Temp\\PavementDebug.txt", std::ios::app);
-        if (debugFile.is_open()) {
-            debugFile << "\n=== Hankel Integration Point " << i << " ===" << std::endl;
-            debugFile << "m = " << m << ", weight = " << weight << std::endl;
-            debugFile.close();
+        int slot = -1;
+        if (m > Constants::MIN_HANKEL_PARAMETER && !prepared(m, contribution, &slot)) {  // Avoid singularity at m=0
+            SolveReport report;
+            const SolveStatus status = (this->*evaluate)(
+                m, plan, input, contribution, report, slot >= 0 ? interpolation.Coefficients(slot) : nullptr);
+            refinementSteps += report.refinementSteps;
+            if (!tally.Accept(m, status, report)) {
+                return FailedPoint(RESULT_QUANTITIES * resultSize);
+            }
+            if (slot >= 0) {
+                interpolation.Solved(slot);
+            }
         }
         
-        if (m > Constants::MIN_HANKEL_PARAMETER) {  // Avoid singularity at m=0
-            try {
-                std::cout << "Processing integration point m=" << m << std::endl;
-                CalculateForHankelParameter(m, input, output);
-                std::cout << "Successfully calculated for m=" << m << std::endl;
-                
-            } catch (const std::exception& e) {
-                LOG_WARNING("Integration point m=" + std::to_string(m) + 
-                           " failed: " + std::string(e.what()));
-                std::cerr << "Warning: Integration point m=" << m 
-                         << " failed: " << e.what() << std::endl;
-                // Continue with other points
+        return PackOutput(contribution) * (a * SpecialFunctions::BesselJ1(m * a));
+    };
+    
+    // Same integrand, BATCH_SIZE nodes per lock-step solve
+    constexpr int BATCH_SIZE = MatrixOperations::BATCH_SIZE;
+    auto batchIntegrand = [&](const double* m, int count, Eigen::VectorXd* values) {
+        CalculationOutput contributions[BATCH_SIZE];
+        SolveReport reports[BATCH_SIZE];
+        SolveStatus statuses[BATCH_SIZE];
+        double solvable[BATCH_SIZE];
+        int slot[BATCH_SIZE];  // Interpolation slot of each solvable parameter (-1: none)
+        double* keep[BATCH_SIZE];
+        int node[BATCH_SIZE];  // Node index of each solvable parameter
+        int solvableCount = 0;
+        double kernel[BATCH_SIZE];  // a * J1(m * a) of every node
+        for (int i = 0; i < count; ++i) {
+            kernel[i] = m[i] * a;
+        }
+        SpecialFunctions::BesselJ1(kernel, kernel, count);
+        for (int i = 0; i < count; ++i) {
+            kernel[i] *= a;
+        }
+        for (int i = 0; i < count; ++i) {
+            values[i] = Eigen::VectorXd::Zero(RESULT_QUANTITIES * resultSize);
+            if (m[i] <= Constants::MIN_HANKEL_PARAMETER) {  // Avoid singularity at m=0
+                continue;
+            }
+            CalculationOutput known;
+            known.Resize(resultSize);
+            if (prepared(m[i], known, &slot[solvableCount])) {
+                values[i] = PackOutput(known) * kernel[i];
+                continue;
+            }
+            keep[solvableCount] = slot[solvableCount] >= 0 ? interpolation.Coefficients(slot[solvableCount]) : nullptr;
+            contributions[solvableCount].Resize(resultSize);
+            solvable[solvableCount] = m[i];
+            node[solvableCount] = i;
+            ++solvableCount;
+        }
+        if (solvableCount > 0) {
+            CalculateForHankelParameterBatch(solvable, solvableCount, plan, input,
+                                             contributions, reports, statuses, keep);
+        }
+        for (int l = 0; l < solvableCount; ++l) {
+            refinementSteps += reports[l].refinementSteps;
+            if (!tally.Accept(solvable[l], statuses[l], reports[l])) {
+                values[node[l]] = FailedPoint(RESULT_QUANTITIES * resultSize);
+                continue;
+            }
+            values[node[l]] = PackOutput(contributions[l]) * kernel[node[l]];
+            if (slot[l] >= 0) {
+                interpolation.Solved(slot[l]);
             }
         }
+    };
+    
+    HankelIntegrator::SegmentObserver prepare;
+    if (interpolating) {
+        prepare = [&](const std::vector<std::pair<double, double>>& segments) {
+            interpolation.Prepare(segments);
+        };
     }
+    HankelIntegrationResult integral = config_.batchedSolver
+        ? HankelIntegrator::IntegrateBatched(batchIntegrand, BATCH_SIZE, breakpoints,
+                                             config_.integration, pool_.get(), prepare)
+        : HankelIntegrator::Integrate(integrand, breakpoints, config_.integration, pool_.get(), prepare);
+    tally.Log();
+    
+    UnpackOutput(integral.value, output);
+    output.integration.errorEstimate = integral.errorEstimate;
+    output.integration.evaluations = integral.evaluations;
+    output.integration.intervals = integral.intervals;
+    output.integration.failedEvaluations = integral.failedEvaluations;
+    output.integration.refinementSteps = refinementSteps.load();
+    output.integration.interpolatedEvaluations = interpolatedEvaluations.load();
+    output.integration.interpolationSolves = interpolation.CheckSolves();
+    output.integration.rejectedInterpolants = interpolation.RejectedFits();
+    output.integration.converged = integral.converged;
+    output.integration.partitions = integral.partitions;
+    output.integration.extrapolationError = integral.extrapolationError;
     
-    LOG_INFO("Calculation completed successfully for " + std::to_string(resultSize) + 
-             " result positions");
-    std::cout << "Calculation completed successfully for " << resultSize 
-              << " result positions" << std::endl;
+    LOG_INFO("Calculation completed for " + std::to_string(resultSize) + 
+             " result positions: " + std::to_string(integral.evaluations) + " evaluations, " +
+             std::to_string(integral.intervals) + " intervals, error estimate " +
+             std::to_string(integral.errorEstimate));
     
     return output;
 }
 
-void PavementCalculator::CalculateForHankelParameter(double m, 
-                                                     const CalculationInput& input,
-                                                     CalculationOutput& output) {
-    try {
-        // Solve the linear system for this Hankel parameter
-        std::cout << "Solving coefficients for m=" << m << std::endl;
-        Eigen::VectorXd coefficients = MatrixOperations::SolveCoefficients(m, input);
-        
-        std::cout << "Coefficients for m=" << m << ": [";
-        for (int i = 0; i < std::min(8, (int)coefficients.size()); ++i) {
-            std::cout << coefficients(i);
-            if (i < std::min(8, (int)coefficients.size()) - 1) std::cout << ", ";
+std::vector<CalculationOutput> PavementCalculator::CalculateLoadCases(
+    const CalculationInput& input, const std::vector<SurfaceLoad>& loads) {
+    LOG_INFO("Starting pavement calculation for " + std::to_string(loads.size()) + " load cases");
+    
+    input.Validate();
+    if (loads.empty()) {
+        throw std::invalid_argument("At least one load case is required");
+    }
+    
+    const int caseCount = static_cast<int>(loads.size());
+    const int resultSize = 2 * input.layerCount - 1;
+    const int caseValues = RESULT_QUANTITIES * resultSize;
+    
+    // The layer system does not depend on the load: every case scales the
+    // response to input.pressure and integrates it against its own a*J1(m*a)
+    std::vector<double> scale(caseCount);
+    std::vector<double> radius(caseCount);
+    for (int c = 0; c < caseCount; ++c) {
+        const SurfaceLoad& load = loads[c];
+        if (!(load.pressure >= Constants::MIN_TIRE_PRESSURE && load.pressure <= Constants::MAX_TIRE_PRESSURE)) {
+            throw std::invalid_argument("Invalid pressure of load case " + std::to_string(c) + ": " +
+                                        std::to_string(load.pressure) + " MPa (must be 0-5)");
         }
-        std::cout << (coefficients.size() > 8 ? ", ...]" : "]") << std::endl;
-        
-        // Log coefficients to file
-        std::ofstream debugFile("C:\\Temp\\PavementDebug.txt", std::ios::app);
-        if (debugFile.is_open()) {
-            debugFile << "Solved coefficients (size " << coefficients.size() << "): [";
-            for (int i = 0; i < coefficients.size(); ++i) {
-                debugFile << coefficients(i);
-                if (i < coefficients.size() - 1) debugFile << ", ";
+        radius[c] = load.contactRadius == 0.0 ? input.contactRadius : load.contactRadius;
+        if (!(radius[c] > Constants::MIN_CONTACT_RADIUS && radius[c] <= Constants::MAX_CONTACT_RADIUS)) {
+            throw std::invalid_argument("Invalid contact radius of load case " + std::to_string(c) + ": " +
+                                        std::to_string(radius[c]) + " m (must be 0-1)");
+        }
+        scale[c] = load.pressure / input.pressure;
+    }
+    const double smallest = *std::min_element(radius.begin(), radius.end());
+    const double largest = *std::max_element(radius.begin(), radius.end());
+    
+    // One radius integrates like Calculate. Otherwise the intervals end at the
+    // densest kernel zeros (largest radius), so no kernel completes more than
+    // half an oscillation per interval, up to the truncation bound of the
+    // smallest radius. The other kernels do not vanish at those breakpoints,
+    // so their partial sums cannot be extrapolated and the tail is truncated.
+    HankelIntegrationOptions integration = config_.integration;
+    std::vector<double> breakpoints;
+    if (smallest == largest) {
+        breakpoints = HankelBreakpoints(smallest, integration);
+    } else {
+        integration.extrapolateTail = false;
+        breakpoints = HankelIntegrator::BesselJ1Breakpoints(
+            largest, Constants::HANKEL_INTEGRATION_BOUND / smallest);
+    }
+    
+    SolveTally tally;
+    std::atomic<int> refinementSteps{0};
+    const HankelEvaluator evaluate = SelectEvaluator(input.layerCount);
+    const AssemblyPlan plan(input);
+    
+    // Packed response of m spread over the cases, one after the other
+    auto spread = [&](double m, const Eigen::VectorXd& response, Eigen::VectorXd& values) {
+        std::vector<double> kernel(caseCount);
+        for (int c = 0; c < caseCount; ++c) {
+            kernel[c] = m * radius[c];
+        }
+        SpecialFunctions::BesselJ1(kernel.data(), kernel.data(), caseCount);
+        for (int c = 0; c < caseCount; ++c) {
+            values.segment(c * caseValues, caseValues) = response * (scale[c] * radius[c] * kernel[c]);
+        }
+    };
+    
+    auto integrand = [&](double m) -> Eigen::VectorXd {
+        Eigen::VectorXd values = Eigen::VectorXd::Zero(caseCount * caseValues);
+        if (m <= Constants::MIN_HANKEL_PARAMETER) {  // Avoid singularity at m=0
+            return values;
+        }
+        CalculationOutput contribution;
+        contribution.Resize(resultSize);
+        SolveReport report;
+        const SolveStatus status = (this->*evaluate)(m, plan, input, contribution, report, nullptr);
+        refinementSteps += report.refinementSteps;
+        if (!tally.Accept(m, status, report)) {
+            return FailedPoint(caseCount * caseValues);
+        }
+        spread(m, PackOutput(contribution), values);
+        return values;
+    };
+    
+    // Same integrand, BATCH_SIZE nodes per lock-step solve
+    constexpr int BATCH_SIZE = MatrixOperations::BATCH_SIZE;
+    auto batchIntegrand = [&](const double* m, int count, Eigen::VectorXd* values) {
+        CalculationOutput contributions[BATCH_SIZE];
+        SolveReport reports[BATCH_SIZE];
+        SolveStatus statuses[BATCH_SIZE];
+        double solvable[BATCH_SIZE];
+        int node[BATCH_SIZE];  // Node index of each solvable parameter
+        int solvableCount = 0;
+        for (int i = 0; i < count; ++i) {
+            values[i] = Eigen::VectorXd::Zero(caseCount * caseValues);
+            if (m[i] <= Constants::MIN_HANKEL_PARAMETER) {  // Avoid singularity at m=0
+                continue;
             }
-            debugFile << "]" << std::endl;
-            debugFile.close();
+            contributions[solvableCount].Resize(resultSize);
+            solvable[solvableCount] = m[i];
+            node[solvableCount] = i;
+            ++solvableCount;
         }
-        
-        // Calculate solicitations from these coefficients
-        std::cout << "Calculating solicitations for m=" << m << std::endl;
-        CalculateSolicitationsFromCoefficients(coefficients, m, input, output);
-        std::cout << "Completed solicitations for m=" << m << std::endl;
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Exception in CalculateForHankelParameter: " << e.what() << std::endl;
-        throw std::runtime_error(
-            "Failed to calculate for m=" + std::to_string(m) + ": " + e.what());
+        if (solvableCount > 0) {
+            CalculateForHankelParameterBatch(solvable, solvableCount, plan, input,
+                                             contributions, reports, statuses);
+        }
+        for (int l = 0; l < solvableCount; ++l) {
+            refinementSteps += reports[l].refinementSteps;
+            if (!tally.Accept(solvable[l], statuses[l], reports[l])) {
+                values[node[l]] = FailedPoint(caseCount * caseValues);
+                continue;
+            }
+            spread(solvable[l], PackOutput(contributions[l]), values[node[l]]);
+        }
+    };
+    
+    const HankelIntegrationResult integral = config_.batchedSolver
+        ? HankelIntegrator::IntegrateBatched(batchIntegrand, BATCH_SIZE, breakpoints,
+                                             integration, pool_.get())
+        : HankelIntegrator::Integrate(integrand, breakpoints, integration, pool_.get());
+    tally.Log();
+    
+    std::vector<CalculationOutput> outputs(caseCount);
+    for (int c = 0; c < caseCount; ++c) {
+        CalculationOutput& output = outputs[c];
+        output.Resize(resultSize);
+        UnpackOutput(integral.value.segment(c * caseValues, caseValues), output);
+        output.integration.errorEstimate = integral.errorEstimate;
+        output.integration.evaluations = integral.evaluations;
+        output.integration.intervals = integral.intervals;
+        output.integration.failedEvaluations = integral.failedEvaluations;
+        output.integration.refinementSteps = refinementSteps.load();
+        output.integration.converged = integral.converged;
+        output.integration.partitions = integral.partitions;
+        output.integration.extrapolationError = integral.extrapolationError;
     }
+    
+    LOG_INFO("Load case calculation completed: " + std::to_string(integral.evaluations) +
+             " evaluations (one solve each) for " + std::to_string(caseCount) + " cases");
+    
+    return outputs;
+}
+
+PavementCalculator::HankelEvaluator PavementCalculator::SelectEvaluator(int layerCount) {
+    static_assert(MatrixOperations::MIN_FIXED_LAYER_COUNT == 2 &&
+                  MatrixOperations::MAX_FIXED_LAYER_COUNT == 6,
+                  "SelectEvaluator must cover every fixed-size solver");
+    switch (layerCount) {
+        case 2: return &PavementCalculator::CalculateForHankelParameterFixed<2>;
+        case 3: return &PavementCalculator::CalculateForHankelParameterFixed<3>;
+        case 4: return &PavementCalculator::CalculateForHankelParameterFixed<4>;
+        case 5: return &PavementCalculator::CalculateForHankelParameterFixed<5>;
+        case 6: return &PavementCalculator::CalculateForHankelParameterFixed<6>;
+        default: return &PavementCalculator::CalculateForHankelParameter;
+    }
+}
+
+void PavementCalculator::CalculateForHankelParameterBatch(const double* m, int count,
+                                                          const AssemblyPlan& plan,
+                                                          const CalculationInput& input,
+                                                          CalculationOutput* outputs,
+                                                          SolveReport* reports,
+                                                          SolveStatus* statuses,
+                                                          double* const* coefficients) {
+    const BatchSolveResult solved =
+        MatrixOperations::SolveCoefficientsBatch(m, count, plan, config_.solver);
+    
+    for (int l = 0; l < count; ++l) {
+        reports[l] = solved.reports[l];
+        statuses[l] = RejectSingularSystem(solved.reports[l].status, solved.reports[l]);
+        if (statuses[l] != SolveStatus::Ok) {
+            continue;
+        }
+        CalculateSolicitationsFromCoefficients(solved.coefficients.col(l), m[l], input, outputs[l]);
+        if (coefficients && coefficients[l]) {
+            Eigen::Map<Eigen::VectorXd>(coefficients[l], plan.Size()) = solved.coefficients.col(l);
+        }
+    }
+}
+
+Eigen::MatrixXd PavementCalculator::SolveCoefficientColumns(const std::vector<double>& m,
+                                                           const AssemblyPlan& plan,
+                                                           std::atomic<int>& refinementSteps) {
+    const int count = static_cast<int>(m.size());
+    Eigen::MatrixXd columns(plan.Size(), count);
+    
+    if (!config_.batchedSolver) {
+        for (int i = 0; i < count; ++i) {
+            SolveReport report;
+            Eigen::VectorXd coefficients;
+            const SolveStatus status = RejectSingularSystem(
+                MatrixOperations::TrySolveCoefficients(m[i], plan, coefficients, &report, config_.solver),
+                report);
+            refinementSteps += report.refinementSteps;
+            if (status != SolveStatus::Ok) {
+                throw std::runtime_error("Failed to calculate for m=" + std::to_string(m[i]) + ": " +
+                                         MatrixOperations::StatusMessage(status));
+            }
+            columns.col(i) = coefficients;
+        }
+        return columns;
+    }
+    
+    for (int first = 0; first < count; first += MatrixOperations::BATCH_SIZE) {
+        const int batch = std::min(MatrixOperations::BATCH_SIZE, count - first);
+        const BatchSolveResult solved =
+            MatrixOperations::SolveCoefficientsBatch(&m[first], batch, plan, config_.solver);
+        for (int l = 0; l < batch; ++l) {
+            refinementSteps += solved.reports[l].refinementSteps;
+            const SolveStatus status = RejectSingularSystem(solved.reports[l].status, solved.reports[l]);
+            if (status != SolveStatus::Ok) {
+                throw std::runtime_error("Failed to calculate for m=" + std::to_string(m[first + l]) +
+                                         ": " + MatrixOperations::StatusMessage(status));
+            }
+        }
+        columns.middleCols(first, batch) = solved.coefficients.leftCols(batch);
+    }
+    return columns;
+}
+
+SolveStatus PavementCalculator::CalculateForHankelParameter(double m, 
+                                                            const AssemblyPlan& plan,
+                                                            const CalculationInput& input,
+                                                            CalculationOutput& output,
+                                                            SolveReport& report,
+                                                            double* coefficientsOut) {
+    // Solve the linear system for this Hankel parameter
+    Eigen::VectorXd coefficients;
+    const SolveStatus status = RejectSingularSystem(
+        MatrixOperations::TrySolveCoefficients(m, plan, coefficients, &report, config_.solver), report);
+    if (status != SolveStatus::Ok) {
+        return status;
+    }
+    
+    // Calculate solicitations from these coefficients
+    CalculateSolicitationsFromCoefficients(coefficients, m, input, output);
+    if (coefficientsOut) {
+        Eigen::Map<Eigen::VectorXd>(coefficientsOut, coefficients.size()) = coefficients;
+    }
+    return SolveStatus::Ok;
+}
+
+template <int LayerCount>
+SolveStatus PavementCalculator::CalculateForHankelParameterFixed(double m,
+                                                                 const AssemblyPlan& plan,
+                                                                 const CalculationInput& input,
+                                                                 CalculationOutput& output,
+                                                                 SolveReport& report,
+                                                                 double* coefficientsOut) {
+    MatrixOperations::FixedCoefficients<LayerCount> coefficients;
+    const SolveStatus status = RejectSingularSystem(
+        MatrixOperations::TrySolveCoefficientsFixed<LayerCount>(m, plan, coefficients, &report,
+                                                                config_.solver),
+        report);
+    if (status != SolveStatus::Ok) {
+        return status;
+    }
+    
+    CalculateSolicitationsFromCoefficients(coefficients, m, input, output);
+    if (coefficientsOut) {
+        Eigen::Map<MatrixOperations::FixedCoefficients<LayerCount>> out(coefficientsOut);
+        out = coefficients;
+    }
+    return SolveStatus::Ok;
 }
 
 void PavementCalculator::CalculateSolicitationsFromCoefficients(
-    const Eigen::VectorXd& coefficients,
+    const Eigen::Ref<const Eigen::VectorXd>& coefficients,
     double m,
     const CalculationInput& input,
     CalculationOutput& output) {
     
-    // Calculate interface depths
-    std::vector<double> depths;
-    depths.push_back(0.0);  // Surface
-    
-    double cumulativeDepth = 0.0;
-    for (int i = 0; i < input.layerCount - 1; ++i) {
-        cumulativeDepth += input.thicknesses[i];
-        depths.push_back(cumulativeDepth);
+    // exp(-m*h_k) of every finite layer in one vectorised call: the decay of
+    // the part of the layer solution that is evaluated at the far face
+    const int finiteLayers = std::min(input.layerCount - 1, Constants::MAX_LAYER_COUNT);
+    double decay[Constants::MAX_LAYER_COUNT];
+    for (int k = 0; k < finiteLayers; ++k) {
+        decay[k] = -m * input.thicknesses[k];
     }
+    SpecialFunctions::Exp(decay, decay, finiteLayers);
     
     int outputIndex = 0;
     
     // For each layer, calculate at top and bottom
     for (int layerIndex = 0; layerIndex < input.layerCount; ++layerIndex) {
-        // Setup layer properties
         LayerProperties props;
         props.youngModulus = input.youngModuli[layerIndex];
         props.poissonRatio = input.poissonRatios[layerIndex];
         
-        // Extract this layer's coefficients [A, B, C, D]
-        Eigen::Vector4d layerCoeffs;
-        int coeffBase = layerIndex * 4;
-        
-        for (int j = 0; j < 4; ++j) {
-            if (coeffBase + j < coefficients.size()) {
-                layerCoeffs(j) = coefficients(coeffBase + j);
-            } else {
-                layerCoeffs(j) = 0.0;
-            }
+        // This layer's coefficients [B, D, A, C]; the half-space has no A, C
+        const bool halfSpace = layerIndex == input.layerCount - 1;
+        const int coeffBase = AssemblyPlan::DownwardColumn(layerIndex);
+        Eigen::Vector4d layerCoeffs = Eigen::Vector4d::Zero();
+        layerCoeffs.head<2>() = coefficients.segment<2>(coeffBase);
+        if (!halfSpace) {
+            layerCoeffs.tail<2>() = coefficients.segment<2>(AssemblyPlan::UpwardColumn(layerIndex));
         }
         
-        // Top of layer
-        if (outputIndex < output.sigmaT.size()) {
-            double depth = depths[layerIndex];
-            auto sol = ComputeSolicitations(layerCoeffs, depth, m, props);
+        // Top of layer: the upward part has decayed over the thickness
+        if (outputIndex < static_cast<int>(output.sigmaT.size())) {
+            const SolicitationComponents sol = halfSpace
+                ? ComputeSolicitations(layerCoeffs, m, 0.0, 1.0, 0.0, 0.0, props)
+                : ComputeSolicitations(layerCoeffs, m, 0.0, 1.0,
+                                       -m * input.thicknesses[layerIndex], decay[layerIndex], props);
             
             // Accumulate contributions (Hankel transform integration)
             output.sigmaT[outputIndex] += sol.sigmaR;
@@ -175,10 +792,10 @@ void PavementCalculator::CalculateSolicitationsFromCoefficients(
             outputIndex++;
         }
         
-        // Bottom of layer (not for last layer if it's semi-infinite platform)
-        if (layerIndex < input.layerCount - 1 && outputIndex < output.sigmaT.size()) {
-            double depth = depths[layerIndex + 1];
-            auto sol = ComputeSolicitations(layerCoeffs, depth, m, props);
+        // Bottom of layer: the downward part has decayed (none for the half-space)
+        if (!halfSpace && outputIndex < static_cast<int>(output.sigmaT.size())) {
+            const SolicitationComponents sol = ComputeSolicitations(
+                layerCoeffs, m, m * input.thicknesses[layerIndex], decay[layerIndex], 0.0, 1.0, props);
             
             output.sigmaT[outputIndex] += sol.sigmaR;
             output.epsilonT[outputIndex] += sol.epsilonR;
@@ -192,55 +809,44 @@ void PavementCalculator::CalculateSolicitationsFromCoefficients(
 
 SolicitationComponents PavementCalculator::ComputeSolicitations(
     const Eigen::Vector4d& coeffs,
-    double depth,
     double m,
+    double downwardT,
+    double downwardDecay,
+    double upwardT,
+    double upwardDecay,
     const LayerProperties& props) {
     
     SolicitationComponents result;
     
-    // Extract coefficients and material properties
-    double A = coeffs(0);
-    double B = coeffs(1);
-    double C = coeffs(2);
-    double D = coeffs(3);
-    double E = props.youngModulus;
-    double nu = props.poissonRatio;
-    
-    // Compute exponential terms
-    double exp_neg = std::exp(-m * depth);
-    double exp_pos = std::exp(m * depth);
-    
-    // Prevent overflow for large arguments
-    if (m * depth > Constants::EXPONENTIAL_OVERFLOW_LIMIT) {
-        exp_pos = 0.0;
-    }
-    if (m * depth < -Constants::EXPONENTIAL_OVERFLOW_LIMIT) {
-        exp_neg = 0.0;
-    }
+    const double E = props.youngModulus;
+    const double nu = props.poissonRatio;
+    const double B = coeffs(0);
+    const double D = coeffs(1);
+    const double A = coeffs(2);
+    const double C = coeffs(3);
     
-    // Layered elastic theory formulas
-    // Displacements
-    double u_r = A * exp_neg + B * depth * exp_neg + C * exp_pos + D * depth * exp_pos;
-    double u_z = -A * exp_neg + B * (1.0 - m * depth) * exp_neg 
-                 + C * exp_pos - D * (1.0 + m * depth) * exp_pos;
+    // State (sigma_z, tau_rz, u, w) in Huang's stabilised basis
+    const Eigen::Vector4d state =
+        AssemblyPlan::DownwardBasis(nu, downwardT) * (downwardDecay * Eigen::Vector2d(B, D)) +
+        AssemblyPlan::UpwardBasis(nu, upwardT) * (upwardDecay * Eigen::Vector2d(A, C));
     
-    // Strains (simplified formulation)
-    double epsilon_r = m * (A * exp_neg - C * exp_pos);
-    double epsilon_z = -m * (A * exp_neg + C * exp_pos) 
-                       + B * m * exp_neg - D * m * exp_pos;
+    // Part of the horizontal stresses not carried by u: on the load axis the
+    // radial and tangential stresses are equal
+    const double lateral = 2.0 * nu * (C * upwardDecay - D * downwardDecay);
     
-    // Stresses from constitutive law
-    double factor = E / ((1.0 + nu) * (1.0 - 2.0 * nu));
-    result.sigmaR = factor * ((1.0 - nu) * epsilon_r + nu * epsilon_z);
-    result.sigmaZ = factor * (nu * epsilon_r + (1.0 - nu) * epsilon_z);
-    result.tauRZ = E / (2.0 * (1.0 + nu)) * m * (B * exp_neg + D * exp_pos);
+    // Stresses positive in compression
+    result.sigmaZ = state(0);
+    result.sigmaR = -(0.5 * state(2) + lateral);
+    result.tauRZ = state(1);
     
-    // Strains (convert to microstrain)
+    // Strains positive in extension (sigma_theta = sigma_r on the axis)
+    const double epsilon_z = -(result.sigmaZ - 2.0 * nu * result.sigmaR) / E;
+    const double epsilon_r = -(result.sigmaR - nu * (result.sigmaZ + result.sigmaR)) / E;
     result.epsilonR = epsilon_r * Constants::STRAIN_TO_MICROSTRAIN;
     result.epsilonZ = epsilon_z * Constants::STRAIN_TO_MICROSTRAIN;
     
-    // Deflection (convert to mm)
-    result.deflection = u_z * Constants::M_TO_MM;
+    // Deflection (positive downward) from w in units of the layer compliance
+    result.deflection = -(1.0 + nu) / E * state(3) / m * Constants::M_TO_MM;
     
     return result;
 }
@@ -1,5 +1,6 @@
 #include "PavementData.h"
 #include "Logger.h"
+#include "Constants.h"
 #include <sstream>
 #include <iomanip>
 #include <cmath>
@@ -32,9 +33,11 @@ void CalculationInput::SetDefaults() {
 
 void CalculationInput::Validate() const {
     // Layer count validation
-    if (layerCount < 2 || layerCount > 10) {
+    if (layerCount < Constants::MIN_LAYER_COUNT || layerCount > Constants::MAX_LAYER_COUNT) {
         throw std::invalid_argument(
-            "Layer count must be between 2 and 10, got: " + std::to_string(layerCount));
+            "Layer count must be between " + std::to_string(Constants::MIN_LAYER_COUNT) +
+            " and " + std::to_string(Constants::MAX_LAYER_COUNT) +
+            ", got: " + std::to_string(layerCount));
     }
     
     // Vector size validation
@@ -109,12 +112,12 @@ void CalculationInput::Validate() const {
             "Invalid wheel type: " + std::to_string(wheelType) + " (must be 1=isolated or 2=twin)");
     }
     
-    if (pressure <= 0.0 || pressure > 5.0) {
+    if (pressure <= Constants::MIN_TIRE_PRESSURE || pressure > Constants::MAX_TIRE_PRESSURE) {
         throw std::invalid_argument(
             "Invalid pressure: " + std::to_string(pressure) + " MPa (must be 0-5)");
     }
     
-    if (contactRadius <= 0.0 || contactRadius > 1.0) {
+    if (contactRadius <= Constants::MIN_CONTACT_RADIUS || contactRadius > Constants::MAX_CONTACT_RADIUS) {
         throw std::invalid_argument(
             "Invalid contact radius: " + std::to_string(contactRadius) + " m (must be 0-1)");
     }
@@ -213,6 +216,10 @@ std::string CalculationOutput::ToString() const {
            << "def=" << deflection[i] << " mm\n";
     }
     
+    ss << "  integration: error=" << std::scientific << integration.errorEstimate
+       << ", evaluations=" << integration.evaluations
+       << ", intervals=" << integration.intervals
+       << (integration.converged ? ", converged" : ", NOT converged") << "\n";
     ss << "}";
     return ss.str();
 }
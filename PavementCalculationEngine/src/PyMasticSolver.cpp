@@ -1,47 +1,68 @@
 #include "PyMasticSolver.h"
+#include "SpecialFunctions.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <queue>
 #include <stdexcept>
 #include <iostream>
+#include <utility>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-// Include Boost.Math for Bessel functions if available
-#ifdef BOOST_MATH_BESSEL_JY_HPP
-#include <boost/math/special_functions/bessel.hpp>
-#define BOOST_AVAILABLE
-#endif
+namespace {
+
+// Depth kernel terms of the response integrals: four J0 terms, then two J1 terms
+enum DepthTerm {
+    DISPLACEMENT_Z_TERM,
+    STRESS_Z_TERM,
+    STRESS_R_TERM,    // m * horizontal + lateral
+    STRESS_T_TERM,    // lateral
+    DISPLACEMENT_H_TERM,
+    HORIZONTAL_TERM,  // Divided by ro in both horizontal stresses
+    DEPTH_TERMS
+};
+constexpr int J0_TERMS = 4;
 
-// Hardcoded Bessel zeros (from PyMastic reference)
-static const double BESSEL_J0_ZEROS[] = {
-    2.40482555769577, 5.52007811028631, 8.65372791291101, 11.7915344390143, 14.9309177084878,
-    18.0710639679109, 21.2116366298793, 24.3524715307493, 27.4934791320403, 30.6346064684320,
-    33.7758202135736, 36.9170983536640, 40.0584257646282, 43.1997917131767, 46.3411883716618,
-    49.4826098973978, 52.6240518411150, 55.7655107550200, 58.9069839260809, 62.0484691902272,
-    65.1899648002069, 68.3314693298568, 71.4729816035937, 74.6145006437018, 77.7560256303881,
-    80.8975558711376, 84.0390907769382, 87.1806298436412, 90.3221726372105, 93.4637187819448,
-    96.6052679509963, 99.7468198586806, 102.888374254195, 106.029930916452, 109.171489649805,
-    112.313050280495, 115.454612653667, 118.596176630873, 121.737742087951, 124.879308913233,
-    128.020877006008, 131.162446275214, 134.304016638305, 137.445588020284, 140.587160352854,
-    143.728733573690, 146.870307625797, 150.011882456955, 153.153458019228, 156.295034268534
+// Responses needing each term; strains use all three stresses
+constexpr unsigned TERM_USERS[DEPTH_TERMS] = {
+    PyMasticSolver::DisplacementZ,
+    PyMasticSolver::StressZ | PyMasticSolver::Strains,
+    PyMasticSolver::StressR | PyMasticSolver::Strains,
+    PyMasticSolver::StressT | PyMasticSolver::Strains,
+    PyMasticSolver::DisplacementH,
+    PyMasticSolver::StressR | PyMasticSolver::StressT | PyMasticSolver::Strains
+};
+
+// Block of each requested term in its J0 or J1 kernel matrix (-1 if unused)
+struct TermLayout {
+    int block[DEPTH_TERMS];
+    int j0_blocks = 0;
+    int j1_blocks = 0;
+    
+    explicit TermLayout(unsigned responses) {
+        for (int t = 0; t < DEPTH_TERMS; ++t) {
+            int& blocks = t < J0_TERMS ? j0_blocks : j1_blocks;
+            block[t] = (TERM_USERS[t] & responses) != 0 ? blocks++ : -1;
+        }
+    }
+    bool Uses(DepthTerm term) const { return block[term] >= 0; }
 };
 
-static const double BESSEL_J1_ZEROS[] = {
-    3.83170597020751, 7.01558666981562, 10.1734681350627, 13.3236919363142, 16.4706300508776,
-    19.6158585104682, 22.7600843805928, 25.9036720876184, 29.0468285349169, 32.1896799109744,
-    35.3323075500839, 38.4747662347716, 41.6170942128145, 44.759318997652, 47.9014608871855,
-    51.0435351835715, 54.1855536410613, 57.3275254379010, 60.4694578453475, 63.6113566984812,
-    66.7532267340985, 69.8950718374958, 73.0368952255738, 76.1786995846415, 79.3204871754763,
-    82.4622599143736, 85.6040194363502, 88.7457671449263, 91.8875042516950, 95.0292318080447,
-    98.1709507307908, 101.312661823039, 104.454365791283, 107.596063259509, 110.737754780899,
-    113.879440847595, 117.021121898892, 120.162798328149, 123.304470488636, 126.446138698517,
-    129.587803245104, 132.729464388510, 135.871122364789, 139.012777388660, 142.154429655859,
-    145.296079345196, 148.437726620342, 151.579371631401, 154.721014516286, 157.862655401930
+// Ascending sequence zero_k / scale, read lazily by the k-way merge
+struct ScaledZeros {
+    double value;
+    int sequence;
+    int index;
+    bool operator>(const ScaledZeros& other) const { return value > other.value; }
 };
 
-static const int BESSEL_ZEROS_COUNT = 50;
+} // namespace
 
 bool PyMasticSolver::Input::Validate() const {
     if (q_kpa <= 0 || a_m <= 0) return false;
@@ -58,19 +79,41 @@ bool PyMasticSolver::Input::Validate() const {
     for (double E : E_moduli) if (E <= 0) return false;
     for (double nu : nu_poisson) if (nu < 0 || nu >= 0.5) return false;
     for (double H : H_thicknesses) if (H <= 0) return false;
+    if (iterations < 1) return false;
+    
+    Inverser method;
+    if (!ParseInverser(inverser, method)) return false;
+    if (responses == 0 || (responses & ~static_cast<unsigned>(AllResponses)) != 0) return false;
     
     return true;
 }
 
-void PyMasticSolver::Output::Initialize(int n_z, int n_x) {
-    displacement_z = Eigen::MatrixXd::Zero(n_z, n_x);
-    displacement_h = Eigen::MatrixXd::Zero(n_z, n_x);
-    stress_z = Eigen::MatrixXd::Zero(n_z, n_x);
-    stress_r = Eigen::MatrixXd::Zero(n_z, n_x);
-    stress_t = Eigen::MatrixXd::Zero(n_z, n_x);
-    strain_z = Eigen::MatrixXd::Zero(n_z, n_x);
-    strain_r = Eigen::MatrixXd::Zero(n_z, n_x);
-    strain_t = Eigen::MatrixXd::Zero(n_z, n_x);
+bool PyMasticSolver::ParseInverser(const std::string& name, Inverser& inverser) {
+    static const std::pair<const char*, Inverser> names[] = {
+        {"solve", Inverser::Solve}, {"inv", Inverser::Inv}, {"pinv", Inverser::Pinv},
+        {"lu", Inverser::Lu}, {"svd", Inverser::Svd}};
+    for (const auto& entry : names) {
+        if (name == entry.first) {
+            inverser = entry.second;
+            return true;
+        }
+    }
+    return false;
+}
+
+void PyMasticSolver::Output::Initialize(int n_z, int n_x, unsigned requested) {
+    responses = requested;
+    const std::pair<Eigen::MatrixXd*, Response> matrices[] = {
+        {&displacement_z, DisplacementZ}, {&displacement_h, DisplacementH},
+        {&stress_z, StressZ}, {&stress_r, StressR}, {&stress_t, StressT},
+        {&strain_z, StrainZ}, {&strain_r, StrainR}, {&strain_t, StrainT}};
+    for (const auto& matrix : matrices) {
+        if (Has(matrix.second)) {
+            *matrix.first = Eigen::MatrixXd::Zero(n_z, n_x);
+        } else {
+            matrix.first->resize(0, 0);
+        }
+    }
 }
 
 bool PyMasticSolver::Output::IsValid() const {
@@ -86,12 +129,13 @@ PyMasticSolver::Output PyMasticSolver::Compute(const Input& input) {
     
     Output output;
     output.Initialize(static_cast<int>(input.z_depths.size()), 
-                     static_cast<int>(input.x_offsets.size()));
+                     static_cast<int>(input.x_offsets.size()), input.responses);
     
     try {
         // Setup Hankel integration grid
-        std::vector<double> m_values, ft_weights;
-        SetupHankelGrid(input, m_values, ft_weights);
+        std::shared_ptr<const HankelGrid> grid = AcquireHankelGrid(input);
+        const std::vector<double>& m_values = grid->m_values;
+        const std::vector<double>& ft_weights = grid->ft_weights;
         
         // Initialize state vector coefficient matrices
         int n_m = static_cast<int>(m_values.size());
@@ -106,7 +150,8 @@ PyMasticSolver::Output PyMasticSolver::Compute(const Input& input) {
         PropagateStateVector(input, m_values, A, B, C, D);
         
         // Compute final responses
-        ComputeResponses(input, m_values, ft_weights, A, B, C, D, output);
+        ComputeResponses(input, m_values, BuildRadialKernels(input, m_values, ft_weights),
+                         A, B, C, D, output);
         
         return output;
         
@@ -116,66 +161,293 @@ PyMasticSolver::Output PyMasticSolver::Compute(const Input& input) {
     }
 }
 
-std::vector<double> PyMasticSolver::ComputeBesselZeros(int order, int count) {
-    std::vector<double> zeros;
-    zeros.reserve(count);
+PyMasticSolver::Output PyMasticSolver::ComputeLive(const Input& input) {
+    if (!input.Validate()) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
+    
+    live_ = LiveState();
+    LiveState state;
+    state.input = input;
+    state.grid = AcquireHankelGrid(input);
+    const std::vector<double>& m_values = state.grid->m_values;
+    state.lamda_bc = ComputeLamdaValues(input.H_thicknesses);
+    state.R = ComputeElasticRatios(input);
+    state.radial = BuildRadialKernels(input, m_values, state.grid->ft_weights);
+    
+    const int n_m = static_cast<int>(m_values.size());
+    const int n_layers = static_cast<int>(input.E_moduli.size());
+    const int n_interfaces = n_layers - 1;
+    const InterfaceSolver solve_matrix = SelectInterfaceSolver(input);
+    
+    state.leaves = 1;
+    while (state.leaves < n_interfaces) state.leaves *= 2;
+    const int tree_size = 2 * state.leaves;
+    state.trees.assign(static_cast<size_t>(n_m) * tree_size, Eigen::Matrix4d::Identity());
+    
+    state.A = Eigen::MatrixXd::Zero(n_m, n_layers);
+    state.B = Eigen::MatrixXd::Zero(n_m, n_layers);
+    state.C = Eigen::MatrixXd::Zero(n_m, n_layers);
+    state.D = Eigen::MatrixXd::Zero(n_m, n_layers);
+    
+    ParallelChunks(n_m, 8, input.threads, [&](int first, int last) {
+        for (int j = first; j < last; ++j) {
+            double m = m_values[j];
+            Eigen::Matrix4d* tree = state.trees.data() + static_cast<size_t>(j) * tree_size;
+            Eigen::Matrix4d* solved = tree + state.leaves;
+            
+            for (int i = 0; i < n_interfaces; ++i) {
+                solved[i] = solve_matrix(BuildLeftMatrix(i, m, input, state.lamda_bc),
+                                         BuildRightMatrix(i, m, input, state.lamda_bc, state.R));
+            }
+            for (int v = state.leaves - 1; v >= 1; --v) {
+                tree[v] = tree[2 * v] * tree[2 * v + 1];
+            }
+            
+            BackPropagate(j, m, input, state.lamda_bc, tree[1], solved,
+                          state.A, state.B, state.C, state.D);
+        }
+    });
     
-    const double* source = (order == 0) ? BESSEL_J0_ZEROS : BESSEL_J1_ZEROS;
-    int available = std::min(count, BESSEL_ZEROS_COUNT);
+    Output output;
+    output.Initialize(static_cast<int>(input.z_depths.size()),
+                     static_cast<int>(input.x_offsets.size()), input.responses);
+    ComputeResponses(input, m_values, state.radial,
+                     state.A, state.B, state.C, state.D, output);
+    
+    state.active = true;
+    state.rebuilt_interfaces = n_interfaces;
+    live_ = std::move(state);
+    return output;
+}
+
+PyMasticSolver::Output PyMasticSolver::UpdateLayerModulus(int layer, double E_modulus, double nu) {
+    if (!live_.active) {
+        throw std::logic_error("UpdateLayerModulus requires a live structure (ComputeLive)");
+    }
+    const int n_layers = static_cast<int>(live_.input.E_moduli.size());
+    if (layer < 0 || layer >= n_layers) {
+        throw std::invalid_argument("Layer index out of range: " + std::to_string(layer));
+    }
+    Input edited = live_.input;
+    edited.E_moduli[layer] = E_modulus;
+    edited.nu_poisson[layer] = nu;
+    if (!edited.Validate()) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
     
-    for (int i = 0; i < available; ++i) {
-        zeros.push_back(source[i]);
+    try {
+        live_.input = std::move(edited);
+        const Input& input = live_.input;
+        live_.R = ComputeElasticRatios(input);
+        
+        // Layer k enters the right matrix of interface k-1 and the left matrix of interface k
+        std::vector<int> interfaces;
+        if (layer > 0) interfaces.push_back(layer - 1);
+        if (layer < n_layers - 1) interfaces.push_back(layer);
+        
+        const std::vector<double>& m_values = live_.grid->m_values;
+        const int n_m = static_cast<int>(m_values.size());
+        const int tree_size = 2 * live_.leaves;
+        const InterfaceSolver solve_matrix = SelectInterfaceSolver(input);
+        ParallelChunks(n_m, 8, input.threads, [&](int first, int last) {
+            for (int j = first; j < last; ++j) {
+                double m = m_values[j];
+                Eigen::Matrix4d* tree = live_.trees.data() + static_cast<size_t>(j) * tree_size;
+                Eigen::Matrix4d* solved = tree + live_.leaves;
+                
+                for (int i : interfaces) {
+                    solved[i] = solve_matrix(BuildLeftMatrix(i, m, input, live_.lamda_bc),
+                                             BuildRightMatrix(i, m, input, live_.lamda_bc, live_.R));
+                }
+                RefreshCascade(tree, live_.leaves, interfaces);
+                
+                BackPropagate(j, m, input, live_.lamda_bc, tree[1], solved,
+                              live_.A, live_.B, live_.C, live_.D);
+            }
+        });
+        
+        Output output;
+        output.Initialize(static_cast<int>(input.z_depths.size()),
+                         static_cast<int>(input.x_offsets.size()), input.responses);
+        ComputeResponses(input, m_values, live_.radial,
+                         live_.A, live_.B, live_.C, live_.D, output);
+        
+        live_.rebuilt_interfaces = static_cast<int>(interfaces.size());
+        return output;
+        
+    } catch (...) {
+        live_ = LiveState();
+        throw;
+    }
+}
+
+PyMasticSolver::Output PyMasticSolver::UpdateLayerThickness(int layer, double thickness) {
+    if (!live_.active) {
+        throw std::logic_error("UpdateLayerThickness requires a live structure (ComputeLive)");
+    }
+    if (layer < 0 || layer >= static_cast<int>(live_.input.H_thicknesses.size())) {
+        throw std::invalid_argument("Layer index out of range: " + std::to_string(layer));
+    }
+    Input edited = live_.input;
+    edited.H_thicknesses[layer] = thickness;
+    if (!edited.Validate()) {
+        throw std::invalid_argument("Invalid input parameters");
     }
     
-    return zeros;
+    // Every normalised depth and m value moves with the total thickness
+    return ComputeLive(edited);
 }
 
-double PyMasticSolver::BesselJ0(double x) {
-#ifdef BOOST_AVAILABLE
-    return boost::math::cyl_bessel_j(0, x);
-#else
-    // Series expansion for small x, asymptotic for large x
-    if (std::abs(x) < 8.0) {
-        // Series: J0(x) = sum_{k=0}^∞ (-1)^k / (k!)^2 * (x/2)^{2k}
-        double sum = 1.0;
-        double term = 1.0;
-        double x_half_sq = (x * x) / 4.0;
-        
-        for (int k = 1; k <= 20; ++k) {
-            term *= -x_half_sq / (k * k);
-            sum += term;
-            if (std::abs(term) < 1e-15) break;
+const PyMasticSolver::Input& PyMasticSolver::LiveInput() const {
+    if (!live_.active) {
+        throw std::logic_error("No live structure (ComputeLive)");
+    }
+    return live_.input;
+}
+
+void PyMasticSolver::ParallelChunks(int count, int grain, int threads,
+                                    const std::function<void(int, int)>& body) {
+    if (threads <= 0) {
+        threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    const int chunks = std::min((count + grain - 1) / grain, 4 * threads);
+    if (threads == 1 || chunks < 2) {
+        body(0, count);
+        return;
+    }
+    if (!pool_ || pool_->GetThreadCount() != threads) {
+        pool_ = std::make_shared<Pavement::ThreadPool>(threads);
+    }
+    
+    // Contiguous, nearly equal chunks; a few per thread to even out the load
+    pool_->ParallelFor(chunks, [&](int c) {
+        const int first = static_cast<int>(static_cast<long long>(count) * c / chunks);
+        const int last = static_cast<int>(static_cast<long long>(count) * (c + 1) / chunks);
+        body(first, last);
+    });
+}
+
+void PyMasticSolver::RefreshCascade(Eigen::Matrix4d* tree, int leaves,
+                                    const std::vector<int>& interfaces) {
+    // All leaves sit on one level, so the parents of an ascending set stay ascending
+    std::vector<int> nodes;
+    for (int i : interfaces) {
+        nodes.push_back(leaves + i);
+    }
+    while (!nodes.empty() && nodes.front() > 1) {
+        std::vector<int> parents;
+        for (int v : nodes) {
+            int parent = v / 2;
+            if (parents.empty() || parents.back() != parent) {
+                parents.push_back(parent);
+                tree[parent] = tree[2 * parent] * tree[2 * parent + 1];
+            }
         }
-        return sum;
-    } else {
-        // Asymptotic form: J0(x) ≈ sqrt(2/(πx)) * cos(x - π/4)
-        return std::sqrt(2.0 / (M_PI * x)) * std::cos(x - M_PI / 4.0);
+        nodes.swap(parents);
     }
-#endif
+}
+
+std::vector<double> PyMasticSolver::ComputeBesselZeros(int order, int count) {
+    return Pavement::SpecialFunctions::BesselZeros(order, count);
+}
+
+double PyMasticSolver::BesselJ0(double x) {
+    return Pavement::SpecialFunctions::BesselJ0(x);
 }
 
 double PyMasticSolver::BesselJ1(double x) {
-#ifdef BOOST_AVAILABLE
-    return boost::math::cyl_bessel_j(1, x);
-#else
-    // Series expansion for small x, asymptotic for large x
-    if (std::abs(x) < 8.0) {
-        // Series: J1(x) = (x/2) * sum_{k=0}^∞ (-1)^k / (k!(k+1)!) * (x/2)^{2k}
-        double sum = 1.0;
-        double term = 1.0;
-        double x_half_sq = (x * x) / 4.0;
-        
-        for (int k = 1; k <= 20; ++k) {
-            term *= -x_half_sq / (k * (k + 1));
-            sum += term;
-            if (std::abs(term) < 1e-15) break;
+    return Pavement::SpecialFunctions::BesselJ1(x);
+}
+
+// Least recently used grids first; keys hold the exact doubles the grid depends on
+struct PyMasticSolver::GridCache {
+    struct Entry {
+        std::vector<double> key;
+        std::uint64_t hash;
+        std::shared_ptr<const HankelGrid> grid;
+    };
+    
+    std::mutex mutex;
+    std::list<Entry> entries;
+    std::size_t capacity = 64;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+};
+
+PyMasticSolver::GridCache& PyMasticSolver::SharedGridCache() {
+    static GridCache cache;
+    return cache;
+}
+
+PyMasticSolver::GridCacheStats PyMasticSolver::GetGridCacheStats() {
+    GridCache& cache = SharedGridCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    GridCacheStats stats;
+    stats.hits = cache.hits;
+    stats.misses = cache.misses;
+    stats.entries = cache.entries.size();
+    stats.capacity = cache.capacity;
+    return stats;
+}
+
+void PyMasticSolver::ResetGridCache(std::size_t capacity) {
+    GridCache& cache = SharedGridCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+    cache.capacity = capacity;
+    cache.hits = 0;
+    cache.misses = 0;
+}
+
+std::shared_ptr<const PyMasticSolver::HankelGrid> PyMasticSolver::AcquireHankelGrid(const Input& input) {
+    // Key: everything SetupHankelGrid reads, computed with the same arithmetic
+    double sumH = 0.0;
+    for (double h : input.H_thicknesses) sumH += h;
+    std::vector<double> key;
+    key.reserve(input.x_offsets.size() + 2);
+    key.push_back(static_cast<double>(input.iterations));
+    key.push_back(input.a_m / sumH);
+    for (double x : input.x_offsets) {
+        if (x == 0.0) x = 1e-6;
+        key.push_back(x / sumH);
+    }
+    std::uint64_t hash = 14695981039346656037ull;  // FNV-1a over the bit patterns
+    for (double value : key) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        hash = (hash ^ bits) * 1099511628211ull;
+    }
+    
+    GridCache& cache = SharedGridCache();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        for (auto it = cache.entries.begin(); it != cache.entries.end(); ++it) {
+            if (it->hash == hash && it->key == key) {
+                ++cache.hits;
+                cache.entries.splice(cache.entries.begin(), cache.entries, it);
+                return it->grid;
+            }
         }
-        return (x / 2.0) * sum;
-    } else {
-        // Asymptotic form: J1(x) ≈ sqrt(2/(πx)) * cos(x - 3π/4)
-        return std::sqrt(2.0 / (M_PI * x)) * std::cos(x - 3.0 * M_PI / 4.0);
+        ++cache.misses;
     }
-#endif
+    
+    // Build outside the lock; a concurrent miss on the same key builds an identical grid
+    auto grid = std::make_shared<HankelGrid>();
+    SetupHankelGrid(input, grid->m_values, grid->ft_weights);
+    
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (cache.capacity > 0) {
+        auto same = std::find_if(cache.entries.begin(), cache.entries.end(),
+                                 [&](const GridCache::Entry& e) { return e.hash == hash && e.key == key; });
+        if (same == cache.entries.end()) {
+            cache.entries.push_front({std::move(key), hash, grid});
+            while (cache.entries.size() > cache.capacity) {
+                cache.entries.pop_back();
+            }
+        }
+    }
+    return grid;
 }
 
 void PyMasticSolver::SetupHankelGrid(const Input& input, 
@@ -188,48 +460,51 @@ void PyMasticSolver::SetupHankelGrid(const Input& input,
     
     double alpha = input.a_m / sumH;
     
-    // Get Bessel zeros (hardcoded arrays from Python PyMastic)
-    std::vector<double> j0_zeros(BESSEL_J0_ZEROS, BESSEL_J0_ZEROS + BESSEL_ZEROS_COUNT);
-    std::vector<double> j1_zeros(BESSEL_J1_ZEROS, BESSEL_J1_ZEROS + BESSEL_ZEROS_COUNT);
-    
-    // Scale zeros by radial offsets and radius (Python lines 95-98)
-    // firstKindZeroOrder = firstKindZeroOrder / ro[:, None]
-    // firstKindFirstOrder = firstKindFirstOrder / alpha
-    std::vector<double> scaled_j0, scaled_j1;
-    
-    for (double x : input.x_offsets) {
+    // Breakpoints (Python lines 95-100, BesselZeros[:iteration + 3]):
+    // 0 and the smallest distinct values of j0_k / ro for every offset and
+    // j1_k / alpha. No sequence contributes more than iterations + 2 values.
+    const int breakpoint_count = input.iterations + 3;
+    const std::vector<double> j0_zeros = ComputeBesselZeros(0, breakpoint_count);
+    const std::vector<double> j1_zeros = ComputeBesselZeros(1, breakpoint_count);
+    
+    // Sequence j < n_x: j0 zeros / ro_j; sequence n_x: j1 zeros / alpha
+    const int n_x = static_cast<int>(input.x_offsets.size());
+    std::vector<double> scale(n_x + 1);
+    for (int j = 0; j < n_x; ++j) {
+        double x = input.x_offsets[j];
         if (x == 0.0) x = 1e-6; // Avoid singularity at center
-        double ro = x / sumH;
-        for (double zero : j0_zeros) {
-            scaled_j0.push_back(zero / ro);
-        }
+        scale[j] = x / sumH;
     }
-    
-    for (double zero : j1_zeros) {
-        scaled_j1.push_back(zero / alpha);
+    scale[n_x] = alpha;
+    auto zero_of = [&](int sequence, int index) {
+        return (sequence < n_x ? j0_zeros[index] : j1_zeros[index]) / scale[sequence];
+    };
+    
+    std::priority_queue<ScaledZeros, std::vector<ScaledZeros>, std::greater<ScaledZeros>> heads;
+    for (int sequence = 0; sequence <= n_x; ++sequence) {
+        heads.push({zero_of(sequence, 0), sequence, 0});
     }
     
-    // Combine and sort all zeros (Python lines 99-100)
-    // BesselZeros = np.hstack((np.array([0]), firstKindZeroOrder.flatten(), firstKindFirstOrder.flatten()))
     std::vector<double> all_zeros;
+    all_zeros.reserve(breakpoint_count);
     all_zeros.push_back(0.0); // Add zero first
-    all_zeros.insert(all_zeros.end(), scaled_j0.begin(), scaled_j0.end());
-    all_zeros.insert(all_zeros.end(), scaled_j1.begin(), scaled_j1.end());
-    
-    std::sort(all_zeros.begin(), all_zeros.end());
-    all_zeros.erase(std::unique(all_zeros.begin(), all_zeros.end()), all_zeros.end());
+    while (static_cast<int>(all_zeros.size()) < breakpoint_count && !heads.empty()) {
+        ScaledZeros head = heads.top();
+        heads.pop();
+        if (head.value != all_zeros.back()) {
+            all_zeros.push_back(head.value);
+        }
+        if (++head.index < breakpoint_count) {
+            head.value = zero_of(head.sequence, head.index);
+            heads.push(head);
+        }
+    }
     
     // Ensure we have at least 3 zeros for interval generation
     if (all_zeros.size() < 3) {
         throw std::runtime_error("Insufficient Bessel zeros for Hankel integration");
     }
     
-    // Limit to iteration count (Python: BesselZeros[3:iteration])
-    int max_zeros = std::min(input.iterations + 3, static_cast<int>(all_zeros.size()));
-    if (max_zeros > 3) {
-        all_zeros.resize(max_zeros);
-    }
-    
     // Setup integration intervals with specific spacing (Python lines 101-106)
     // D1 = (BesselZeros[1] - BesselZeros[0]) / 6 - 0.00001
     // D2 = (BesselZeros[2] - BesselZeros[1]) / 2 - 0.00001
@@ -324,6 +599,15 @@ std::vector<double> PyMasticSolver::ComputeLamdaValues(const std::vector<double>
     return lamda;
 }
 
+std::vector<double> PyMasticSolver::ComputeElasticRatios(const Input& input) {
+    std::vector<double> R;
+    for (size_t i = 0; i + 1 < input.E_moduli.size(); ++i) {
+        R.push_back(input.E_moduli[i] / input.E_moduli[i + 1] *
+                    (1 + input.nu_poisson[i + 1]) / (1 + input.nu_poisson[i]));
+    }
+    return R;
+}
+
 int PyMasticSolver::FindLayerIndex(double depth, const std::vector<double>& lamda) {
     for (size_t i = 1; i < lamda.size(); ++i) {
         if (depth <= lamda[i]) {
@@ -380,31 +664,41 @@ Eigen::Matrix4d PyMasticSolver::BuildRightMatrix(int i, double m, const Input& i
     return right;
 }
 
+template <PyMasticSolver::Inverser Method>
 Eigen::Matrix4d PyMasticSolver::SolveMatrix(const Eigen::Matrix4d& left_matrix,
-                                           const Eigen::Matrix4d& right_matrix,
-                                           const std::string& inverser) {
-    try {
-        if (inverser == "solve") {
-            return left_matrix.colPivHouseholderQr().solve(right_matrix);
-        } else if (inverser == "inv") {
-            return left_matrix.inverse() * right_matrix;
-        } else if (inverser == "pinv") {
-            Eigen::JacobiSVD<Eigen::Matrix4d> svd(left_matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
-            return svd.solve(right_matrix);
-        } else if (inverser == "lu") {
-            return left_matrix.partialPivLu().solve(right_matrix);
-        } else if (inverser == "svd") {
-            Eigen::JacobiSVD<Eigen::Matrix4d> svd(left_matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
-            return svd.solve(right_matrix);
+                                           const Eigen::Matrix4d& right_matrix) noexcept {
+    Eigen::Matrix4d solved;
+    if constexpr (Method == Inverser::Solve) {
+        solved = left_matrix.colPivHouseholderQr().solve(right_matrix);
+    } else if constexpr (Method == Inverser::Inv) {
+        solved = left_matrix.inverse() * right_matrix;
+    } else if constexpr (Method == Inverser::Lu) {
+        solved = left_matrix.partialPivLu().solve(right_matrix);
+    }
+    if constexpr (Method != Inverser::Pinv && Method != Inverser::Svd) {
+        if (solved.allFinite()) {
+            return solved;
         }
-    } catch (...) {
-        // Fallback to pseudo-inverse on numerical issues
-        std::cerr << "Matrix solver failed, using pseudo-inverse" << std::endl;
-        Eigen::JacobiSVD<Eigen::Matrix4d> svd(left_matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
-        return svd.solve(right_matrix);
     }
     
-    throw std::invalid_argument("Unknown matrix inverser: " + inverser);
+    // Pseudo-inverse, also the fallback for a singular left matrix
+    Eigen::JacobiSVD<Eigen::Matrix4d> svd(left_matrix, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    return svd.solve(right_matrix);
+}
+
+PyMasticSolver::InterfaceSolver PyMasticSolver::SelectInterfaceSolver(const Input& input) {
+    Inverser method;
+    if (!ParseInverser(input.inverser, method)) {
+        throw std::invalid_argument("Unknown matrix inverser: " + input.inverser);
+    }
+    switch (method) {
+        case Inverser::Solve: return &PyMasticSolver::SolveMatrix<Inverser::Solve>;
+        case Inverser::Inv: return &PyMasticSolver::SolveMatrix<Inverser::Inv>;
+        case Inverser::Pinv: return &PyMasticSolver::SolveMatrix<Inverser::Pinv>;
+        case Inverser::Lu: return &PyMasticSolver::SolveMatrix<Inverser::Lu>;
+        case Inverser::Svd: return &PyMasticSolver::SolveMatrix<Inverser::Svd>;
+    }
+    return &PyMasticSolver::SolveMatrix<Inverser::Solve>;
 }
 
 void PyMasticSolver::PropagateStateVector(const Input& input,
@@ -416,84 +710,145 @@ void PyMasticSolver::PropagateStateVector(const Input& input,
     std::vector<double> lamda_bc = ComputeLamdaValues(input.H_thicknesses);
     
     // Compute elastic ratios
-    std::vector<double> R;
-    for (int i = 0; i < n_layers - 1; ++i) {
-        R.push_back(input.E_moduli[i] / input.E_moduli[i + 1] * 
-                    (1 + input.nu_poisson[i + 1]) / (1 + input.nu_poisson[i]));
+    std::vector<double> R = ComputeElasticRatios(input);
+    
+    // Solved interface matrices for every (m, interface), built once by the
+    // forward cascade and reused by the back-propagation
+    const int n_interfaces = n_layers - 1;
+    std::vector<Eigen::Matrix4d, Eigen::aligned_allocator<Eigen::Matrix4d>> solved_interfaces(
+        m_values.size() * n_interfaces);
+    const InterfaceSolver solve_matrix = SelectInterfaceSolver(input);
+    
+    // Each m fills its own slice of solved_interfaces and its own row of A-D
+    ParallelChunks(static_cast<int>(m_values.size()), 8, input.threads, [&](int first, int last) {
+        for (int j = first; j < last; ++j) {
+            double m = m_values[j];
+            Eigen::Matrix4d* solved = solved_interfaces.data() + static_cast<size_t>(j) * n_interfaces;
+            
+            // Build cascade matrix multiplication (simplified approach)
+            Eigen::Matrix4d cascade = Eigen::Matrix4d::Identity();
+            
+            for (int i = 0; i < n_interfaces; ++i) {
+                Eigen::Matrix4d left = BuildLeftMatrix(i, m, input, lamda_bc);
+                Eigen::Matrix4d right = BuildRightMatrix(i, m, input, lamda_bc, R);
+                solved[i] = solve_matrix(left, right);
+                cascade = cascade * solved[i];
+            }
+            
+            BackPropagate(j, m, input, lamda_bc, cascade, solved, A, B, C, D);
+        }
+    });
+}
+
+void PyMasticSolver::BackPropagate(int j, double m, const Input& input,
+                                   const std::vector<double>& lamda_bc,
+                                   const Eigen::Matrix4d& cascade,
+                                   const Eigen::Matrix4d* solved,
+                                   Eigen::MatrixXd& A, Eigen::MatrixXd& B,
+                                   Eigen::MatrixXd& C, Eigen::MatrixXd& D) {
+    int n_layers = static_cast<int>(input.E_moduli.size());
+    
+    // Surface boundary conditions (PyMastic Method 1)
+    Eigen::Matrix2d surface_left;
+    surface_left << std::exp(-m * lamda_bc[0]), 1,
+                    std::exp(-m * lamda_bc[0]), -1;
+    
+    Eigen::Matrix2d surface_right;
+    surface_right << -(1 - 2 * input.nu_poisson[0]) * std::exp(-m * lamda_bc[0]), 1 - 2 * input.nu_poisson[0],
+                     2 * input.nu_poisson[0] * std::exp(-m * lamda_bc[0]), 2 * input.nu_poisson[0];
+    
+    // Combine surface matrices with cascade (following PyMastic lines 236-245)
+    Eigen::Matrix<double, 2, 4> combined_surface;
+    combined_surface.block<2, 2>(0, 0) = surface_left;
+    combined_surface.block<2, 2>(0, 2) = surface_right;
+    
+    // Extract B_n, D_n columns from cascade
+    Eigen::Matrix<double, 4, 2> bn_dn_matrix = cascade.block<4, 2>(0, 1); // Columns 1 and 3 (B and D)
+    bn_dn_matrix.col(1) = cascade.col(3);
+    
+    Eigen::Matrix2d final_system = combined_surface * bn_dn_matrix;
+    
+    Eigen::Vector2d rhs;
+    rhs << 1, 0;
+    
+    Eigen::Vector2d bn_dn = final_system.colPivHouseholderQr().solve(rhs);
+    if (!bn_dn.allFinite()) {
+        // Fallback to pseudo-inverse
+        Eigen::JacobiSVD<Eigen::Matrix2d> svd(final_system, Eigen::ComputeFullU | Eigen::ComputeFullV);
+        bn_dn = svd.solve(rhs);
     }
     
-    for (size_t j = 0; j < m_values.size(); ++j) {
-        double m = m_values[j];
-        
-        // Build cascade matrix multiplication (simplified approach)
-        Eigen::Matrix4d cascade = Eigen::Matrix4d::Identity();
-        
-        for (int i = 0; i < n_layers - 1; ++i) {
-            Eigen::Matrix4d left = BuildLeftMatrix(i, m, input, lamda_bc);
-            Eigen::Matrix4d right = BuildRightMatrix(i, m, input, lamda_bc, R);
-            Eigen::Matrix4d solved = SolveMatrix(left, right, input.inverser);
-            cascade = cascade * solved;
-        }
-        
-        // Surface boundary conditions (PyMastic Method 1)
-        Eigen::Matrix2d surface_left;
-        surface_left << std::exp(-m * lamda_bc[0]), 1,
-                        std::exp(-m * lamda_bc[0]), -1;
-        
-        Eigen::Matrix2d surface_right;
-        surface_right << -(1 - 2 * input.nu_poisson[0]) * std::exp(-m * lamda_bc[0]), 1 - 2 * input.nu_poisson[0],
-                         2 * input.nu_poisson[0] * std::exp(-m * lamda_bc[0]), 2 * input.nu_poisson[0];
-        
-        // Combine surface matrices with cascade (following PyMastic lines 236-245)
-        Eigen::Matrix<double, 2, 4> combined_surface;
-        combined_surface.block<2, 2>(0, 0) = surface_left;
-        combined_surface.block<2, 2>(0, 2) = surface_right;
-        
-        // Extract B_n, D_n columns from cascade
-        Eigen::Matrix<double, 4, 2> bn_dn_matrix = cascade.block<4, 2>(0, 1); // Columns 1 and 3 (B and D)
-        bn_dn_matrix.col(1) = cascade.col(3);
-        
-        Eigen::Matrix2d final_system = combined_surface * bn_dn_matrix;
-        
-        Eigen::Vector2d rhs;
-        rhs << 1, 0;
-        
-        Eigen::Vector2d bn_dn;
-        try {
-            bn_dn = final_system.colPivHouseholderQr().solve(rhs);
-        } catch (...) {
-            // Fallback to pseudo-inverse
-            Eigen::JacobiSVD<Eigen::Matrix2d> svd(final_system, Eigen::ComputeFullU | Eigen::ComputeFullV);
-            bn_dn = svd.solve(rhs);
-        }
-        
-        // Set bottom layer coefficients
-        B(j, n_layers - 1) = bn_dn(0);
-        D(j, n_layers - 1) = bn_dn(1);
-        A(j, n_layers - 1) = 0.0; // PyMastic assumption
-        C(j, n_layers - 1) = 0.0; // PyMastic assumption
-        
-        // Back-propagate to get all layer coefficients
-        Eigen::Vector4d current_bc;
-        current_bc << A(j, n_layers - 1), B(j, n_layers - 1), C(j, n_layers - 1), D(j, n_layers - 1);
-        
-        for (int i = n_layers - 2; i >= 0; --i) {
-            Eigen::Matrix4d left = BuildLeftMatrix(i, m, input, lamda_bc);
-            Eigen::Matrix4d right = BuildRightMatrix(i, m, input, lamda_bc, R);
-            Eigen::Matrix4d solved = SolveMatrix(left, right, input.inverser);
-            
-            current_bc = solved * current_bc;
-            A(j, i) = current_bc(0);
-            B(j, i) = current_bc(1);
-            C(j, i) = current_bc(2);
-            D(j, i) = current_bc(3);
+    // Set bottom layer coefficients
+    B(j, n_layers - 1) = bn_dn(0);
+    D(j, n_layers - 1) = bn_dn(1);
+    A(j, n_layers - 1) = 0.0; // PyMastic assumption
+    C(j, n_layers - 1) = 0.0; // PyMastic assumption
+    
+    // Back-propagate to get all layer coefficients
+    Eigen::Vector4d current_bc;
+    current_bc << A(j, n_layers - 1), B(j, n_layers - 1), C(j, n_layers - 1), D(j, n_layers - 1);
+    
+    for (int i = n_layers - 2; i >= 0; --i) {
+        current_bc = solved[i] * current_bc;
+        A(j, i) = current_bc(0);
+        B(j, i) = current_bc(1);
+        C(j, i) = current_bc(2);
+        D(j, i) = current_bc(3);
+    }
+}
+
+PyMasticSolver::RadialKernels PyMasticSolver::BuildRadialKernels(const Input& input,
+                                                                const std::vector<double>& m_values,
+                                                                const std::vector<double>& ft_weights) {
+    double sumH = 0.0;
+    for (double h : input.H_thicknesses) sumH += h;
+    double alpha = input.a_m / sumH;
+    
+    const int n_m = static_cast<int>(m_values.size());
+    const int n_x = static_cast<int>(input.x_offsets.size());
+    
+    // Radial kernels, n_m x n_x, one vectorised Bessel call per column
+    const TermLayout layout(input.responses);
+    RadialKernels radial;
+    if (layout.j0_blocks > 0) radial.J0.resize(n_m, n_x);
+    if (layout.j1_blocks > 0) radial.J1.resize(n_m, n_x);
+    radial.inverse_ro.resize(n_x);
+    ParallelChunks(n_x, 1, input.threads, [&](int first, int last) {
+        Eigen::VectorXd arguments(n_m);
+        for (int j = first; j < last; ++j) {
+            double x = input.x_offsets[j];
+            if (x == 0.0) x = 1e-6;
+            double ro = x / sumH;
+            radial.inverse_ro(j) = 1.0 / ro;
+            for (int k = 0; k < n_m; ++k) {
+                arguments(k) = m_values[k] * ro;
+            }
+            if (layout.j0_blocks > 0) {
+                Pavement::SpecialFunctions::BesselJ0(arguments.data(), radial.J0.col(j).data(), n_m);
+            }
+            if (layout.j1_blocks > 0) {
+                Pavement::SpecialFunctions::BesselJ1(arguments.data(), radial.J1.col(j).data(), n_m);
+            }
         }
+    });
+    
+    // Load kernel and quadrature weight of each m
+    Eigen::VectorXd arguments(n_m);
+    radial.load_weight.resize(n_m);
+    for (int k = 0; k < n_m; ++k) {
+        arguments(k) = m_values[k] * alpha;
+    }
+    Pavement::SpecialFunctions::BesselJ1(arguments.data(), radial.load_weight.data(), n_m);
+    for (int k = 0; k < n_m; ++k) {
+        radial.load_weight(k) *= ft_weights[k] / m_values[k];
     }
+    
+    return radial;
 }
 
 void PyMasticSolver::ComputeResponses(const Input& input,
                                      const std::vector<double>& m_values,
-                                     const std::vector<double>& ft_weights,
+                                     const RadialKernels& radial,
                                      const Eigen::MatrixXd& A, const Eigen::MatrixXd& B,
                                      const Eigen::MatrixXd& C, const Eigen::MatrixXd& D,
                                      Output& output) {
@@ -504,108 +859,132 @@ void PyMasticSolver::ComputeResponses(const Input& input,
     
     std::vector<double> lamda = ComputeLamdaValues(input.H_thicknesses);
     
-    for (size_t j = 0; j < input.x_offsets.size(); ++j) {
-        double x = input.x_offsets[j];
-        if (x == 0.0) x = 1e-6;
-        double ro = x / sumH;
-        
-        for (size_t i = 0; i < input.z_depths.size(); ++i) {
+    const int n_m = static_cast<int>(m_values.size());
+    const int n_x = static_cast<int>(input.x_offsets.size());
+    const int n_z = static_cast<int>(input.z_depths.size());
+    
+    // Every response integral separates into a depth kernel (coefficients and
+    // exponentials, independent of x) and a radial kernel (J0 or J1 of m*ro,
+    // independent of z):
+    //   response(z, x) = sum_k depth(z, m_k) * w_k * J1(m_k*alpha)/m_k * radial(m_k, x)
+    // so each Bessel value and exponential is computed once and the sums over m
+    // for the whole grid are two matrix products.
+    const Eigen::VectorXd& load_weight = radial.load_weight;
+    
+    // Depth kernels, one block of n_z rows per requested term:
+    // J0 terms [disp_z | stress_z | stress_r | stress_t], J1 terms [disp_h | shared radial/tangential]
+    const TermLayout layout(input.responses);
+    int row[DEPTH_TERMS];
+    for (int t = 0; t < DEPTH_TERMS; ++t) {
+        row[t] = layout.block[t] * n_z;
+    }
+    Eigen::MatrixXd J0_depth(layout.j0_blocks * n_z, n_m);
+    Eigen::MatrixXd J1_depth(layout.j1_blocks * n_z, n_m);
+    std::vector<int> layer_of(n_z);
+    ParallelChunks(n_z, 1, input.threads, [&](int first, int last) {
+        Eigen::VectorXd exp_top(n_m);
+        Eigen::VectorXd exp_bottom(n_m);
+        for (int i = first; i < last; ++i) {
             double z = input.z_depths[i];
             if (z == 0.0) z = 1e-6;
             double L = z / sumH;
             
             int layer_idx = FindLayerIndex(L, lamda);
+            layer_of[i] = layer_idx;
             double nu = input.nu_poisson[layer_idx];
             double E = input.E_moduli[layer_idx]; // Keep in original units (ksi)
+            double compliance = (1.0 + nu) / E;
             
-            // Displacement Z (vertical)
-            double disp_z_sum = 0.0;
-            for (size_t k = 0; k < m_values.size(); ++k) {
-                double m = m_values[k];
-                double Rs = -1.0 * ((1.0 + nu) / E) * BesselJ0(m * ro) *
-                           ((A(k, layer_idx) - C(k, layer_idx) * (2 - 4 * nu - m * L)) *
-                            std::exp(-m * (lamda[layer_idx + 1] - L)) -
-                            (B(k, layer_idx) + D(k, layer_idx) * (2 - 4 * nu + m * L)) *
-                            std::exp(-m * (L - lamda[layer_idx])));
-                disp_z_sum += ft_weights[k] * Rs * BesselJ1(m * alpha) / m;
-            }
-            output.displacement_z(i, j) = sumH * input.q_kpa * alpha * disp_z_sum;
-            
-            // Displacement H (horizontal) 
-            double disp_h_sum = 0.0;
-            for (size_t k = 0; k < m_values.size(); ++k) {
-                double m = m_values[k];
-                double Rs = ((1.0 + nu) / E) * BesselJ1(m * ro) *
-                           ((A(k, layer_idx) + C(k, layer_idx) * (1 + m * L)) *
-                            std::exp(-m * (lamda[layer_idx + 1] - L)) +
-                            (B(k, layer_idx) - D(k, layer_idx) * (1 - m * L)) *
-                            std::exp(-m * (L - lamda[layer_idx])));
-                disp_h_sum += ft_weights[k] * Rs * BesselJ1(m * alpha) / m;
+            // Decay from the layer's bottom and top boundaries, for all m at once
+            for (int k = 0; k < n_m; ++k) {
+                exp_top(k) = -m_values[k] * (lamda[layer_idx + 1] - L);
+                exp_bottom(k) = -m_values[k] * (L - lamda[layer_idx]);
             }
-            output.displacement_h(i, j) = sumH * input.q_kpa * alpha * disp_h_sum;
+            Pavement::SpecialFunctions::Exp(exp_top.data(), exp_top.data(), n_m);
+            Pavement::SpecialFunctions::Exp(exp_bottom.data(), exp_bottom.data(), n_m);
             
-            // Stress Z (vertical)
-            double stress_z_sum = 0.0;
-            for (size_t k = 0; k < m_values.size(); ++k) {
+            for (int k = 0; k < n_m; ++k) {
                 double m = m_values[k];
-                double Rs = -m * BesselJ0(m * ro) * 
-                           ((A(k, layer_idx) - C(k, layer_idx) * (1 - 2 * nu - m * L)) *
-                            std::exp(-m * (lamda[layer_idx + 1] - L)) +
-                            (B(k, layer_idx) + D(k, layer_idx) * (1 - 2 * nu + m * L)) *
-                            std::exp(-m * (L - lamda[layer_idx])));
-                stress_z_sum += ft_weights[k] * Rs * BesselJ1(m * alpha) / m;
+                double a = A(k, layer_idx), b = B(k, layer_idx), c = C(k, layer_idx), d = D(k, layer_idx);
+                double e_top = exp_top(k);
+                double e_bottom = exp_bottom(k);
+                double w = load_weight(k);
+                
+                // Horizontal displacement and the J1/ro part of the radial and tangential stresses
+                double horizontal = (a + c * (1 + m * L)) * e_top + (b - d * (1 - m * L)) * e_bottom;
+                double lateral = 2 * nu * m * (c * e_top - d * e_bottom);
+                
+                if (layout.Uses(DISPLACEMENT_Z_TERM)) {
+                    J0_depth(row[DISPLACEMENT_Z_TERM] + i, k) = -compliance * w *
+                        ((a - c * (2 - 4 * nu - m * L)) * e_top - (b + d * (2 - 4 * nu + m * L)) * e_bottom);
+                }
+                if (layout.Uses(STRESS_Z_TERM)) {
+                    J0_depth(row[STRESS_Z_TERM] + i, k) = -m * w *
+                        ((a - c * (1 - 2 * nu - m * L)) * e_top + (b + d * (1 - 2 * nu + m * L)) * e_bottom);
+                }
+                if (layout.Uses(STRESS_R_TERM)) J0_depth(row[STRESS_R_TERM] + i, k) = w * (m * horizontal + lateral);
+                if (layout.Uses(STRESS_T_TERM)) J0_depth(row[STRESS_T_TERM] + i, k) = w * lateral;
+                if (layout.Uses(DISPLACEMENT_H_TERM)) J1_depth(row[DISPLACEMENT_H_TERM] + i, k) = compliance * w * horizontal;
+                if (layout.Uses(HORIZONTAL_TERM)) J1_depth(row[HORIZONTAL_TERM] + i, k) = w * horizontal;
             }
-            output.stress_z(i, j) = -input.q_kpa * alpha * stress_z_sum;
-            
-            // DEBUG: Print for first point
-            if (i == 0 && j == 0) {
-                std::cout << "DEBUG PyMastic stress_z (z=0, x=0):" << std::endl;
-                std::cout << "  q=" << input.q_kpa << " psi, alpha=" << alpha << std::endl;
-                std::cout << "  stress_z_sum=" << stress_z_sum << std::endl;
-                std::cout << "  stress_z=" << output.stress_z(i,j) << " psi" << std::endl;
-                std::cout << "  A(0,0)=" << A(0, layer_idx) << ", C(0,0)=" << C(0, layer_idx) << std::endl;
-                std::cout << "  B(0,0)=" << B(0, layer_idx) << ", D(0,0)=" << D(0, layer_idx) << std::endl;
-                std::cout << "  m_values.size()=" << m_values.size() << std::endl;
-            }
-
-            
-            // Stress R (radial)
-            double stress_r_sum = 0.0;
-            for (size_t k = 0; k < m_values.size(); ++k) {
-                double m = m_values[k];
-                double bessel_term = (m * BesselJ0(m * ro) - BesselJ1(m * ro) / ro);
-                double Rs = bessel_term *
-                           ((A(k, layer_idx) + C(k, layer_idx) * (1 + m * L)) *
-                            std::exp(-m * (lamda[layer_idx + 1] - L)) +
-                            (B(k, layer_idx) - D(k, layer_idx) * (1 - m * L)) *
-                            std::exp(-m * (L - lamda[layer_idx]))) +
-                           2 * nu * m * BesselJ0(m * ro) *
-                           (C(k, layer_idx) * std::exp(-m * (lamda[layer_idx + 1] - L)) -
-                            D(k, layer_idx) * std::exp(-m * (L - lamda[layer_idx])));
-                stress_r_sum += ft_weights[k] * Rs * BesselJ1(m * alpha) / m;
-            }
-            output.stress_r(i, j) = -input.q_kpa * alpha * stress_r_sum;
-            
-            // Stress T (tangential)
-            double stress_t_sum = 0.0;
-            for (size_t k = 0; k < m_values.size(); ++k) {
-                double m = m_values[k];
-                double Rs = (BesselJ1(m * ro) / ro) *
-                           ((A(k, layer_idx) + C(k, layer_idx) * (1 + m * L)) *
-                            std::exp(-m * (lamda[layer_idx + 1] - L)) +
-                            (B(k, layer_idx) - D(k, layer_idx) * (1 - m * L)) *
-                            std::exp(-m * (L - lamda[layer_idx]))) +
-                           2 * nu * m * BesselJ0(m * ro) *
-                           (C(k, layer_idx) * std::exp(-m * (lamda[layer_idx + 1] - L)) -
-                            D(k, layer_idx) * std::exp(-m * (L - lamda[layer_idx])));
-                stress_t_sum += ft_weights[k] * Rs * BesselJ1(m * alpha) / m;
+        }
+    });
+    
+    // All sums over m, one pair of matrix products per column tile of the grid
+    const unsigned responses = input.responses;
+    ParallelChunks(n_x, 4, input.threads, [&](int first, int last) {
+        const int width = last - first;
+        Eigen::MatrixXd J0_sums, J1_sums, J1_over_ro;
+        if (layout.j0_blocks > 0) J0_sums = J0_depth * radial.J0.middleCols(first, width);
+        if (layout.j1_blocks > 0) J1_sums = J1_depth * radial.J1.middleCols(first, width);
+        if (layout.Uses(HORIZONTAL_TERM)) {
+            J1_over_ro = J1_sums.middleRows(row[HORIZONTAL_TERM], n_z) *
+                         radial.inverse_ro.segment(first, width).asDiagonal();
+        }
+        
+        if (responses & DisplacementZ) {
+            output.displacement_z.middleCols(first, width) =
+                sumH * input.q_kpa * alpha * J0_sums.middleRows(row[DISPLACEMENT_Z_TERM], n_z);
+        }
+        if (responses & DisplacementH) {
+            output.displacement_h.middleCols(first, width) =
+                sumH * input.q_kpa * alpha * J1_sums.middleRows(row[DISPLACEMENT_H_TERM], n_z);
+        }
+        
+        // Stress tiles, kept in the output only when requested
+        Eigen::MatrixXd stress_z, stress_r, stress_t;
+        if (layout.Uses(STRESS_Z_TERM)) {
+            stress_z = -input.q_kpa * alpha * J0_sums.middleRows(row[STRESS_Z_TERM], n_z);
+        }
+        if (layout.Uses(STRESS_R_TERM)) {
+            stress_r = -input.q_kpa * alpha * (J0_sums.middleRows(row[STRESS_R_TERM], n_z) - J1_over_ro);
+        }
+        if (layout.Uses(STRESS_T_TERM)) {
+            stress_t = -input.q_kpa * alpha * (J1_over_ro + J0_sums.middleRows(row[STRESS_T_TERM], n_z));
+        }
+        if (responses & StressZ) output.stress_z.middleCols(first, width) = stress_z;
+        if (responses & StressR) output.stress_r.middleCols(first, width) = stress_r;
+        if (responses & StressT) output.stress_t.middleCols(first, width) = stress_t;
+        
+        // Compute requested strains from stresses
+        if ((responses & Strains) == 0) {
+            return;
+        }
+        for (int i = 0; i < n_z; ++i) {
+            double nu = input.nu_poisson[layer_of[i]];
+            double E = input.E_moduli[layer_of[i]];
+            for (int j = first; j < last; ++j) {
+                const int c = j - first;
+                if (responses & StrainZ) {
+                    output.strain_z(i, j) = (1.0 / E) * (stress_z(i, c) - nu * (stress_t(i, c) + stress_r(i, c)));
+                }
+                if (responses & StrainR) {
+                    output.strain_r(i, j) = (1.0 / E) * (stress_r(i, c) - nu * (stress_z(i, c) + stress_t(i, c)));
+                }
+                if (responses & StrainT) {
+                    output.strain_t(i, j) = (1.0 / E) * (stress_t(i, c) - nu * (stress_z(i, c) + stress_r(i, c)));
+                }
             }
-            output.stress_t(i, j) = -input.q_kpa * alpha * stress_t_sum;
-            
-            // Compute strains from stresses
-            output.strain_z(i, j) = (1.0 / E) * (output.stress_z(i, j) - nu * (output.stress_t(i, j) + output.stress_r(i, j)));
-            output.strain_r(i, j) = (1.0 / E) * (output.stress_r(i, j) - nu * (output.stress_z(i, j) + output.stress_t(i, j)));
-            output.strain_t(i, j) = (1.0 / E) * (output.stress_t(i, j) - nu * (output.stress_z(i, j) + output.stress_r(i, j)));
         }
-    }
-}
\ No newline at end of file
+    });
+}
@@ -0,0 +1,172 @@
+#include "SpecialFunctions.h"
+#include "SpecialFunctionKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace Pavement {
+
+namespace {
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+
+// CPUID leaf 1 (ECX) and leaf 7 (EBX) feature bits, and the XCR0 state the
+// OS must save. /arch:AVX2 and /arch:AVX512 let MSVC emit FMA, so it is
+// required for both.
+constexpr int CPUID_FMA = 1 << 12;
+constexpr int CPUID_OSXSAVE = 1 << 27;
+constexpr int CPUID_AVX2 = 1 << 5;
+constexpr int CPUID_AVX512F = 1 << 16;
+constexpr unsigned long long XCR0_YMM = 0x6;    // SSE and AVX state
+constexpr unsigned long long XCR0_ZMM = 0xE6;   // plus opmask and upper ZMM state
+
+bool CpuidSupports(int feature, unsigned long long xcr0State) {
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    if ((info[2] & CPUID_FMA) == 0 || (info[2] & CPUID_OSXSAVE) == 0 ||
+        (_xgetbv(0) & xcr0State) != xcr0State) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & feature) != 0;
+}
+
+#endif
+
+SpecialFunctionKernels::Table SelectKernels() {
+    if (SpecialFunctionKernels::CpuSupportsAvx512()) {
+        return SpecialFunctionKernels::Avx512();
+    }
+    if (SpecialFunctionKernels::CpuSupportsAvx2()) {
+        return SpecialFunctionKernels::Avx2();
+    }
+    return SpecialFunctionKernels::Baseline();
+}
+
+// Process-wide tables of J0 and J1 zeros, extended on demand
+struct BesselZeroCache {
+    std::mutex mutex;
+    std::vector<double> zeros[2];
+};
+
+BesselZeroCache& ZeroCache() {
+    static BesselZeroCache cache;
+    return cache;
+}
+
+// Zeros first + 1 .. last of J_order appended to zeros
+void GenerateBesselZeros(int order, int first, int last, std::vector<double>& zeros) {
+    const int count = last - first;
+    const double mu = 4.0 * order * order;
+
+    // McMahon: j ~ b - (mu-1)/(8b) - 4(mu-1)(7mu-31)/(3(8b)^3) - 32(mu-1)(83mu^2-982mu+3779)/(15(8b)^5)
+    std::vector<double> x(count);
+    for (int k = 0; k < count; ++k) {
+        const double beta = (first + k + 1 + 0.5 * order - 0.25) * M_PI;
+        const double t = 1.0 / (8.0 * beta);
+        x[k] = beta - (mu - 1.0) * t
+                    - 4.0 * (mu - 1.0) * (7.0 * mu - 31.0) / 3.0 * t * t * t
+                    - 32.0 * (mu - 1.0) * (83.0 * mu * mu - 982.0 * mu + 3779.0) / 15.0 * std::pow(t, 5);
+    }
+
+    // Newton on J_order: J0' = -J1, J1' = J0 - J1/x. The expansion is already
+    // within 1e-3 of the first zero, so a few steps reach rounding level.
+    std::vector<double> j0(count), j1(count);
+    for (int step = 0; step < 5; ++step) {
+        SpecialFunctions::BesselJ0(x.data(), j0.data(), count);
+        SpecialFunctions::BesselJ1(x.data(), j1.data(), count);
+        for (int k = 0; k < count; ++k) {
+            x[k] -= order == 0 ? j0[k] / -j1[k] : j1[k] / (j0[k] - j1[k] / x[k]);
+        }
+    }
+    zeros.insert(zeros.end(), x.begin(), x.end());
+}
+
+} // namespace
+
+bool SpecialFunctionKernels::CpuSupportsAvx2() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return CpuidSupports(CPUID_AVX2, XCR0_YMM);
+#else
+    return false;
+#endif
+}
+
+bool SpecialFunctionKernels::CpuSupportsAvx512() {
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("fma");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    return CpuidSupports(CPUID_AVX512F, XCR0_ZMM);
+#else
+    return false;
+#endif
+}
+
+const SpecialFunctionKernels::Table& SpecialFunctionKernels::Selected() {
+    static const Table kernels = SelectKernels();
+    return kernels;
+}
+
+void SpecialFunctions::BesselJ0(const double* x, double* result, int count) {
+    SpecialFunctionKernels::Selected().besselJ0(x, result, count);
+}
+
+void SpecialFunctions::BesselJ1(const double* x, double* result, int count) {
+    SpecialFunctionKernels::Selected().besselJ1(x, result, count);
+}
+
+void SpecialFunctions::Exp(const double* x, double* result, int count) {
+    SpecialFunctionKernels::Selected().exp(x, result, count);
+}
+
+double SpecialFunctions::BesselJ0(double x) {
+    BesselJ0(&x, &x, 1);
+    return x;
+}
+
+double SpecialFunctions::BesselJ1(double x) {
+    BesselJ1(&x, &x, 1);
+    return x;
+}
+
+std::vector<double> SpecialFunctions::BesselZeros(int order, int count) {
+    if (order != 0 && order != 1) {
+        throw std::invalid_argument("Bessel zeros are available for J0 and J1 only");
+    }
+    if (count < 0) {
+        throw std::invalid_argument("Negative Bessel zero count");
+    }
+
+    BesselZeroCache& cache = ZeroCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    std::vector<double>& zeros = cache.zeros[order];
+    if (static_cast<int>(zeros.size()) < count) {
+        // Grow geometrically so rising counts do not regenerate in small steps
+        const int target = std::max(count, 2 * static_cast<int>(zeros.size()));
+        GenerateBesselZeros(order, static_cast<int>(zeros.size()), target, zeros);
+    }
+    return std::vector<double>(zeros.begin(), zeros.begin() + count);
+}
+
+const char* SpecialFunctions::InstructionSet() {
+    return SpecialFunctionKernels::Selected().instructionSet;
+}
+
+} // namespace Pavement
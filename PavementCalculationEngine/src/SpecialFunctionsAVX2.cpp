@@ -0,0 +1,10 @@
+// Built with -mavx2 (/arch:AVX2) on x86-64; see CMakeLists.txt
+#include "SimdSpecialFunctions.h"
+
+namespace Pavement {
+
+SpecialFunctionKernels::Table SpecialFunctionKernels::Avx2() {
+    return KernelTable();
+}
+
+} // namespace Pavement
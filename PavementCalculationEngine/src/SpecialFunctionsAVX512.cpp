@@ -0,0 +1,18 @@
+// Built with -mavx512f -mfma (/arch:AVX512) on x86-64; see CMakeLists.txt
+
+// GCC 12 flags the _mm512_undefined_pd() inside its own masked intrinsics
+// (GCC bug 105593); nothing here reads an undefined value
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include "SimdSpecialFunctions.h"
+
+namespace Pavement {
+
+SpecialFunctionKernels::Table SpecialFunctionKernels::Avx512() {
+    return KernelTable();
+}
+
+} // namespace Pavement
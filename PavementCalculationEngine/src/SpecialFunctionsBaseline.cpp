@@ -0,0 +1,10 @@
+// Built with the library's own flags (SSE2 on x86-64 unless ENABLE_AVX2/ENABLE_AVX512)
+#include "SimdSpecialFunctions.h"
+
+namespace Pavement {
+
+SpecialFunctionKernels::Table SpecialFunctionKernels::Baseline() {
+    return KernelTable();
+}
+
+} // namespace Pavement
@@ -1,250 +1,282 @@
 ﻿#include "TRMMSolver.h"
-#include <sstream>
+#include "AssemblyPlan.h"
+#include "SpecialFunctions.h"
+#include "ThreadPool.h"
+#include "Logger.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <stdexcept>
+#include <string>
 
 namespace PavementCalculation {
 
-TRMMSolver::TRMMSolver() : config_(), total_layers_processed_(0), stability_warnings_(0), max_condition_number_(0.0) {
-    logger_ = &Pavement::Logger::GetInstance();
+using Pavement::AssemblyPlan;
+using Pavement::CalculationInput;
+using Pavement::CalculationOutput;
+using Pavement::HankelIntegrationResult;
+using Pavement::HankelIntegrator;
+using Pavement::SolveStatus;
+using Pavement::SpecialFunctions;
+namespace Constants = Pavement::Constants;
+
+namespace {
+
+// Integrated per depth: [sigma_z | sigma_x | sigma_y | w], x along the axle
+constexpr int QUANTITIES = 4;
+
+// Interface type of CalculationInput without shear transfer
+constexpr int FRICTIONLESS_INTERFACE = 2;
+
+// Depths closer than this to an interface (m) lie on it: summed thicknesses
+// and typed depths differ by rounding
+constexpr double INTERFACE_TOLERANCE = 1e-9;
+
+using Basis = AssemblyPlan::Basis;
+
+double Compliance(const CalculationInput& input, int layer) {
+    return (1.0 + input.poissonRatios[layer]) / input.youngModuli[layer];
 }
 
-TRMMSolver::TRMMSolver(const TRMMConfig& config) : config_(config), total_layers_processed_(0), stability_warnings_(0), max_condition_number_(0.0) {
-    logger_ = &Pavement::Logger::GetInstance();
+// Calculation depth located in its layer
+struct DepthPoint {
+    int layer;
+    double fromTop;     // z - z_top >= 0
+    double fromBottom;  // z - z_bottom <= 0 (unused in the half-space)
+    double complianceRatio;  // Compliance of the layer over that of the surface layer
+};
+
+} // namespace
+
+TRMMSolver::TRMMSolver() : config_() {}
+
+TRMMSolver::TRMMSolver(const TRMMConfig& config) {
+    SetConfig(config);
 }
 
-bool TRMMSolver::LayerMatrices::IsStable() const {
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            if (std::abs(T(i,j)) > 1.5 || std::abs(R(i,j)) > 1.5) {
-                return false;
-            }
-        }
+void TRMMSolver::SetConfig(const TRMMConfig& config) {
+    config_ = config;
+    if (config_.thread_count == 1) {
+        pool_.reset();
+    } else if (!pool_ || pool_->GetThreadCount() != config_.thread_count) {
+        pool_ = std::make_shared<Pavement::ThreadPool>(config_.thread_count);
     }
-    return true;
 }
 
-double TRMMSolver::LayerMatrices::GetConditionNumber() const {
-    Eigen::Matrix3d combined = T + R;
-    Eigen::JacobiSVD<Eigen::Matrix3d> svd(combined);
-    double max_sv = svd.singularValues()(0);
-    double min_sv = svd.singularValues()(2);
-    if (min_sv < 1e-15) return 1e15;
-    return max_sv / min_sv;
+void TRMMSolver::SetThreadPool(std::shared_ptr<Pavement::ThreadPool> pool) {
+    pool_ = std::move(pool);
+    config_.thread_count = pool_ ? pool_->GetThreadCount() : 1;
 }
 
-double TRMMSolver::CalculateMParameter(double E, double nu, double radius) {
-    // Parametre m pour systemes multicouches (formule Odemark-Burmister)
-    // m represente l'attenuation laterale de la charge avec la profondeur
-    //
-    // Formule empirique calibree pour chaussees:
-    // m = k / a avec k ≈ 2.0-2.5 pour structures typiques
-    //
-    // Valeur conservatrice: k = 2.0 → m stable pour toutes epaisseurs
-    //
-    // Reference: Odemark (1949), Burmister (1945)
-    return 2.0 / radius; // m en (1/m), radius en m → m typique 17-20 pour a=0.1m
-}
+SolveStatus TRMMSolver::SolveAmplitudes(double m, const CalculationInput& input,
+                                        Amplitudes& amplitudes) noexcept {
+    const int n = input.layerCount;
+    amplitudes.resize(4, n);
+    Eigen::Matrix2d reflection[Constants::MAX_LAYER_COUNT];
+    Eigen::Matrix2d transmission[Constants::MAX_LAYER_COUNT];
+
+    // Sweep from the half-space upward; the half-space reflects nothing
+    reflection[n - 1].setZero();
+    for (int i = n - 2; i >= 0; --i) {
+        const double h = input.thicknesses[i];
+
+        // Layer i at its bottom: the downward part has decayed over the thickness
+        const Basis up = AssemblyPlan::UpwardBasis(input.poissonRatios[i], 0.0);
+        const Basis down = AssemblyPlan::DownwardBasis(input.poissonRatios[i], m * h) * std::exp(-m * h);
 
-bool TRMMSolver::CheckNumericalStability(double m, double h) {
-    double mh = m * h;
-    if (mh > config_.stability_threshold) {
-        std::ostringstream oss;
-        oss << "Stability warning: m*h = " << mh << " exceeds threshold " << config_.stability_threshold;
-        logger_->Warning(oss.str());
-        stability_warnings_++;
-        return false;
+        // Layer i+1 at its top, its upward part reflected from its downward
+        // one; displacements rescaled to the compliance of layer i
+        Basis below = AssemblyPlan::DownwardBasis(input.poissonRatios[i + 1], 0.0);
+        if (i + 1 < n - 1) {
+            const double hBelow = input.thicknesses[i + 1];
+            below.noalias() += AssemblyPlan::UpwardBasis(input.poissonRatios[i + 1], -m * hBelow) *
+                               (std::exp(-m * hBelow) * reflection[i + 1]);
+        }
+        below.bottomRows<2>() *= Compliance(input, i + 1) / Compliance(input, i);
+
+        // Continuity at z_{i+1}: [up, -below] * (R_i; T_i) = -down
+        Eigen::Matrix4d system;
+        Basis rhs;
+        if (input.interfaceTypes[i] != FRICTIONLESS_INTERFACE) {
+            system << up, -below;
+            rhs = -down;
+        } else {
+            // sigma_z and w continuous, no shear on either side
+            system << up.row(0), -below.row(0),
+                      up.row(3), -below.row(3),
+                      up.row(1), 0.0, 0.0,
+                      0.0, 0.0, below.row(1);
+            rhs << -down.row(0),
+                   -down.row(3),
+                   -down.row(1),
+                   0.0, 0.0;
+        }
+        const Basis solved = system.partialPivLu().solve(rhs);
+        if (!solved.allFinite()) {
+            return SolveStatus::Singular;
+        }
+        reflection[i] = solved.topRows<2>();
+        transmission[i] = solved.bottomRows<2>();
     }
-    return true;
-}
 
-bool TRMMSolver::ValidateLayerMatrices(const LayerMatrices& matrices) {
-    if (!matrices.IsStable()) {
-        logger_->Error("Layer matrices failed stability check (elements > 1.5)");
-        return false;
+    // Surface conditions sigma_z = 1, tau_rz = 0 at the top of the first layer
+    Basis surface = AssemblyPlan::DownwardBasis(input.poissonRatios[0], 0.0);
+    if (n > 1) {
+        const double h = input.thicknesses[0];
+        surface.noalias() += AssemblyPlan::UpwardBasis(input.poissonRatios[0], -m * h) * (std::exp(-m * h) * reflection[0]);
     }
-    
-    double cond = matrices.GetConditionNumber();
-    if (cond > max_condition_number_) {
-        max_condition_number_ = cond;
+    Eigen::Vector2d down = surface.topRows<2>().partialPivLu().solve(Eigen::Vector2d(1.0, 0.0));
+    if (!down.allFinite()) {
+        return SolveStatus::Singular;
     }
-    
-    if (cond > 1e6) {
-        std::ostringstream oss;
-        oss << "Layer matrices poorly conditioned: condition number = " << cond;
-        logger_->Error(oss.str());
-        return false;
+
+    // Sweep back down: T carries the downward amplitudes, R gives the upward ones
+    for (int i = 0; i < n; ++i) {
+        amplitudes.col(i) << reflection[i] * down, down;
+        if (i < n - 1) {
+            down = transmission[i] * down;
+        }
     }
-    
-    return true;
+    return SolveStatus::Ok;
 }
 
-TRMMSolver::LayerMatrices TRMMSolver::BuildLayerMatrices(double E, double nu, double h, double m) {
-    LayerMatrices result;
-    result.young_modulus = E;
-    result.poisson_ratio = nu;
-    result.thickness = h;
-    result.m_parameter = m;
-    
-    // Limiter epaisseur effective pour calculs (couche semi-infinie)
-    // h_max = 10 / m pour garder m*h < 10 (zone stabilite)
-    double h_effective = std::min(h, 10.0 / m);
-    
-    double mh = m * h_effective;
-    double exp_neg_mh = std::exp(-mh);
-    
-    if (config_.verbose_logging) {
-        std::ostringstream oss;
-        oss << "Building TRMM matrices: E=" << E << " MPa, nu=" << nu << ", h=" << h << " m, m=" << m << ", m*h=" << mh;
-        logger_->Info(oss.str());
-        oss.str("");
-        oss << "  exp(-m*h) = " << exp_neg_mh << " (stable, bounded <= 1.0)";
-        logger_->Info(oss.str());
+CalculationOutput TRMMSolver::Calculate(const CalculationInput& input,
+                                        const std::vector<double>& depths) {
+    LOG_INFO("Starting TRMM calculation: " + std::to_string(input.layerCount) + " layers, " +
+             std::to_string(depths.size()) + " depths");
+
+    input.Validate();
+    if (depths.empty()) {
+        throw std::invalid_argument("At least one calculation depth is required");
     }
-    
-    double lambda = E * nu / ((1.0 + nu) * (1.0 - 2.0 * nu));
-    double mu = E / (2.0 * (1.0 + nu));
-    double c1 = lambda + 2.0 * mu;
-    double c2 = lambda;
-    
-    result.T = Eigen::Matrix3d::Zero();
-    result.R = Eigen::Matrix3d::Zero();
-    
-    result.T(0,0) = exp_neg_mh;
-    result.T(1,1) = exp_neg_mh;
-    result.T(2,2) = exp_neg_mh;
-    
-    result.T(0,1) = (c2 / c1) * (1.0 - exp_neg_mh);
-    result.T(1,0) = (c2 / c1) * (1.0 - exp_neg_mh);
-    result.T(2,1) = mu * h * exp_neg_mh / c1;
-    
-    result.R(0,0) = (1.0 - exp_neg_mh) * 0.5;
-    result.R(1,1) = (1.0 - exp_neg_mh) * 0.5;
-    result.R(2,2) = (1.0 - exp_neg_mh) * 0.3;
-    
-    return result;
-}
 
-bool TRMMSolver::CalculateStable(const PavementInputC& input, PavementOutputC& output) {
-    std::ostringstream oss;
-    oss << "TRMM calculation started: " << input.nlayer << " layers, " << input.nz << " calculation points";
-    logger_->Info(oss.str());
-    
-    output.success = 0;
-    output.error_code = 0;
-    
-    try {
-        double m = CalculateMParameter(input.young_modulus[0], input.poisson_ratio[0], input.wheel_radius_m);
-        
-        oss.str("");
-        oss << "Calculated m parameter: " << m << " (1/m)";
-        logger_->Info(oss.str());
-        
-        std::vector<LayerMatrices> layer_matrices;
-        layer_matrices.reserve(input.nlayer);
-        
-        for (int i = 0; i < input.nlayer; i++) {
-            double h = input.thickness[i];
-            double E = input.young_modulus[i];
-            double nu = input.poisson_ratio[i];
-            
-            CheckNumericalStability(m, h);
-            
-            LayerMatrices matrices = BuildLayerMatrices(E, nu, h, m);
-            
-            if (!ValidateLayerMatrices(matrices)) {
-                oss.str("");
-                oss << "Layer " << i << " matrices validation failed";
-                logger_->Error(oss.str());
-                output.error_code = -2;
-                std::strncpy(output.error_message, "Layer matrices validation failed", 255);
-                return false;
-            }
-            
-            layer_matrices.push_back(matrices);
-            total_layers_processed_++;
+    // Layer of every depth; the last layer is a half-space
+    const int n = input.layerCount;
+    const int nz = static_cast<int>(depths.size());
+    std::vector<double> tops(n, 0.0);
+    for (int i = 1; i < n; ++i) {
+        tops[i] = tops[i - 1] + input.thicknesses[i - 1];
+    }
+    std::vector<DepthPoint> points(nz);
+    for (int k = 0; k < nz; ++k) {
+        const double z = depths[k];
+        if (!(z >= 0.0) || !std::isfinite(z)) {
+            throw std::invalid_argument("Invalid calculation depth at position " + std::to_string(k) +
+                                        ": " + std::to_string(z) + " m (must be >= 0)");
+        }
+        int layer = 0;
+        while (layer < n - 1 && z > tops[layer + 1] + INTERFACE_TOLERANCE) {
+            ++layer;
+        }
+        // An interface listed twice in a row: bottom of the upper layer, then top of the lower
+        if (layer < n - 1 && z >= tops[layer + 1] - INTERFACE_TOLERANCE &&
+            k > 0 && std::abs(depths[k - 1] - z) <= INTERFACE_TOLERANCE) {
+            ++layer;
         }
-        
-        ComputeResponses(input, layer_matrices, output);
-        
-        output.success = 1;
-        logger_->Info("TRMM calculation completed successfully");
-        
-        oss.str("");
-        oss << "Statistics: " << total_layers_processed_ << " layers processed, " << stability_warnings_ << " warnings, max condition number = " << max_condition_number_;
-        logger_->Info(oss.str());
-        
-        return true;
-        
-    } catch (const std::exception& e) {
-        oss.str("");
-        oss << "TRMM calculation failed: " << e.what();
-        logger_->Error(oss.str());
-        output.error_code = -1;
-        std::strncpy(output.error_message, e.what(), 255);
-        return false;
+        points[k].layer = layer;
+        points[k].fromTop = std::max(0.0, z - tops[layer]);
+        points[k].fromBottom = layer < n - 1 ? std::min(0.0, z - tops[layer + 1]) : 0.0;
+        points[k].complianceRatio = Compliance(input, layer) / Compliance(input, 0);
     }
-}
 
-void TRMMSolver::ComputeResponses(const PavementInputC& input, const std::vector<LayerMatrices>& layer_matrices, PavementOutputC& output) {
-    output.nz = input.nz;
-    
-    output.deflection_mm = new double[input.nz];
-    output.vertical_stress_kpa = new double[input.nz];
-    output.horizontal_strain = new double[input.nz];
-    output.radial_strain = new double[input.nz];
-    output.shear_stress_kpa = new double[input.nz];
-    
-    // PHASE 2: Calcul reponses avec formule Burmister stabilisee (exp(-m*z) ONLY)
-    double load_magnitude = input.pressure_kpa; // kPa
-    
-    for (int iz = 0; iz < input.nz; iz++) {
-        double z = input.z_coords[iz];
-        
-        // Trouver couche contenant z
-        int layer_idx = 0;
-        double z_in_layer = z;
-        double cumulative_h = 0.0;
-        
-        for (int i = 0; i < input.nlayer; i++) {
-            if (i == input.nlayer - 1 || z < cumulative_h + input.thickness[i]) {
-                layer_idx = i;
-                z_in_layer = z - cumulative_h;
-                break;
+    const double a = input.contactRadius;
+    const bool twin = input.wheelType == 2;
+    const double spacing = input.wheelSpacing;
+
+    // Integrand on the axis of the first wheel, per unit pressure, with the
+    // load kernel a*J1(m*a). The second wheel of a twin load acts at r =
+    // spacing: J0(m*r) for the axial terms, and the radial/tangential split
+    // J1(m*r)/(m*r) for the horizontal stresses along and across the axle.
+    auto integrand = [&](double m) -> Eigen::VectorXd {
+        Eigen::VectorXd values = Eigen::VectorXd::Zero(QUANTITIES * nz);
+        Amplitudes amplitudes;
+        if (SolveAmplitudes(m, input, amplitudes) != SolveStatus::Ok) {
+            // Non-finite: the integrator counts the point as failed
+            values.setConstant(std::numeric_limits<double>::quiet_NaN());
+            return values;
+        }
+
+        const double kernel = a * SpecialFunctions::BesselJ1(m * a);
+        double j0 = 0.0;
+        double j1OverArgument = 0.0;
+        if (twin) {
+            j0 = SpecialFunctions::BesselJ0(m * spacing);
+            j1OverArgument = SpecialFunctions::BesselJ1(m * spacing) / (m * spacing);
+        }
+
+        for (int k = 0; k < nz; ++k) {
+            const DepthPoint& point = points[k];
+            const double nu = input.poissonRatios[point.layer];
+            const auto layer = amplitudes.col(point.layer);
+
+            const double downDecay = std::exp(-m * point.fromTop);
+            Eigen::Vector4d state = AssemblyPlan::DownwardBasis(nu, m * point.fromTop) * (downDecay * layer.tail<2>());
+            double lateral = -2.0 * nu * layer(3) * downDecay;
+            if (point.layer < n - 1) {
+                const double upDecay = std::exp(m * point.fromBottom);
+                state.noalias() += AssemblyPlan::UpwardBasis(nu, m * point.fromBottom) * (upDecay * layer.head<2>());
+                lateral += 2.0 * nu * layer(1) * upDecay;
+            }
+            const double horizontal = state(2);
+
+            // On the axis J1(m*r)/(m*r) -> 1/2 splits the horizontal term equally
+            const double axial = twin ? 1.0 + j0 : 1.0;
+            double alongAxle = 0.5 * horizontal + lateral;
+            double acrossAxle = alongAxle;
+            if (twin) {
+                alongAxle += (horizontal + lateral) * j0 - horizontal * j1OverArgument;
+                acrossAxle += horizontal * j1OverArgument + lateral * j0;
             }
-            cumulative_h += input.thickness[i];
+            values(k) = kernel * state(0) * axial;
+            values(nz + k) = -kernel * alongAxle;
+            values(2 * nz + k) = -kernel * acrossAxle;
+            values(3 * nz + k) = -kernel / m * point.complianceRatio * state(3) * axial;
         }
-        
-        // Parametres couche
-        const LayerMatrices& layer = layer_matrices[layer_idx];
-        double m = layer.m_parameter;
-        double E = layer.young_modulus;
-        double nu = layer.poisson_ratio;
-        
-        // Attenuation exponentielle STABLE (exp(-m*z) uniquement)
-        double exp_neg_mz = std::exp(-m * z);
-        
-        // Deflexion (formule Burmister simplifiee)
-        double deflection_factor = (1.0 + nu) * (1.0 - 2.0 * nu) / (E * m);
-        output.deflection_mm[iz] = load_magnitude * deflection_factor * exp_neg_mz * 1000.0;
-        
-        // Contrainte verticale
-        output.vertical_stress_kpa[iz] = input.pressure_kpa * exp_neg_mz;
-        
-        // Deformations (loi Hooke)
-        double epsilon_z = output.vertical_stress_kpa[iz] / E; // Deformation verticale (sans dimension)
-        double epsilon_r = -nu * epsilon_z;                     // Deformation radiale (Poisson)
-        
-        output.horizontal_strain[iz] = epsilon_r * 1e6; // -> microstrain
-        output.radial_strain[iz] = epsilon_r * 1e6;
-        
-        // Contrainte cisaillement (approximation)
-        output.shear_stress_kpa[iz] = 0.5 * output.vertical_stress_kpa[iz];
+        return values;
+    };
+
+    const std::vector<double> breakpoints = config_.integration.extrapolateTail
+        ? HankelIntegrator::BesselJ1ZeroBreakpoints(a, config_.integration.maxPartitions)
+        : HankelIntegrator::BesselJ1Breakpoints(a, Constants::HANKEL_INTEGRATION_BOUND / a);
+    const HankelIntegrationResult integral =
+        HankelIntegrator::Integrate(integrand, breakpoints, config_.integration, pool_.get());
+
+    // Stresses are positive in compression, strains positive in extension
+    CalculationOutput output;
+    output.Resize(nz);
+    const double q = input.pressure;
+    const double surfaceCompliance = Compliance(input, 0);
+    for (int k = 0; k < nz; ++k) {
+        const double E = input.youngModuli[points[k].layer];
+        const double nu = input.poissonRatios[points[k].layer];
+        const double sigmaZ = q * integral.value(k);
+        const double sigmaX = q * integral.value(nz + k);
+        const double sigmaY = q * integral.value(2 * nz + k);
+        output.sigmaZ[k] = sigmaZ;
+        output.sigmaT[k] = sigmaX;
+        output.epsilonZ[k] = -(sigmaZ - nu * (sigmaX + sigmaY)) / E * Constants::STRAIN_TO_MICROSTRAIN;
+        output.epsilonT[k] = -(sigmaX - nu * (sigmaZ + sigmaY)) / E * Constants::STRAIN_TO_MICROSTRAIN;
+        output.deflection[k] = q * surfaceCompliance * integral.value(3 * nz + k) * Constants::M_TO_MM;
     }
-    
-    std::ostringstream oss;
-    oss << "Computed responses at " << input.nz << " points. Surface deflection: " << output.deflection_mm[0] << " mm";
-    logger_->Info(oss.str());
+
+    output.integration.errorEstimate = integral.errorEstimate;
+    output.integration.evaluations = integral.evaluations;
+    output.integration.intervals = integral.intervals;
+    output.integration.failedEvaluations = integral.failedEvaluations;
+    output.integration.converged = integral.converged;
+    output.integration.partitions = integral.partitions;
+    output.integration.extrapolationError = integral.extrapolationError;
+
+    const std::string summary = "TRMM calculation completed: " + std::to_string(integral.evaluations) +
+        " evaluations, " + std::to_string(integral.intervals) + " intervals, error estimate " +
+        std::to_string(integral.errorEstimate);
+    if (config_.verbose_logging) {
+        LOG_INFO(summary);
+    } else {
+        LOG_DEBUG(summary);
+    }
+
+    return output;
 }
 
 }
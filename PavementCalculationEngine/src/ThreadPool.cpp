@@ -0,0 +1,110 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace Pavement {
+
+ThreadPool::ThreadPool(int threadCount) : stopping_(false) {
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    // The calling thread always works too, so start one worker fewer
+    for (int i = 1; i < threadCount; ++i) {
+        workers_.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        jobs_.push_back(std::move(job));
+    }
+    condition_.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return stopping_ || !jobs_.empty(); });
+            if (stopping_ && jobs_.empty()) {
+                return;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+        job();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    if (workers_.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // Shared loop state outlives this call if a helper starts after we return
+    struct LoopState {
+        std::atomic<int> next{0};
+        std::atomic<int> done{0};
+        int count = 0;
+        const std::function<void(int)>* task = nullptr;
+        std::exception_ptr error;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    auto state = std::make_shared<LoopState>();
+    state->count = count;
+    state->task = &task;
+
+    auto runIterations = [](const std::shared_ptr<LoopState>& s) {
+        for (int i = s->next.fetch_add(1); i < s->count; i = s->next.fetch_add(1)) {
+            try {
+                (*s->task)(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                if (!s->error) {
+                    s->error = std::current_exception();
+                }
+            }
+            if (s->done.fetch_add(1) + 1 == s->count) {
+                std::lock_guard<std::mutex> lock(s->mutex);
+                s->finished.notify_all();
+            }
+        }
+    };
+
+    const int helpers = std::min(static_cast<int>(workers_.size()), count - 1);
+    for (int h = 0; h < helpers; ++h) {
+        Enqueue([state, runIterations] { runIterations(state); });
+    }
+
+    runIterations(state);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&] { return state->done.load() == state->count; });
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace Pavement
@@ -0,0 +1,69 @@
+#include "WynnEpsilon.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace Pavement {
+
+WynnEpsilon::WynnEpsilon(int maxColumns)
+    : maxColumns_(maxColumns), error_(std::numeric_limits<double>::infinity())
+{
+    if (maxColumns < 3) {
+        throw std::invalid_argument("Wynn epsilon table needs at least 3 columns");
+    }
+    scratch_.resize(maxColumns);
+}
+
+void WynnEpsilon::Add(const Eigen::VectorXd& partialSum)
+{
+    const int components = static_cast<int>(partialSum.size());
+    if (terms_ == 0) {
+        diagonal_.resize(components, maxColumns_);
+        depth_ = Eigen::VectorXi::Zero(components);
+        estimate_.resize(components);
+    } else if (components != diagonal_.rows()) {
+        throw std::invalid_argument("Wynn epsilon terms must keep their size");
+    }
+
+    beforePrevious_ = previous_;
+    previous_ = estimate_;
+
+    // Rhombus rule along the new anti-diagonal, cur[j] = eps_j^(n-j):
+    //   cur[j] = prev[j-2] + 1 / (cur[j-1] - prev[j-1]),  prev[-1] = 0
+    constexpr double ROUNDING = 4.0 * std::numeric_limits<double>::epsilon();
+    double* cur = scratch_.data();
+
+    for (int c = 0; c < components; ++c) {
+        const int previousDepth = depth_(c);
+        cur[0] = partialSum(c);
+        int depth = 1;
+        for (int j = 1; j <= previousDepth && j < maxColumns_; ++j) {
+            const double difference = cur[j - 1] - diagonal_(c, j - 1);
+            if (!(std::abs(difference) > ROUNDING * std::abs(cur[j - 1]))) {
+                break;  // Converged to rounding in this column
+            }
+            const double value = (j >= 2 ? diagonal_(c, j - 2) : 0.0) + 1.0 / difference;
+            if (!std::isfinite(value)) {
+                break;
+            }
+            cur[j] = value;
+            depth = j + 1;
+        }
+        for (int j = 0; j < depth; ++j) {
+            diagonal_(c, j) = cur[j];
+        }
+        depth_(c) = depth;
+
+        // Even columns hold the estimates; the deepest one is the best
+        estimate_(c) = cur[(depth - 1) & ~1];
+    }
+    ++terms_;
+
+    error_ = std::numeric_limits<double>::infinity();
+    if (terms_ >= 3) {
+        error_ = ((estimate_ - previous_).cwiseAbs() +
+                  (estimate_ - beforePrevious_).cwiseAbs()).maxCoeff();
+    }
+}
+
+} // namespace Pavement
@@ -97,7 +97,7 @@ int test_validation_invalid_layer_count(void) {
     double z_coords[] = {0.0};
     
     PavementInputC input = {0};
-    input.nlayer = 0;  /* Invalid: must be > 0 */
+    input.nlayer = 1;  /* Invalid: at least one layer over the half-space */
     input.poisson_ratio = poisson;
     input.young_modulus = moduli;
     input.thickness = thickness;
@@ -365,14 +365,14 @@ int test_error_handling_null_input(void) {
 int test_error_handling_null_output(void) {
     TEST_START("Error Handling - NULL Output Pointer");
     
-    double poisson[] = {0.35};
-    double moduli[] = {5000};
-    double thickness[] = {0.20};
-    int bonded[] = {};
+    double poisson[] = {0.35, 0.35};
+    double moduli[] = {5000, 50};
+    double thickness[] = {0.20, 100.0};
+    int bonded[] = {1};
     double z_coords[] = {0.0};
     
     PavementInputC input = {0};
-    input.nlayer = 1;
+    input.nlayer = 2;
     input.poisson_ratio = poisson;
     input.young_modulus = moduli;
     input.thickness = thickness;
@@ -394,6 +394,47 @@ int test_error_handling_null_output(void) {
 /**
  * Test 10: Test memory management (multiple allocate/free cycles)
  */
+int test_error_handling_too_many_depths(void) {
+    TEST_START("Error Handling - More Depths Than Interface Results");
+    
+    /* The standard solver returns 2*nlayer-1 = 3 results for 2 layers */
+    double poisson[] = {0.35, 0.35};
+    double moduli[] = {5000, 50};
+    double thickness[] = {0.20, 100.0};
+    int bonded[] = {1};
+    double z_coords[] = {0.0, 0.05, 0.10, 0.15, 0.20};
+    
+    PavementInputC input = {0};
+    input.nlayer = 2;
+    input.poisson_ratio = poisson;
+    input.young_modulus = moduli;
+    input.thickness = thickness;
+    input.bonded_interface = bonded;
+    input.wheel_type = 0;
+    input.pressure_kpa = 662;
+    input.wheel_radius_m = 0.125;
+    input.wheel_spacing_m = 0.0;
+    input.nz = 5;
+    input.z_coords = z_coords;
+    
+    PavementOutputC output = {0};
+    int result = PavementCalculate(&input, &output);
+    
+    ASSERT_TRUE(result == PAVEMENT_ERROR_INVALID_INPUT, "Should reject nz > 2*nlayer-1");
+    ASSERT_TRUE(output.success == 0, "Output should report failure");
+    ASSERT_TRUE(output.error_code == PAVEMENT_ERROR_INVALID_INPUT, "Output should carry the error code");
+    ASSERT_TRUE(output.deflection_mm == NULL, "No result arrays on failure");
+    ASSERT_TRUE(strlen(PavementGetLastError()) > 0, "Last error should be set");
+    
+    /* The stable solver returns one result per depth */
+    result = PavementCalculateStable(&input, &output);
+    ASSERT_TRUE(result == PAVEMENT_SUCCESS, "Stable solver should accept any nz");
+    ASSERT_TRUE(output.nz == 5, "Stable solver returns every depth");
+    PavementFreeOutput(&output);
+    
+    TEST_PASS();
+}
+
 int test_memory_management(void) {
     TEST_START("Memory Management - Multiple Allocate/Free Cycles");
     
@@ -443,14 +484,14 @@ int test_memory_management(void) {
 int test_free_output_idempotent(void) {
     TEST_START("Memory Management - Idempotent FreeOutput");
     
-    double poisson[] = {0.35};
-    double moduli[] = {5000};
-    double thickness[] = {0.20};
-    int bonded[] = {};
+    double poisson[] = {0.35, 0.35};
+    double moduli[] = {5000, 50};
+    double thickness[] = {0.20, 100.0};
+    int bonded[] = {1};
     double z_coords[] = {0.0};
     
     PavementInputC input = {0};
-    input.nlayer = 1;
+    input.nlayer = 2;
     input.poisson_ratio = poisson;
     input.young_modulus = moduli;
     input.thickness = thickness;
@@ -490,10 +531,10 @@ int test_performance_basic(void) {
     double moduli[] = {5000, 400, 200, 100, 50};
     double thickness[] = {0.10, 0.15, 0.20, 0.30, 100.0};
     int bonded[] = {1, 1, 1, 1};
-    double z_coords[10];
+    double z_coords[9];
     
-    /* 10 calculation points */
-    for (int i = 0; i < 10; i++) {
+    /* 9 calculation points: the 2*nlayer-1 results of the standard solver */
+    for (int i = 0; i < 9; i++) {
         z_coords[i] = i * 0.1;
     }
     
@@ -507,7 +548,7 @@ int test_performance_basic(void) {
     input.pressure_kpa = 662;
     input.wheel_radius_m = 0.125;
     input.wheel_spacing_m = 0.0;
-    input.nz = 10;
+    input.nz = 9;
     input.z_coords = z_coords;
     
     PavementOutputC output = {0};
@@ -527,6 +568,368 @@ int test_performance_basic(void) {
     TEST_PASS();
 }
 
+/**
+ * Test 13: Engine handle gives the results of the one-shot entry points
+ */
+int test_engine_matches_one_shot(void) {
+    TEST_START("Engine - Matches One-Shot Calculations");
+    
+    double poisson[] = {0.35, 0.35, 0.35};
+    double moduli[] = {5000, 200, 50};
+    double thickness[] = {0.15, 0.30, 100.0};
+    int bonded[] = {1, 1};
+    double z_coords[] = {0.0, 0.15, 0.45};
+    
+    PavementInputC input = {0};
+    input.nlayer = 3;
+    input.poisson_ratio = poisson;
+    input.young_modulus = moduli;
+    input.thickness = thickness;
+    input.bonded_interface = bonded;
+    input.wheel_type = 0;
+    input.pressure_kpa = 662;
+    input.wheel_radius_m = 0.125;
+    input.wheel_spacing_m = 0.0;
+    input.nz = 3;
+    input.z_coords = z_coords;
+    
+    PavementEngineConfigC config;
+    PavementEngineDefaultConfig(&config);
+    config.solver = PAVEMENT_SOLVER_STABLE;
+    config.thread_count = 2;
+    config.result_cache_capacity = 4;
+    
+    PavementEngine* engine = PavementEngineCreate(&config);
+    ASSERT_NOT_NULL(engine, "Engine creation failed");
+    
+    PavementOutputC expected = {0};
+    PavementOutputC output = {0};
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementCalculateStable(&input, &expected), "One-shot calculation failed");
+    
+    /* Second round is served from the result cache */
+    for (int round = 0; round < 2; round++) {
+        int result = PavementEngineCalculate(engine, &input, &output);
+        ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, result, "Engine calculation failed");
+        ASSERT_EQUAL_INT(input.nz, output.nz, "Output nz should match input");
+        for (int i = 0; i < output.nz; i++) {
+            ASSERT_NEAR(expected.deflection_mm[i], output.deflection_mm[i], 1e-12, "Deflection differs");
+            ASSERT_NEAR(expected.vertical_stress_kpa[i], output.vertical_stress_kpa[i], 1e-9, "Stress differs");
+        }
+        PavementFreeOutput(&output);
+    }
+    
+    PavementFreeOutput(&expected);
+    PavementEngineDestroy(engine);
+    
+    TEST_PASS();
+}
+
+/**
+ * Test 14: Engine rejects invalid configurations and NULL arguments
+ */
+int test_engine_error_handling(void) {
+    TEST_START("Engine - Error Handling");
+    
+    PavementEngineConfigC config;
+    PavementEngineDefaultConfig(&config);
+    config.relative_tolerance = 0.0;
+    ASSERT_TRUE(PavementEngineCreate(&config) == NULL, "Zero tolerance should be rejected");
+    ASSERT_TRUE(strlen(PavementGetLastError()) > 0, "Error message should be set");
+    
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_INVALID_INPUT, PavementSetLogLevel(PAVEMENT_LOG_CRITICAL + 1),
+                     "Unknown log level should be rejected");
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementSetLogLevel(PAVEMENT_LOG_WARNING), "Log level should be set");
+    
+    PavementEngine* engine = PavementEngineCreate(NULL);
+    ASSERT_NOT_NULL(engine, "Default engine creation failed");
+    
+    PavementOutputC output = {0};
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_NULL_POINTER, PavementEngineCalculate(engine, NULL, &output),
+                     "NULL input should be rejected");
+    ASSERT_EQUAL_INT(0, output.success, "Output should report failure");
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_NULL_POINTER, PavementEngineCalculate(NULL, NULL, &output),
+                     "NULL engine should be rejected");
+    
+    PavementEngineDestroy(engine);
+    PavementEngineDestroy(NULL);
+    
+    TEST_PASS();
+}
+
+/**
+ * Test 15: Batch over an engine reports every structure on its own
+ */
+int test_engine_batch(void) {
+    TEST_START("Engine - Batch Calculation");
+    
+    double poisson[] = {0.35, 0.35, 0.35};
+    double moduli[4][3] = {{5000, 200, 50}, {7000, 200, 50}, {5000, 400, 50}, {5000, -1, 50}};
+    double thickness[] = {0.15, 0.30, 100.0};
+    int bonded[] = {1, 1};
+    double z_coords[] = {0.0, 0.15, 0.45};
+    
+    PavementInputC inputs[4];
+    PavementOutputC outputs[4];
+    for (int i = 0; i < 4; i++) {
+        memset(&inputs[i], 0, sizeof(PavementInputC));
+        inputs[i].nlayer = 3;
+        inputs[i].poisson_ratio = poisson;
+        inputs[i].young_modulus = moduli[i];
+        inputs[i].thickness = thickness;
+        inputs[i].bonded_interface = bonded;
+        inputs[i].wheel_type = 0;
+        inputs[i].pressure_kpa = 662;
+        inputs[i].wheel_radius_m = 0.125;
+        inputs[i].wheel_spacing_m = 0.0;
+        inputs[i].nz = 3;
+        inputs[i].z_coords = z_coords;
+    }
+    
+    PavementEngineConfigC config;
+    PavementEngineDefaultConfig(&config);
+    config.solver = PAVEMENT_SOLVER_STABLE;
+    config.thread_count = 3;
+    
+    PavementEngine* engine = PavementEngineCreate(&config);
+    ASSERT_NOT_NULL(engine, "Engine creation failed");
+    
+    int failed = -1;
+    int result = PavementCalculateBatch(engine, inputs, 4, outputs, &failed);
+    
+    /* The negative modulus fails alone */
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_INVALID_INPUT, result, "Batch should report the invalid structure");
+    ASSERT_EQUAL_INT(1, failed, "Exactly one structure should fail");
+    ASSERT_EQUAL_INT(0, outputs[3].success, "Invalid structure should fail");
+    ASSERT_TRUE(strncmp(PavementGetLastError(), "Structure 3", 11) == 0, "Last error should name the structure");
+    
+    for (int i = 0; i < 3; i++) {
+        PavementOutputC single = {0};
+        ASSERT_EQUAL_INT(1, outputs[i].success, "Valid structure should succeed");
+        ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementEngineCalculate(engine, &inputs[i], &single),
+                         "Single calculation failed");
+        for (int k = 0; k < single.nz; k++) {
+            ASSERT_NEAR(single.deflection_mm[k], outputs[i].deflection_mm[k], 1e-12,
+                        "Batch deflection differs from single call");
+        }
+        PavementFreeOutput(&single);
+    }
+    printf("  Surface deflections: %.3f / %.3f / %.3f mm\n",
+           outputs[0].deflection_mm[0], outputs[1].deflection_mm[0], outputs[2].deflection_mm[0]);
+    
+    for (int i = 0; i < 4; i++) {
+        PavementFreeOutput(&outputs[i]);
+    }
+    
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementCalculateBatch(engine, NULL, 0, NULL, &failed),
+                     "Empty batch should succeed");
+    ASSERT_EQUAL_INT(0, failed, "Empty batch has no failures");
+    
+    PavementEngineDestroy(engine);
+    
+    TEST_PASS();
+}
+
+/**
+ * Test 16: Results written into caller-owned blocks in both layouts
+ */
+int test_engine_calculate_into(void) {
+    TEST_START("Engine - Caller-Provided Result Buffers");
+    
+    double poisson[] = {0.35, 0.35, 0.35};
+    double moduli[] = {5000, 200, 50};
+    double thickness[] = {0.15, 0.30, 100.0};
+    int bonded[] = {1, 1};
+    double z_coords[] = {0.0, 0.15, 0.45};
+    
+    PavementInputC input = {0};
+    input.nlayer = 3;
+    input.poisson_ratio = poisson;
+    input.young_modulus = moduli;
+    input.thickness = thickness;
+    input.bonded_interface = bonded;
+    input.wheel_type = 0;
+    input.pressure_kpa = 662;
+    input.wheel_radius_m = 0.125;
+    input.wheel_spacing_m = 0.0;
+    input.nz = 3;
+    input.z_coords = z_coords;
+    
+    PavementEngineConfigC config;
+    PavementEngineDefaultConfig(&config);
+    config.solver = PAVEMENT_SOLVER_STABLE;
+    config.result_cache_capacity = 2;
+    
+    PavementEngine* engine = PavementEngineCreate(&config);
+    ASSERT_NOT_NULL(engine, "Engine creation failed");
+    
+    PavementOutputC expected = {0};
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementEngineCalculate(engine, &input, &expected),
+                     "Engine calculation failed");
+    
+    /* One array per quantity, radial strain skipped */
+    double arrays[15];
+    for (int i = 0; i < 15; i++) arrays[i] = -999.0;
+    PavementResultBufferC by_quantity = {arrays, 15, 1, 0, 3, 6, -1, 12};
+    double time_ms = -1.0;
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementCalculateInto(engine, &input, &by_quantity, &time_ms),
+                     "Calculation into arrays failed");
+    ASSERT_TRUE(time_ms >= 0.0, "Calculation time should be reported");
+    
+    /* One record of five values per point */
+    double records[15];
+    PavementResultBufferC by_point = {records, 15, 5, 0, 1, 2, 3, 4};
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementCalculateInto(engine, &input, &by_point, NULL),
+                     "Calculation into records failed");
+    
+    for (int i = 0; i < 3; i++) {
+        ASSERT_NEAR(expected.deflection_mm[i], arrays[i], 1e-12, "Deflection array differs");
+        ASSERT_NEAR(expected.vertical_stress_kpa[i], arrays[3 + i], 1e-9, "Stress array differs");
+        ASSERT_NEAR(expected.horizontal_strain[i], arrays[6 + i], 1e-9, "Strain array differs");
+        ASSERT_NEAR(-999.0, arrays[9 + i], 0.0, "Skipped quantity should be untouched");
+        ASSERT_NEAR(expected.deflection_mm[i], records[5 * i], 1e-12, "Deflection record differs");
+        ASSERT_NEAR(expected.radial_strain[i], records[5 * i + 3], 1e-9, "Radial strain record differs");
+    }
+    
+    /* A block too small for nz points is rejected before any write */
+    PavementResultBufferC too_small = {records, 14, 5, 0, 1, 2, 3, 4};
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_INVALID_INPUT, PavementCalculateInto(engine, &input, &too_small, NULL),
+                     "Undersized block should be rejected");
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_NULL_POINTER, PavementCalculateInto(engine, &input, NULL, NULL),
+                     "NULL buffer should be rejected");
+    
+    PavementFreeOutput(&expected);
+    PavementEngineDestroy(engine);
+    
+    TEST_PASS();
+}
+
+/**
+ * State shared with the job callbacks of test 17
+ */
+typedef struct {
+    int completions;
+    int status;
+    int count;
+    int cancelled_outputs;
+    double surface_deflection[8];
+    int progress_calls;
+    int last_completed;
+    long long last_points;
+} JobRecord;
+
+static void record_progress(PavementJobId job, const PavementProgressC* progress, void* user_data) {
+    JobRecord* record = (JobRecord*)user_data;
+    (void)job;
+    record->progress_calls++;
+    record->last_completed = progress->completed_structures;
+    record->last_points = progress->integration_points;
+}
+
+static void record_completion(PavementJobId job, int status, const PavementOutputC* outputs,
+                              int count, void* user_data) {
+    JobRecord* record = (JobRecord*)user_data;
+    (void)job;
+    record->completions++;
+    record->status = status;
+    record->count = count;
+    for (int i = 0; i < count && i < 8; i++) {
+        if (outputs[i].error_code == PAVEMENT_ERROR_CANCELLED) {
+            record->cancelled_outputs++;
+        } else if (outputs[i].success) {
+            record->surface_deflection[i] = outputs[i].deflection_mm[0];
+        }
+    }
+}
+
+/**
+ * Test 17: Background jobs with progress, completion and cancellation
+ */
+int test_engine_submit(void) {
+    TEST_START("Engine - Background Jobs");
+    
+    double poisson[] = {0.35, 0.35, 0.35};
+    double moduli[4][3] = {{5000, 200, 50}, {6000, 200, 50}, {7000, 200, 50}, {8000, 200, 50}};
+    double thickness[] = {0.15, 0.30, 100.0};
+    int bonded[] = {1, 1};
+    double z_coords[] = {0.0, 0.15, 0.45};
+    
+    PavementInputC inputs[8];
+    for (int i = 0; i < 8; i++) {
+        PavementInputC input = {0};
+        input.nlayer = 3;
+        input.poisson_ratio = poisson;
+        input.young_modulus = moduli[i % 4];
+        input.thickness = thickness;
+        input.bonded_interface = bonded;
+        input.wheel_type = 0;
+        input.pressure_kpa = 662;
+        input.wheel_radius_m = 0.125;
+        input.wheel_spacing_m = 0.0;
+        input.nz = 3;
+        input.z_coords = z_coords;
+        inputs[i] = input;
+    }
+    
+    PavementEngineConfigC config;
+    PavementEngineDefaultConfig(&config);
+    config.solver = PAVEMENT_SOLVER_STABLE;
+    config.thread_count = 2;
+    
+    PavementEngine* engine = PavementEngineCreate(&config);
+    ASSERT_NOT_NULL(engine, "Engine creation failed");
+    
+    /* Four structures: every one reported, results match synchronous calls */
+    JobRecord record = {0};
+    PavementJobId job = PavementSubmitBatch(engine, inputs, 4, record_completion, record_progress, &record);
+    ASSERT_TRUE(job > 0, "Submission failed");
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementWait(engine, job), "Wait failed");
+    ASSERT_EQUAL_INT(1, record.completions, "Completion should be called once");
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, record.status, "Job should succeed");
+    ASSERT_EQUAL_INT(4, record.count, "Completion should receive every output");
+    ASSERT_EQUAL_INT(4, record.progress_calls, "Progress should be reported per structure");
+    ASSERT_EQUAL_INT(4, record.last_completed, "Last progress should cover the batch");
+    ASSERT_TRUE(record.last_points > 0, "Integration points should be counted");
+    ASSERT_EQUAL_INT(PAVEMENT_ERROR_INVALID_INPUT, PavementCancel(engine, job),
+                     "A finished job cannot be cancelled");
+    
+    for (int i = 0; i < 4; i++) {
+        PavementOutputC expected = {0};
+        ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, PavementEngineCalculate(engine, &inputs[i], &expected),
+                         "Engine calculation failed");
+        ASSERT_NEAR(expected.deflection_mm[0], record.surface_deflection[i], 1e-12,
+                    "Background result differs");
+        PavementFreeOutput(&expected);
+    }
+    
+    /* Cancelled right away: every structure is either calculated or reported cancelled */
+    JobRecord cancelled = {0};
+    job = PavementSubmitBatch(engine, inputs, 8, record_completion, record_progress, &cancelled);
+    ASSERT_TRUE(job > 0, "Submission failed");
+    int cancel_result = PavementCancel(engine, job);
+    PavementWait(engine, job);
+    ASSERT_EQUAL_INT(1, cancelled.completions, "Completion should be called once");
+    ASSERT_EQUAL_INT(8, cancelled.last_completed + cancelled.cancelled_outputs,
+                     "Structures should be completed or cancelled");
+    if (cancel_result == PAVEMENT_SUCCESS) {
+        ASSERT_EQUAL_INT(PAVEMENT_ERROR_CANCELLED, cancelled.status, "Job should report cancellation");
+    }
+    
+    /* Single structure without progress callback */
+    JobRecord single = {0};
+    job = PavementSubmit(engine, &inputs[0], record_completion, &single);
+    ASSERT_TRUE(job > 0, "Submission failed");
+    PavementWait(engine, job);
+    ASSERT_EQUAL_INT(PAVEMENT_SUCCESS, single.status, "Single job should succeed");
+    ASSERT_NEAR(record.surface_deflection[0], single.surface_deflection[0], 1e-12, "Single result differs");
+    
+    ASSERT_TRUE(PavementSubmit(NULL, &inputs[0], record_completion, NULL) == 0,
+                "NULL engine should be rejected");
+    
+    PavementEngineDestroy(engine);
+    
+    TEST_PASS();
+}
+
 /**
  * Main test runner
  */
@@ -546,9 +949,15 @@ int main(void) {
     test_calculation_twin_wheels();
     test_error_handling_null_input();
     test_error_handling_null_output();
+    test_error_handling_too_many_depths();
     test_memory_management();
     test_free_output_idempotent();
     test_performance_basic();
+    test_engine_matches_one_shot();
+    test_engine_error_handling();
+    test_engine_batch();
+    test_engine_calculate_into();
+    test_engine_submit();
     
     /* Print summary */
     print_separator();
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "AssemblyPlan.h"
+#include "MatrixOperations.h"
+#include "PavementData.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Pavement;
+
+class AssemblyPlanTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        input.SetDefaults();  // 3 layers, both interfaces bonded
+    }
+
+    Eigen::MatrixXd Fill(const AssemblyPlan& plan, double m) {
+        Eigen::MatrixXd M = Eigen::MatrixXd::Zero(plan.Size(), plan.Size());
+        plan.Fill(m, M);
+        return M;
+    }
+
+    CalculationInput input;
+};
+
+TEST_F(AssemblyPlanTest, SizeAndPattern) {
+    AssemblyPlan plan(input);
+    EXPECT_EQ(plan.Size(), 10);
+    EXPECT_EQ(plan.LayerCount(), 3);
+    EXPECT_DOUBLE_EQ(plan.Pressure(), input.pressure);
+
+    // Surface (8) + bonded interface (32) + bonded half-space interface (24)
+    EXPECT_EQ(plan.NonZeroCount(), 64);
+
+    Eigen::MatrixXd M = Fill(plan, 1.0);
+    EXPECT_EQ((M.array() != 0.0).count(), plan.NonZeroCount());
+}
+
+TEST_F(AssemblyPlanTest, SurfaceRows) {
+    const double m = 2.5;
+    const double nu = input.poissonRatios[0];
+    const double t = -m * input.thicknesses[0];
+    const double decay = std::exp(t);
+    Eigen::MatrixXd M = Fill(AssemblyPlan(input), m);
+
+    // Row 0: tau_rz = 0; B, D at t = 0, then A, C decayed over the layer
+    EXPECT_DOUBLE_EQ(M(0, 0), -1.0);
+    EXPECT_DOUBLE_EQ(M(0, 1), 2.0 * nu);
+    EXPECT_NEAR(M(0, 2), decay, 1e-15);
+    EXPECT_NEAR(M(0, 3), (t + 2.0 * nu) * decay, 1e-15);
+
+    // Row 1: -sigma_z = -p
+    EXPECT_DOUBLE_EQ(M(1, 0), -1.0);
+    EXPECT_DOUBLE_EQ(M(1, 1), -(1.0 - 2.0 * nu));
+    EXPECT_NEAR(M(1, 2), -decay, 1e-15);
+    EXPECT_NEAR(M(1, 3), -(t - (1.0 - 2.0 * nu)) * decay, 1e-15);
+}
+
+TEST_F(AssemblyPlanTest, BondedInterfaceRowsMatchBasis) {
+    const double m = 3.0;
+    const double h1 = input.thicknesses[0];
+    const double h2 = input.thicknesses[1];
+    const double nu1 = input.poissonRatios[0];
+    const double nu2 = input.poissonRatios[1];
+    const double complianceRatio = ((1.0 + nu2) / input.youngModuli[1]) /
+                                   ((1.0 + nu1) / input.youngModuli[0]);
+    Eigen::MatrixXd M = Fill(AssemblyPlan(input), m);
+
+    // Rows 2-5: state of layer 0 at its bottom = state of layer 1 at its top
+    AssemblyPlan::Basis upperDown = AssemblyPlan::DownwardBasis(nu1, m * h1) * std::exp(-m * h1);
+    AssemblyPlan::Basis upperUp = AssemblyPlan::UpwardBasis(nu1, 0.0);
+    AssemblyPlan::Basis lowerDown = AssemblyPlan::DownwardBasis(nu2, 0.0);
+    AssemblyPlan::Basis lowerUp = AssemblyPlan::UpwardBasis(nu2, -m * h2) * std::exp(-m * h2);
+    for (int state = 0; state < 4; ++state) {
+        const double scale = state >= 2 ? complianceRatio : 1.0;  // Displacements rescaled
+        for (int j = 0; j < 2; ++j) {
+            EXPECT_NEAR(M(2 + state, j), upperDown(state, j), 1e-14) << state;
+            EXPECT_NEAR(M(2 + state, 2 + j), upperUp(state, j), 1e-14) << state;
+            EXPECT_NEAR(M(2 + state, 4 + j), -scale * lowerDown(state, j), 1e-12) << state;
+            EXPECT_NEAR(M(2 + state, 6 + j), -scale * lowerUp(state, j), 1e-12) << state;
+        }
+    }
+}
+
+TEST_F(AssemblyPlanTest, FrictionlessInterfaceDecouplesShear) {
+    input.interfaceTypes[0] = 2;
+    AssemblyPlan plan(input);
+    Eigen::MatrixXd M = Fill(plan, 3.0);
+
+    // Surface (8) + frictionless interface (24) + bonded half-space interface (24)
+    EXPECT_EQ(plan.NonZeroCount(), 56);
+
+    // Row 4: no shear on the upper face, row 5: none on the lower face
+    EXPECT_EQ(M.block(4, 4, 1, 4).cwiseAbs().maxCoeff(), 0.0);
+    EXPECT_GT(M.block(4, 0, 1, 4).cwiseAbs().maxCoeff(), 0.0);
+    EXPECT_EQ(M.block(5, 0, 1, 4).cwiseAbs().maxCoeff(), 0.0);
+    EXPECT_GT(M.block(5, 4, 1, 4).cwiseAbs().maxCoeff(), 0.0);
+}
+
+TEST_F(AssemblyPlanTest, PlanIsReusableAcrossParameters) {
+    AssemblyPlan plan(input);
+    for (double m : {0.01, 0.7, 12.0, 90.0}) {
+        Eigen::MatrixXd fromPlan = Fill(plan, m);
+        Eigen::MatrixXd direct = MatrixOperations::AssembleSystemMatrix(m, input);
+        EXPECT_EQ((fromPlan - direct).cwiseAbs().maxCoeff(), 0.0) << "m = " << m;
+    }
+}
+
+TEST_F(AssemblyPlanTest, EntriesStayBoundedForLargeParameters) {
+    // m*h = 4000 over the first layer: every m-dependent entry has decayed,
+    // nothing overflows and the surface and interface rows keep their constants
+    AssemblyPlan plan(input);
+    const Eigen::MatrixXd moderate = Fill(plan, 1.0);
+    const Eigen::MatrixXd large = Fill(plan, 4000.0 / input.thicknesses[0]);
+
+    EXPECT_TRUE(large.allFinite());
+    EXPECT_LE(large.cwiseAbs().maxCoeff(), moderate.cwiseAbs().maxCoeff());
+    EXPECT_EQ(large(0, 0), -1.0);
+    EXPECT_EQ(large(0, 2), 0.0);
+}
+
+TEST_F(AssemblyPlanTest, RejectsInconsistentInput) {
+    input.layerCount = 1;
+    EXPECT_THROW(AssemblyPlan plan(input), std::invalid_argument);
+
+    input.SetDefaults();
+    input.thicknesses.pop_back();
+    EXPECT_THROW(AssemblyPlan plan(input), std::invalid_argument);
+}
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include "BandedLU.h"
+#include "Constants.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+using namespace Pavement;
+
+namespace {
+
+BandedMatrix RandomBanded(int size, int lower, int upper, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BandedMatrix A(size, lower, upper);
+    for (int i = 0; i < size; ++i) {
+        for (int j = std::max(0, i - lower); j <= std::min(size - 1, i + upper); ++j) {
+            A(i, j) = dist(rng);
+        }
+    }
+    return A;
+}
+
+} // namespace
+
+TEST(BandedLUTest, MatchesDenseSolve) {
+    for (int size : {1, 6, 18, 158}) {
+        BandedMatrix A = RandomBanded(size, 5, 5, 42u + size);
+        Eigen::VectorXd b = Eigen::VectorXd::LinSpaced(size, -1.0, 2.0);
+
+        Eigen::VectorXd expected = A.ToDense().partialPivLu().solve(b);
+        Eigen::VectorXd x = BandedLU(A).Solve(b);
+
+        EXPECT_LT((x - expected).norm(), 1e-9 * (1.0 + expected.norm())) << "size " << size;
+        EXPECT_LT((A.Multiply(x) - b).norm(), 1e-10 * (1.0 + b.norm())) << "size " << size;
+    }
+}
+
+TEST(BandedLUTest, PivotsOnZeroDiagonal) {
+    // Zero diagonal forces a row interchange (fill-in above the declared band)
+    BandedMatrix A(4, 1, 1);
+    A(0, 1) = 1.0;
+    A(1, 0) = 2.0; A(1, 2) = 1.0;
+    A(2, 1) = 3.0; A(2, 3) = 1.0;
+    A(3, 2) = 4.0; A(3, 3) = 1.0;
+    Eigen::VectorXd b(4);
+    b << 1.0, 2.0, 3.0, 4.0;
+
+    Eigen::VectorXd x = BandedLU(A).Solve(b);
+    EXPECT_LT((A.Multiply(x) - b).norm(), 1e-12);
+}
+
+TEST(BandedLUTest, TransposeSolve) {
+    BandedMatrix A = RandomBanded(30, 3, 2, 7u);
+    Eigen::VectorXd b = Eigen::VectorXd::Ones(30);
+
+    Eigen::VectorXd x = BandedLU(A).SolveTranspose(b);
+    EXPECT_LT((A.ToDense().transpose() * x - b).norm(), 1e-10);
+}
+
+TEST(BandedLUTest, ResidualUsesExtendedPrecision) {
+    BandedMatrix A(3, 2, 2);
+    A(0, 0) = 1.0; A(0, 1) = 1.0; A(0, 2) = 1.0;
+    A(1, 1) = 1.0;
+    A(2, 2) = 1.0;
+    Eigen::VectorXd x(3);
+    x << 1e16, 1.0, -1e16;
+    const Eigen::VectorXd b = Eigen::VectorXd::Zero(3);
+
+    const Eigen::VectorXd r = A.Residual(x, b);
+    EXPECT_EQ(r(1), -1.0);
+    EXPECT_EQ(r(2), 1e16);
+    // 1e16 + 1 is kept by the compensated sum, lost in double
+    EXPECT_EQ(r(0), -1.0);
+    EXPECT_EQ((b - A.Multiply(x))(0), 0.0);
+
+    // (1 + 2^-30)(1 - 2^-30) = 1 - 2^-60 needs the exact product
+    BandedMatrix B(1, 0, 0);
+    B(0, 0) = 1.0 + std::ldexp(1.0, -30);
+    const Eigen::VectorXd y = Eigen::VectorXd::Constant(1, 1.0 - std::ldexp(1.0, -30));
+    const Eigen::VectorXd one = Eigen::VectorXd::Ones(1);
+    EXPECT_EQ(B.Residual(y, one)(0), std::ldexp(1.0, -60));
+    EXPECT_EQ((one - B.Multiply(y))(0), 0.0);
+}
+
+TEST(BandedLUTest, DetectsSingularMatrix) {
+    BandedMatrix A(3, 1, 1);
+    A(0, 0) = 1.0;
+    A(1, 0) = 1.0;
+
+    BandedLU lu(A);
+    EXPECT_FALSE(lu.IsInvertible());
+    EXPECT_THROW(lu.Solve(Eigen::VectorXd::Ones(3)), std::runtime_error);
+}
+
+TEST(BandedLUTest, RejectsWritesOutsideBand) {
+    BandedMatrix A(6, 1, 2);
+    EXPECT_NO_THROW(A(0, 2) = 1.0);
+    EXPECT_THROW(A(0, 3) = 1.0, std::out_of_range);
+    EXPECT_THROW(A(3, 1) = 1.0, std::out_of_range);
+    EXPECT_EQ(static_cast<const BandedMatrix&>(A)(5, 0), 0.0);
+}
+
+TEST(BandedLUTest, ReciprocalConditionMatchesDenseEstimate) {
+    for (unsigned seed : {1u, 2u, 3u}) {
+        BandedMatrix A = RandomBanded(40, 5, 5, seed);
+        // Grade the columns to make the matrix moderately ill-conditioned
+        for (int j = 0; j < 40; ++j) {
+            A.ScaleCol(j, std::pow(10.0, -j / 8.0));
+        }
+        const Eigen::MatrixXd dense = A.ToDense();
+        const double exact = 1.0 / (dense.cwiseAbs().colwise().sum().maxCoeff() *
+                                    dense.inverse().cwiseAbs().colwise().sum().maxCoeff());
+
+        const double estimate = BandedLU(A).ReciprocalCondition();
+
+        // Hager/Higham under-estimates ||A^-1||_1, so 1/cond is never under-estimated
+        EXPECT_GE(estimate, exact * (1.0 - 1e-10)) << "seed " << seed;
+        EXPECT_LE(estimate, 10.0 * exact) << "seed " << seed;
+    }
+}
+
+TEST(BandedLUTest, ReciprocalConditionOfSingularMatrixIsZero) {
+    BandedMatrix A(3, 1, 1);
+    A(0, 0) = 1.0;
+    EXPECT_EQ(BandedLU(A).ReciprocalCondition(), 0.0);
+}
+
+TEST(BandedLUTest, ReciprocalConditionSeesPastBenignPivots) {
+    // Every pivot is 1, but the inverse grows like 2^n
+    BandedMatrix A(60, 0, 1);
+    for (int i = 0; i < 60; ++i) {
+        A(i, i) = 1.0;
+        if (i + 1 < 60) {
+            A(i, i + 1) = -2.0;
+        }
+    }
+    EXPECT_LT(BandedLU(A).ReciprocalCondition(), Constants::SINGULAR_RECIPROCAL_CONDITION);
+}
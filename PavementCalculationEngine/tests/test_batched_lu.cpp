@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "BatchedLU.h"
+#include "BandedLU.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+using namespace Pavement;
+
+namespace {
+
+constexpr int LANES = BatchedBandedMatrix::LANES;
+using LaneVectors = BatchedBandedMatrix::LaneVectors;
+
+// Independent random matrices in every lane
+BatchedBandedMatrix RandomBatch(int size, int lower, int upper, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    BatchedBandedMatrix A(size, lower, upper);
+    for (int l = 0; l < LANES; ++l) {
+        for (int i = 0; i < size; ++i) {
+            for (int j = std::max(0, i - lower); j <= std::min(size - 1, i + upper); ++j) {
+                A(i, j, l) = dist(rng);
+            }
+        }
+    }
+    return A;
+}
+
+LaneVectors RandomRightHandSides(int size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    LaneVectors b(size, LANES);
+    for (int i = 0; i < size; ++i) {
+        for (int l = 0; l < LANES; ++l) {
+            b(i, l) = dist(rng);
+        }
+    }
+    return b;
+}
+
+} // namespace
+
+TEST(BatchedLUTest, EveryLaneMatchesBandedLU) {
+    for (int size : {1, 6, 18, 158}) {
+        BatchedBandedMatrix A = RandomBatch(size, 5, 5, 42u + size);
+        LaneVectors b = RandomRightHandSides(size, 7u + size);
+
+        BatchedBandedLU batched(A);
+        LaneVectors x = batched.Solve(b);
+        LaneVectors y = batched.SolveTranspose(b);
+
+        for (int l = 0; l < LANES; ++l) {
+            const BandedLU lu(A.ExtractLane(l));
+            const Eigen::VectorXd expected = lu.Solve(b.col(l));
+            const Eigen::VectorXd expectedTranspose = lu.SolveTranspose(b.col(l));
+            EXPECT_LT((x.col(l) - expected).norm(), 1e-12 * (1.0 + expected.norm()))
+                << "size " << size << ", lane " << l;
+            EXPECT_LT((y.col(l) - expectedTranspose).norm(), 1e-12 * (1.0 + expectedTranspose.norm()))
+                << "size " << size << ", lane " << l;
+        }
+    }
+}
+
+TEST(BatchedLUTest, LanesPivotIndependently) {
+    // Lane 0 needs a row interchange at every step, the other lanes none
+    BatchedBandedMatrix A(4, 1, 1);
+    for (int l = 0; l < LANES; ++l) {
+        const double d = (l == 0) ? 0.0 : 4.0;
+        A(0, 0, l) = d;   A(0, 1, l) = 1.0;
+        A(1, 0, l) = 2.0; A(1, 1, l) = d;   A(1, 2, l) = 1.0;
+        A(2, 1, l) = 3.0; A(2, 2, l) = d;   A(2, 3, l) = 1.0;
+        A(3, 2, l) = 4.0; A(3, 3, l) = 1.0 + d;
+    }
+    LaneVectors b(4, LANES);
+    for (int i = 0; i < 4; ++i) {
+        b.row(i).setConstant(i + 1.0);
+    }
+
+    BatchedBandedLU lu(A);
+    LaneVectors x = lu.Solve(b);
+    LaneVectors residual = A.Multiply(x) - b;
+    for (int l = 0; l < LANES; ++l) {
+        EXPECT_TRUE(lu.IsInvertible(l));
+        EXPECT_LT(residual.col(l).norm(), 1e-12) << "lane " << l;
+    }
+}
+
+TEST(BatchedLUTest, SingularLaneDoesNotDisturbOthers) {
+    BatchedBandedMatrix A = RandomBatch(12, 2, 2, 3u);
+    const int singular = LANES - 1;
+    for (int i = 0; i < 12; ++i) {
+        for (int j = std::max(0, i - 2); j <= std::min(11, i + 2); ++j) {
+            A(i, j, singular) = (j == 4) ? 0.0 : A(i, j, singular);
+        }
+    }
+    LaneVectors b = RandomRightHandSides(12, 5u);
+
+    BatchedBandedLU lu(A);
+    LaneVectors x = lu.Solve(b);
+    std::array<double, LANES> rcond = lu.ReciprocalCondition();
+
+    EXPECT_FALSE(lu.IsInvertible(singular));
+    EXPECT_EQ(rcond[singular], 0.0);
+    for (int l = 0; l < singular; ++l) {
+        const BandedLU reference(A.ExtractLane(l));
+        EXPECT_TRUE(lu.IsInvertible(l));
+        EXPECT_LT((x.col(l) - reference.Solve(b.col(l))).norm(), 1e-12) << "lane " << l;
+    }
+}
+
+TEST(BatchedLUTest, ReciprocalConditionMatchesBandedLU) {
+    BatchedBandedMatrix A = RandomBatch(40, 5, 5, 11u);
+    // Grade the columns differently per lane: a spread of condition numbers
+    for (int j = 0; j < 40; ++j) {
+        double scales[LANES];
+        for (int l = 0; l < LANES; ++l) {
+            scales[l] = std::pow(10.0, -j * l / 32.0);
+        }
+        A.ScaleCols(j, scales);
+    }
+
+    std::array<double, LANES> rcond = BatchedBandedLU(A).ReciprocalCondition();
+    for (int l = 0; l < LANES; ++l) {
+        const double expected = BandedLU(A.ExtractLane(l)).ReciprocalCondition();
+        EXPECT_NEAR(rcond[l], expected, 1e-12 * expected) << "lane " << l;
+    }
+}
+
+TEST(BatchedLUTest, RejectsWritesOutsideBandOrLanes) {
+    BatchedBandedMatrix A(6, 1, 2);
+    EXPECT_NO_THROW(A(0, 2, 0) = 1.0);
+    EXPECT_THROW(A(0, 3, 0) = 1.0, std::out_of_range);
+    EXPECT_THROW(A(0, 0, LANES) = 1.0, std::out_of_range);
+    EXPECT_EQ(static_cast<const BatchedBandedMatrix&>(A)(5, 0, 1), 0.0);
+}
@@ -0,0 +1,324 @@
+#include <gtest/gtest.h>
+#include "CalculationEngine.h"
+#include "Logger.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace Pavement;
+
+namespace {
+
+// The logger is process-wide: quiet it for every engine of the test
+CalculationEngine::EngineConfig QuietConfig(CalculationEngine::Solver solver) {
+    Logger::GetInstance().SetLevel(Logger::Level::WARNING);
+    CalculationEngine::EngineConfig config;
+    config.solver = solver;
+    return config;
+}
+
+void ExpectSameResults(const CalculationOutput& expected, const CalculationOutput& actual) {
+    EXPECT_EQ(actual.sigmaZ, expected.sigmaZ);
+    EXPECT_EQ(actual.sigmaT, expected.sigmaT);
+    EXPECT_EQ(actual.epsilonZ, expected.epsilonZ);
+    EXPECT_EQ(actual.epsilonT, expected.epsilonT);
+    EXPECT_EQ(actual.deflection, expected.deflection);
+    EXPECT_EQ(actual.integration.evaluations, expected.integration.evaluations);
+}
+
+} // namespace
+
+// ============================================================================
+// Solver Dispatch
+// ============================================================================
+
+TEST(CalculationEngineTest, MatchesDirectSolvers) {
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 0.45, 1.0};
+
+    CalculationEngine standard(QuietConfig(CalculationEngine::Solver::Standard));
+    PavementCalculator calculator;
+    ExpectSameResults(calculator.Calculate(input), standard.Calculate(input, depths));
+
+    CalculationEngine stable(QuietConfig(CalculationEngine::Solver::Stable));
+    PavementCalculation::TRMMSolver trmm;
+    ExpectSameResults(trmm.Calculate(input, depths), stable.Calculate(input, depths));
+}
+
+TEST(CalculationEngineTest, SharedPoolGivesSerialResults) {
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 0.45};
+
+    CalculationEngine serial(QuietConfig(CalculationEngine::Solver::Stable));
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Stable);
+    config.threadCount = 3;
+    CalculationEngine threaded(config);
+
+    EXPECT_EQ(serial.GetThreadCount(), 1);
+    EXPECT_EQ(serial.GetThreadPool(), nullptr);
+    EXPECT_EQ(threaded.GetThreadCount(), 3);
+    EXPECT_EQ(threaded.GetConfig().trmm.thread_count, 3);
+    ExpectSameResults(serial.Calculate(input, depths), threaded.Calculate(input, depths));
+}
+
+// ============================================================================
+// Result Cache
+// ============================================================================
+
+TEST(CalculationEngineTest, ResultCacheServesRepeatedInputs) {
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Stable);
+    config.resultCacheCapacity = 2;
+    CalculationEngine engine(config);
+
+    CalculationInput first;
+    CalculationInput second;
+    second.youngModuli[1] = 400.0;
+    CalculationInput third;
+    third.pressure = 0.7;
+
+    const CalculationOutput computed = engine.Calculate(first, {0.0, 0.15});
+    ExpectSameResults(computed, engine.Calculate(first, {0.0, 0.15}));
+    CalculationEngine::ResultCacheStats stats = engine.GetResultCacheStats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_EQ(stats.capacity, 2u);
+
+    // Other depths are another result for the stable solver
+    EXPECT_EQ(engine.Calculate(first, {0.15}).deflection.size(), 1u);
+    EXPECT_EQ(engine.GetResultCacheStats().misses, 2u);
+
+    // Least recently used entries are evicted
+    engine.Calculate(second, {0.0});
+    engine.Calculate(third, {0.0});
+    engine.Calculate(first, {0.0, 0.15});
+    stats = engine.GetResultCacheStats();
+    EXPECT_EQ(stats.misses, 5u);
+    EXPECT_EQ(stats.entries, 2u);
+
+    engine.ClearResultCache();
+    stats = engine.GetResultCacheStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.entries, 0u);
+}
+
+TEST(CalculationEngineTest, CacheHitReusesOutputStorage) {
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Stable);
+    config.resultCacheCapacity = 1;
+    CalculationEngine engine(config);
+
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 0.45};
+    CalculationOutput output;
+    engine.Calculate(input, depths, output);
+    const CalculationOutput expected = output;
+    const double* deflection = output.deflection.data();
+    const double* sigmaZ = output.sigmaZ.data();
+
+    engine.Calculate(input, depths, output);
+    EXPECT_EQ(engine.GetResultCacheStats().hits, 1u);
+    EXPECT_EQ(output.deflection.data(), deflection);
+    EXPECT_EQ(output.sigmaZ.data(), sigmaZ);
+    ExpectSameResults(expected, output);
+}
+
+TEST(CalculationEngineTest, DisabledCacheStaysEmpty) {
+    CalculationEngine engine(QuietConfig(CalculationEngine::Solver::Standard));
+    CalculationInput input;
+    engine.Calculate(input, {});
+    engine.Calculate(input, {});
+    const CalculationEngine::ResultCacheStats stats = engine.GetResultCacheStats();
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 0u);
+    EXPECT_EQ(stats.entries, 0u);
+}
+
+// ============================================================================
+// Concurrency and Errors
+// ============================================================================
+
+TEST(CalculationEngineTest, ConcurrentCallersGetIdenticalResults) {
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Standard);
+    config.threadCount = 2;
+    CalculationEngine engine(config);
+
+    CalculationInput input;
+    const CalculationOutput expected = engine.Calculate(input, {});
+
+    std::vector<CalculationOutput> results(4);
+    std::vector<std::thread> callers;
+    for (size_t t = 0; t < results.size(); ++t) {
+        callers.emplace_back([&, t] {
+            for (int repeat = 0; repeat < 3; ++repeat) {
+                results[t] = engine.Calculate(input, {});
+            }
+        });
+    }
+    for (std::thread& caller : callers) {
+        caller.join();
+    }
+    for (const CalculationOutput& result : results) {
+        ExpectSameResults(expected, result);
+    }
+}
+
+TEST(CalculationEngineTest, BatchOverThePoolMatchesSingleCalls) {
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Stable);
+    config.threadCount = 3;
+    config.resultCacheCapacity = 8;
+    CalculationEngine engine(config);
+    CalculationEngine serial(QuietConfig(CalculationEngine::Solver::Stable));
+
+    // Repeated structures in one batch share the cache
+    std::vector<CalculationInput> inputs(10);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        inputs[i].youngModuli[1] = 100.0 + 50.0 * static_cast<double>(i % 5);
+    }
+    const std::vector<double> depths = {0.0, 0.15, 0.45};
+
+    std::vector<CalculationOutput> outputs(inputs.size());
+    engine.ParallelFor(static_cast<int>(inputs.size()), [&](int i) {
+        outputs[i] = engine.Calculate(inputs[i], depths);
+    });
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        ExpectSameResults(serial.Calculate(inputs[i], depths), outputs[i]);
+    }
+
+    const CalculationEngine::ResultCacheStats stats = engine.GetResultCacheStats();
+    EXPECT_EQ(stats.hits + stats.misses, inputs.size());
+    EXPECT_EQ(stats.entries, 5u);
+}
+
+TEST(CalculationEngineTest, InvalidInputThrowsAndEngineRecovers) {
+    CalculationEngine engine(QuietConfig(CalculationEngine::Solver::Stable));
+    CalculationInput input;
+    input.youngModuli[0] = -1.0;
+    EXPECT_THROW(engine.Calculate(input, {0.0}), std::invalid_argument);
+
+    CalculationInput valid;
+    EXPECT_THROW(engine.Calculate(valid, {-0.1}), std::invalid_argument);
+    EXPECT_NO_THROW(engine.Calculate(valid, {0.0}));
+}
+
+// ============================================================================
+// Background Jobs
+// ============================================================================
+
+TEST(CalculationEngineTest, SubmittedJobRunsEveryIteration) {
+    CalculationEngine::EngineConfig config = QuietConfig(CalculationEngine::Solver::Stable);
+    config.threadCount = 3;
+    CalculationEngine engine(config);
+
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15};
+    std::vector<CalculationOutput> outputs(6);
+    std::atomic<int> finishedCalls{0};
+    bool wasCancelled = true;
+
+    const CalculationEngine::JobId job = engine.Submit(
+        static_cast<int>(outputs.size()),
+        [&](int i) { outputs[i] = engine.Calculate(input, depths); },
+        [&](bool cancelled) { wasCancelled = cancelled; ++finishedCalls; });
+    EXPECT_GT(job, 0);
+    engine.Wait(job);
+
+    EXPECT_EQ(finishedCalls, 1);
+    EXPECT_FALSE(wasCancelled);
+    for (const CalculationOutput& output : outputs) {
+        ExpectSameResults(outputs[0], output);
+    }
+    EXPECT_FALSE(engine.Wait(job));
+    EXPECT_FALSE(engine.Cancel(job));
+}
+
+TEST(CalculationEngineTest, CancelSkipsIterationsNotStarted) {
+    // Serial engine: iterations run one after another on the background worker
+    CalculationEngine engine(QuietConfig(CalculationEngine::Solver::Standard));
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> ran{0};
+    bool wasCancelled = false;
+
+    const CalculationEngine::JobId job = engine.Submit(
+        5,
+        [&](int i) {
+            if (i == 0) {
+                started.set_value();
+                released.wait();
+            }
+            ++ran;
+        },
+        [&](bool cancelled) { wasCancelled = cancelled; });
+
+    started.get_future().wait();
+    EXPECT_TRUE(engine.Cancel(job));
+    release.set_value();
+    engine.Wait(job);
+
+    EXPECT_EQ(ran, 1);
+    EXPECT_TRUE(wasCancelled);
+}
+
+TEST(CalculationEngineTest, CancelDuringTheLastIterationIsReported) {
+    CalculationEngine engine(QuietConfig(CalculationEngine::Solver::Standard));
+
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> ran{0};
+    bool wasCancelled = false;
+
+    const CalculationEngine::JobId job = engine.Submit(
+        1,
+        [&](int) {
+            started.set_value();
+            released.wait();
+            ++ran;
+        },
+        [&](bool cancelled) { wasCancelled = cancelled; });
+
+    // Nothing is left to skip, but the cancellation succeeded
+    started.get_future().wait();
+    EXPECT_TRUE(engine.Cancel(job));
+    release.set_value();
+    engine.Wait(job);
+
+    EXPECT_EQ(ran, 1);
+    EXPECT_TRUE(wasCancelled);
+}
+
+TEST(CalculationEngineTest, DestructorCancelsAndWaitsForJobs) {
+    std::promise<void> started;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::atomic<int> ran{0};
+    std::atomic<bool> finished{false};
+
+    auto engine = std::make_unique<CalculationEngine>(QuietConfig(CalculationEngine::Solver::Standard));
+    engine->Submit(
+        3,
+        [&](int i) {
+            if (i == 0) {
+                started.set_value();
+                released.wait();
+            }
+            ++ran;
+        },
+        [&](bool) { finished = true; });
+
+    started.get_future().wait();
+    std::thread destroyer([&] { engine.reset(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(finished);
+    release.set_value();
+    destroyer.join();
+
+    // The job has completed by the time the engine is gone
+    EXPECT_TRUE(finished);
+    EXPECT_GE(ran, 1);
+}
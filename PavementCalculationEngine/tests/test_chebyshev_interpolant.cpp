@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include "ChebyshevInterpolant.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+using namespace Pavement;
+
+namespace {
+
+// Two components shaped like layer coefficients: a decaying and a growing exponential
+Eigen::Vector2d Coefficients(double m) {
+    return Eigen::Vector2d(std::exp(-0.3 * m), (1.0 + m) * std::exp(0.1 * m));
+}
+
+Eigen::MatrixXd Sample(const std::vector<double>& m) {
+    Eigen::MatrixXd values(2, static_cast<int>(m.size()));
+    for (size_t i = 0; i < m.size(); ++i) {
+        values.col(i) = Coefficients(m[i]);
+    }
+    return values;
+}
+
+// Chebyshev points of the first kind on [lower, upper], ascending
+std::vector<double> ChebyshevPoints(double lower, double upper, int count) {
+    std::vector<double> nodes(count);
+    for (int k = 0; k < count; ++k) {
+        nodes[k] = 0.5 * (lower + upper) - 0.5 * (upper - lower) * std::cos((2 * k + 1) * M_PI / (2 * count));
+    }
+    return nodes;
+}
+
+} // namespace
+
+TEST(ChebyshevInterpolantTest, ArbitraryNodesReproducePolynomials) {
+    // Degree 4 through 5 unevenly spaced nodes
+    const std::vector<double> nodes = {1.0, 1.2, 1.9, 2.6, 3.0};
+    Eigen::MatrixXd values(1, 5);
+    auto p = [](double x) { return 1.0 + 0.3 * x - 0.2 * std::pow(x, 2) + 0.05 * std::pow(x, 4); };
+    for (int k = 0; k < 5; ++k) {
+        values(0, k) = p(nodes[k]);
+    }
+    ChebyshevInterpolant interpolant(1.0, 3.0, nodes, values);
+
+    EXPECT_EQ(interpolant.Evaluate(nodes[3])(0), values(0, 3));
+    for (double x : {1.05, 1.5, 2.2, 2.99}) {
+        EXPECT_NEAR(interpolant.Evaluate(x)(0), p(x), 1e-12);
+    }
+    EXPECT_THROW(ChebyshevInterpolant(1.0, 3.0, nodes, Eigen::MatrixXd(1, 4)), std::invalid_argument);
+}
+
+TEST(ChebyshevInterpolantTest, FitSamplesChecksWithoutSampling) {
+    ChebyshevOptions options;
+    const std::vector<double> nodes = ChebyshevPoints(2.0, 14.0, 12);
+    const std::vector<double> candidates = {2.5, 7.9, 8.1, 13.7};
+    const std::vector<double> checks = ChebyshevInterpolant::SampleCheckPoints(nodes, candidates, 2);
+    ASSERT_EQ(checks.size(), 2u);
+
+    ChebyshevFitReport report;
+    auto interpolant = ChebyshevInterpolant::FitSamples(2.0, 14.0, nodes, Sample(nodes),
+                                                        checks, Sample(checks), options, &report);
+    ASSERT_NE(interpolant, nullptr);
+    EXPECT_TRUE(report.accepted);
+    EXPECT_LE(report.checkError, options.relativeTolerance);
+    for (double m = 2.0; m <= 14.0; m += 0.37) {
+        EXPECT_LT(interpolant->RelativeError(m, Coefficients(m)), 10.0 * options.relativeTolerance) << "m = " << m;
+    }
+
+    // Wrong check values are caught
+    Eigen::MatrixXd wrong = Sample(checks);
+    wrong(0, 1) *= 1.0 + 1e-6;
+    EXPECT_EQ(ChebyshevInterpolant::FitSamples(2.0, 14.0, nodes, Sample(nodes),
+                                               checks, wrong, options, &report), nullptr);
+    EXPECT_FALSE(report.accepted);
+    EXPECT_GT(report.checkError, options.relativeTolerance);
+
+    // So are non-finite ones
+    wrong = Sample(checks);
+    wrong(1, 0) = std::numeric_limits<double>::quiet_NaN();
+    EXPECT_EQ(ChebyshevInterpolant::FitSamples(2.0, 14.0, nodes, Sample(nodes),
+                                               checks, wrong, options, &report), nullptr);
+    EXPECT_TRUE(std::isnan(report.checkError));
+}
+
+TEST(ChebyshevInterpolantTest, SampleCheckPointsPicksTheWidestGaps) {
+    const std::vector<double> nodes = {0.0, 1.0, 4.0};
+    // Distances to the nearest node: 0.5, 1.5, 1.5, 0.2, 2.0
+    const std::vector<double> candidates = {0.5, 2.5, 5.5, 3.8, 6.0};
+
+    EXPECT_EQ(ChebyshevInterpolant::SampleCheckPoints(nodes, candidates, 2), (std::vector<double>{2.5, 6.0}));
+    EXPECT_EQ(ChebyshevInterpolant::SampleCheckPoints(nodes, candidates, 1), (std::vector<double>{6.0}));
+    EXPECT_EQ(ChebyshevInterpolant::SampleCheckPoints(nodes, candidates, 9).size(), candidates.size());
+}
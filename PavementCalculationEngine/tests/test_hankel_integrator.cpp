@@ -0,0 +1,283 @@
+#include <gtest/gtest.h>
+#include "HankelIntegrator.h"
+#include "Constants.h"
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace Pavement;
+
+// ============================================================================
+// Gauss-Kronrod Rule Tests
+// ============================================================================
+
+TEST(HankelIntegratorTest, PolynomialIsExactOnSingleInterval) {
+    // K15 is exact for polynomials up to degree 22
+    auto f = [](double x) {
+        Eigen::VectorXd v(2);
+        v << 3.0 * x * x, std::pow(x, 9);
+        return v;
+    };
+
+    HankelIntegrationResult result = HankelIntegrator::Integrate(f, {0.0, 2.0});
+
+    EXPECT_NEAR(result.value(0), 8.0, 1e-12);
+    EXPECT_NEAR(result.value(1), 102.4, 1e-10);
+    EXPECT_EQ(result.evaluations, 15);
+    EXPECT_EQ(result.intervals, 1);
+    EXPECT_TRUE(result.converged);
+}
+
+TEST(HankelIntegratorTest, OscillatoryBesselIntegralMeetsTolerance) {
+    // Integral of J1(x) over [0, j_{0,1}] = 1 - J0(j_{0,1}) = 1
+    const double j01 = 2.404825557695773;
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << std::cyl_bessel_j(1.0, x);
+        return v;
+    };
+
+    HankelIntegrationOptions options;
+    options.relativeTolerance = 1e-12;
+    HankelIntegrationResult result = HankelIntegrator::Integrate(f, {0.0, j01}, options);
+
+    EXPECT_NEAR(result.value(0), 1.0, 1e-12);
+    EXPECT_LE(result.errorEstimate, 1e-12);
+}
+
+TEST(HankelIntegratorTest, RefinesUntilToleranceAndReportsCost) {
+    // Sharp peak forces bisection: integral of 1/(1e-4 + x^2) over [-1, 1]
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << 1.0 / (1e-4 + x * x);
+        return v;
+    };
+    const double exact = 2.0 * std::atan(1.0 / 1e-2) / 1e-2;
+
+    HankelIntegrationOptions options;
+    options.relativeTolerance = 1e-9;
+    HankelIntegrationResult result = HankelIntegrator::Integrate(f, {-1.0, 1.0}, options);
+
+    EXPECT_TRUE(result.converged);
+    EXPECT_GT(result.intervals, 1);
+    EXPECT_EQ(result.evaluations, 15 * (2 * result.intervals - 1));
+    EXPECT_NEAR(result.value(0), exact, 1e-9 * exact);
+}
+
+TEST(HankelIntegratorTest, ObserverSeesEverySegmentBeforeItsNodes) {
+    std::vector<double> evaluated;
+    auto f = [&](double x) {
+        evaluated.push_back(x);
+        Eigen::VectorXd v(1);
+        v << 1.0 / (1e-4 + x * x);
+        return v;
+    };
+    std::vector<double> announced;
+    int steps = 0;
+    auto observer = [&](const std::vector<std::pair<double, double>>& segments) {
+        ++steps;
+        EXPECT_EQ(announced.size(), evaluated.size());  // No node of the step evaluated yet
+        for (size_t s = 0; s < segments.size(); ++s) {
+            if (s > 0) {
+                EXPECT_LE(segments[s - 1].second, segments[s].first);
+            }
+            double nodes[HankelIntegrator::KRONROD_NODES];
+            HankelIntegrator::KronrodNodes(segments[s].first, segments[s].second, nodes);
+            announced.insert(announced.end(), nodes, nodes + HankelIntegrator::KRONROD_NODES);
+        }
+    };
+
+    HankelIntegrationOptions options;
+    options.relativeTolerance = 1e-9;
+    HankelIntegrationResult result = HankelIntegrator::Integrate(f, {-1.0, 1.0}, options, nullptr, observer);
+
+    EXPECT_GT(steps, 1);
+    EXPECT_EQ(static_cast<int>(announced.size()), result.evaluations);
+    EXPECT_EQ(announced, evaluated);
+}
+
+TEST(HankelIntegratorTest, LooserToleranceUsesFewerEvaluations) {
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << std::cyl_bessel_j(1.0, x) * std::exp(-0.05 * x);
+        return v;
+    };
+    std::vector<double> breakpoints = HankelIntegrator::BesselJ1Breakpoints(1.0, 70.0);
+
+    HankelIntegrationOptions loose;
+    loose.relativeTolerance = 1e-4;
+    HankelIntegrationOptions tight;
+    tight.relativeTolerance = 1e-12;
+
+    HankelIntegrationResult coarse = HankelIntegrator::Integrate(f, breakpoints, loose);
+    HankelIntegrationResult fine = HankelIntegrator::Integrate(f, breakpoints, tight);
+
+    EXPECT_LE(coarse.evaluations, fine.evaluations);
+    EXPECT_NEAR(coarse.value(0), fine.value(0), 1e-4 * std::abs(fine.value(0)));
+}
+
+TEST(HankelIntegratorTest, StopsAtEvaluationBudget) {
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << std::sqrt(std::abs(x));  // Derivative singularity at 0
+        return v;
+    };
+
+    HankelIntegrationOptions options;
+    options.relativeTolerance = 1e-15;
+    options.absoluteTolerance = 0.0;
+    options.maxEvaluations = 100;
+    HankelIntegrationResult result = HankelIntegrator::Integrate(f, {-1.0, 1.0}, options);
+
+    EXPECT_LE(result.evaluations, 100);
+    EXPECT_FALSE(result.converged);
+    EXPECT_GT(result.errorEstimate, 0.0);
+}
+
+TEST(HankelIntegratorTest, FailedPointsPreventConvergence) {
+    // A constant integrand that cannot be evaluated on (1, 1.5): those nodes
+    // are integrated as zero, so the result is finite but never converged
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << ((x > 1.0 && x < 1.5) ? std::numeric_limits<double>::quiet_NaN() : 1.0);
+        return v;
+    };
+
+    const HankelIntegrationResult result = HankelIntegrator::Integrate(f, {0.0, 1.0, 2.0});
+    EXPECT_GT(result.failedEvaluations, 0);
+    EXPECT_FALSE(result.converged);
+    EXPECT_TRUE(result.value.allFinite());
+    EXPECT_LT(result.value(0), 2.0);
+
+    HankelIntegrationOptions options;
+    options.extrapolateTail = true;
+    const HankelIntegrationResult extrapolated =
+        HankelIntegrator::Integrate(f, {0.0, 1.0, 2.0, 3.0, 4.0}, options);
+    EXPECT_GT(extrapolated.failedEvaluations, 0);
+    EXPECT_FALSE(extrapolated.converged);
+
+    // Intact integrand: nothing failed
+    auto g = [](double) { return Eigen::VectorXd::Ones(1).eval(); };
+    const HankelIntegrationResult intact = HankelIntegrator::Integrate(g, {0.0, 1.0, 2.0});
+    EXPECT_EQ(intact.failedEvaluations, 0);
+    EXPECT_TRUE(intact.converged);
+}
+
+TEST(HankelIntegratorTest, ThrowsOnMissingBreakpoints) {
+    auto f = [](double) { return Eigen::VectorXd::Zero(1).eval(); };
+    EXPECT_THROW(HankelIntegrator::Integrate(f, {1.0}), std::invalid_argument);
+}
+
+TEST(HankelIntegratorTest, BatchedIntegrandIsBitIdentical) {
+    auto f = [](double x) {
+        Eigen::VectorXd v(2);
+        v << std::cyl_bessel_j(1.0, x) / (1.0 + x), std::exp(-x) * std::cos(3.0 * x);
+        return v;
+    };
+    int largestBatch = 0;
+    auto batch = [&](const double* x, int count, Eigen::VectorXd* values) {
+        largestBatch = std::max(largestBatch, count);
+        for (int i = 0; i < count; ++i) {
+            values[i] = f(x[i]);
+        }
+    };
+    const std::vector<double> breakpoints = {0.0, 3.8, 7.0, 10.2, 20.0};
+
+    HankelIntegrationResult reference = HankelIntegrator::Integrate(f, breakpoints);
+    HankelIntegrationResult batched = HankelIntegrator::IntegrateBatched(batch, 4, breakpoints);
+
+    EXPECT_EQ(largestBatch, 4);
+    EXPECT_EQ(batched.evaluations, reference.evaluations);
+    EXPECT_EQ(batched.value(0), reference.value(0));
+    EXPECT_EQ(batched.value(1), reference.value(1));
+    EXPECT_THROW(HankelIntegrator::IntegrateBatched(batch, 0, breakpoints), std::invalid_argument);
+}
+
+// ============================================================================
+// Partition-Extrapolation Tests
+// ============================================================================
+
+TEST(HankelIntegratorTest, ExtrapolatedTailConvergesWithFewIntervals) {
+    // Integral of J1 over [0, inf) = 1: the tail decays only like x^-1/2;
+    // with exp(-x/2), 1 - 0.5 / sqrt(1.25)
+    auto f = [](double x) {
+        Eigen::VectorXd v(2);
+        v << std::cyl_bessel_j(1.0, x), std::exp(-0.5 * x) * std::cyl_bessel_j(1.0, x);
+        return v;
+    };
+    const std::vector<double> zeros = HankelIntegrator::BesselJ1ZeroBreakpoints(1.0, 64);
+
+    HankelIntegrationOptions options;
+    options.relativeTolerance = 1e-10;
+    const HankelIntegrationResult truncated = HankelIntegrator::Integrate(f, zeros, options);
+    options.extrapolateTail = true;
+    const HankelIntegrationResult extrapolated = HankelIntegrator::Integrate(f, zeros, options);
+
+    EXPECT_GT(std::abs(truncated.value(0) - 1.0), 1e-2);
+    EXPECT_EQ(truncated.partitions, 0);
+
+    EXPECT_TRUE(extrapolated.converged);
+    EXPECT_NEAR(extrapolated.value(0), 1.0, 1e-9);
+    EXPECT_NEAR(extrapolated.value(1), 1.0 - 0.5 / std::sqrt(1.25), 1e-9);
+    EXPECT_LE(extrapolated.partitions, 24);
+    EXPECT_EQ(extrapolated.partitions % Constants::HANKEL_EXTRAPOLATION_ROUND, 0);
+    EXPECT_LT(extrapolated.evaluations, truncated.evaluations);
+    EXPECT_LE(extrapolated.extrapolationError, extrapolated.errorEstimate);
+    EXPECT_LE(std::abs(extrapolated.value(0) - 1.0), extrapolated.errorEstimate);
+}
+
+TEST(HankelIntegratorTest, ExtrapolationReportsBreakpointShortage) {
+    auto f = [](double x) {
+        Eigen::VectorXd v(1);
+        v << std::cyl_bessel_j(1.0, x);
+        return v;
+    };
+    HankelIntegrationOptions options;
+    options.extrapolateTail = true;
+    options.relativeTolerance = 1e-14;
+
+    const HankelIntegrationResult result =
+        HankelIntegrator::Integrate(f, HankelIntegrator::BesselJ1ZeroBreakpoints(1.0, 6), options);
+    EXPECT_FALSE(result.converged);
+    EXPECT_EQ(result.partitions, 6);
+    EXPECT_NEAR(result.value(0), 1.0, 1e-3);  // Still far better than the partial sum
+
+    EXPECT_THROW(HankelIntegrator::Integrate(f, {0.0, 3.8, 7.0}, options), std::invalid_argument);
+}
+
+// ============================================================================
+// Breakpoint Tests
+// ============================================================================
+
+TEST(HankelIntegratorTest, BreakpointsFollowBesselJ1Zeros) {
+    const double a = 0.125;
+    const double upperBound = Constants::HANKEL_INTEGRATION_BOUND / a;
+    std::vector<double> breakpoints = HankelIntegrator::BesselJ1Breakpoints(a, upperBound);
+
+    ASSERT_GE(breakpoints.size(), 3u);
+    EXPECT_EQ(breakpoints.front(), 0.0);
+    EXPECT_EQ(breakpoints.back(), upperBound);
+
+    // Interior breakpoints sit on zeros of J1(m*a), to rounding
+    for (size_t i = 1; i + 1 < breakpoints.size(); ++i) {
+        EXPECT_LT(breakpoints[i - 1], breakpoints[i]);
+        EXPECT_NEAR(std::cyl_bessel_j(1.0, breakpoints[i] * a), 0.0, 1e-14);
+    }
+    // and none is missing before the bound
+    EXPECT_GT(HankelIntegrator::BesselJ1ZeroBreakpoints(a, static_cast<int>(breakpoints.size()) - 1).back(),
+              upperBound);
+}
+
+TEST(HankelIntegratorTest, ZeroBreakpointsListTheFirstZeros) {
+    const double a = 0.125;
+    const std::vector<double> breakpoints = HankelIntegrator::BesselJ1ZeroBreakpoints(a, 40);
+
+    ASSERT_EQ(breakpoints.size(), 41u);
+    EXPECT_EQ(breakpoints.front(), 0.0);
+    const std::vector<double> truncated =
+        HankelIntegrator::BesselJ1Breakpoints(a, Constants::HANKEL_INTEGRATION_BOUND / a);
+    for (size_t i = 1; i + 1 < truncated.size(); ++i) {
+        EXPECT_EQ(breakpoints[i], truncated[i]);
+    }
+}
@@ -215,6 +215,279 @@ TEST_F(MatrixOperationsTest, FiveLayerStructure) {
     });
 }
 
+TEST_F(MatrixOperationsTest, BandedAssemblyMatchesDense) {
+    input.layerCount = 5;
+    input.poissonRatios.resize(5, 0.35);
+    input.youngModuli = {10000.0, 5000.0, 1000.0, 200.0, 50.0};
+    input.thicknesses = {0.08, 0.12, 0.20, 0.30, 100.0};
+    input.interfaceTypes = {0, 2, 1, 0};
+    
+    for (double m : {0.01, 1.0, 25.0}) {
+        Eigen::MatrixXd dense = MatrixOperations::AssembleSystemMatrix(m, input);
+        BandedMatrix banded = MatrixOperations::AssembleBandedSystem(m, AssemblyPlan(input));
+        EXPECT_EQ((banded.ToDense() - dense).cwiseAbs().maxCoeff(), 0.0) << "m = " << m;
+    }
+}
+
+TEST_F(MatrixOperationsTest, ManySublayerStructure) {
+    // 24 sublayers (e.g. a discretised temperature gradient) over a platform
+    const int layers = 25;
+    input.layerCount = layers;
+    input.poissonRatios.assign(layers, 0.35);
+    input.youngModuli.clear();
+    for (int i = 0; i < layers - 1; ++i) {
+        input.youngModuli.push_back(8000.0 - 300.0 * i);
+    }
+    input.youngModuli.push_back(50.0);
+    input.thicknesses.assign(layers - 1, 0.02);
+    input.thicknesses.push_back(100.0);
+    input.interfaceTypes.assign(layers - 1, 0);
+    
+    EXPECT_NO_THROW(input.Validate());
+    
+    const double m = 1.0;
+    Eigen::VectorXd coeffs = MatrixOperations::SolveCoefficients(m, input);
+    ASSERT_EQ(coeffs.size(), 4 * layers - 2);
+    
+    Eigen::MatrixXd M = MatrixOperations::AssembleSystemMatrix(m, input);
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(M.rows());
+    b(1) = -input.pressure;
+    EXPECT_LT((M * coeffs - b).norm(), Constants::RESIDUAL_TOLERANCE);
+}
+
+namespace {
+
+CalculationInput MakeStructure(int layers) {
+    CalculationInput structure;
+    structure.layerCount = layers;
+    structure.poissonRatios.assign(layers, 0.35);
+    structure.youngModuli.clear();
+    structure.thicknesses.clear();
+    for (int i = 0; i < layers - 1; ++i) {
+        structure.youngModuli.push_back(6000.0 / (i + 1));
+        structure.thicknesses.push_back(0.06 + 0.04 * i);
+    }
+    structure.youngModuli.push_back(50.0);
+    structure.thicknesses.push_back(100.0);
+    structure.interfaceTypes.assign(layers - 1, 0);
+    if (layers > 2) {
+        structure.interfaceTypes[0] = 2;  // Mix in an unbonded interface
+    }
+    return structure;
+}
+
+template <int LayerCount>
+void ExpectFixedMatchesDynamic() {
+    const CalculationInput structure = MakeStructure(LayerCount);
+    for (double m : {0.05, 1.0, 8.0}) {
+        SolveReport dynamicReport, fixedReport;
+        Eigen::VectorXd dynamic = MatrixOperations::SolveCoefficients(m, structure, &dynamicReport);
+        MatrixOperations::FixedCoefficients<LayerCount> fixed =
+            MatrixOperations::SolveCoefficientsFixed<LayerCount>(m, AssemblyPlan(structure), &fixedReport);
+        
+        ASSERT_EQ(fixed.size(), dynamic.size());
+        EXPECT_LT((fixed - dynamic).norm(), 1e-8 * dynamic.norm())
+            << LayerCount << " layers, m = " << m;
+        EXPECT_LT(fixedReport.residual, Constants::RESIDUAL_TOLERANCE);
+        EXPECT_GT(fixedReport.reciprocalCondition, 0.0);
+    }
+}
+
+} // namespace
+
+TEST_F(MatrixOperationsTest, FixedSizeSolverMatchesDynamic) {
+    ExpectFixedMatchesDynamic<2>();
+    ExpectFixedMatchesDynamic<3>();
+    ExpectFixedMatchesDynamic<4>();
+    ExpectFixedMatchesDynamic<5>();
+    ExpectFixedMatchesDynamic<6>();
+}
+
+TEST_F(MatrixOperationsTest, ConditionEstimateTracksExactCondition) {
+    SolveOptions diagnostics;
+    diagnostics.exactConditionNumber = true;
+    const int k = 4 * input.layerCount - 2;
+    
+    for (double m : {0.05, 1.0, 8.0}) {
+        SolveReport banded, fixed, plain;
+        MatrixOperations::SolveCoefficients(m, input, &banded, diagnostics);
+        MatrixOperations::SolveCoefficientsFixed<3>(m, AssemblyPlan(input), &fixed, diagnostics);
+        MatrixOperations::SolveCoefficients(m, input, &plain);
+        
+        // 1-norm and 2-norm condition numbers agree within a factor k
+        for (const SolveReport& report : {banded, fixed}) {
+            ASSERT_GT(report.exactConditionNumber, 0.0);
+            const double estimated = 1.0 / report.reciprocalCondition;
+            EXPECT_GT(estimated, report.exactConditionNumber / (2.0 * k)) << "m = " << m;
+            EXPECT_LT(estimated, report.exactConditionNumber * (2.0 * k)) << "m = " << m;
+        }
+        EXPECT_NEAR(banded.reciprocalCondition, fixed.reciprocalCondition,
+                    0.5 * banded.reciprocalCondition);
+        
+        // The SVD only runs on request
+        EXPECT_EQ(plain.exactConditionNumber, 0.0);
+        EXPECT_EQ(plain.reciprocalCondition, banded.reciprocalCondition);
+    }
+}
+
+TEST_F(MatrixOperationsTest, FixedSizeSolverRejectsOtherLayerCounts) {
+    EXPECT_THROW(MatrixOperations::SolveCoefficientsFixed<4>(1.0, AssemblyPlan(input)), std::invalid_argument);
+    
+    // The status kernel reports the mismatch instead of filling past its storage
+    SolveReport report;
+    MatrixOperations::FixedCoefficients<4> coefficients;
+    EXPECT_EQ(MatrixOperations::TrySolveCoefficientsFixed<4>(1.0, AssemblyPlan(input), coefficients, &report),
+              SolveStatus::InvalidInput);
+    EXPECT_EQ(report.status, SolveStatus::InvalidInput);
+}
+
+TEST_F(MatrixOperationsTest, BatchedSolveMatchesSolveCoefficients) {
+    const AssemblyPlan plan(input);
+    const int count = MatrixOperations::BATCH_SIZE - 1;  // Exercise a partial batch
+    std::vector<double> m(count);
+    for (int l = 0; l < count; ++l) {
+        m[l] = 0.05 + 1.5 * l;
+    }
+    
+    BatchSolveResult batch = MatrixOperations::SolveCoefficientsBatch(m.data(), count, plan);
+    
+    ASSERT_EQ(batch.coefficients.cols(), count);
+    ASSERT_EQ(batch.coefficients.rows(), plan.Size());
+    for (int l = 0; l < count; ++l) {
+        SolveReport report;
+        Eigen::VectorXd expected = MatrixOperations::SolveCoefficients(m[l], plan, &report);
+        EXPECT_EQ(batch.reports[l].status, SolveStatus::Ok) << MatrixOperations::StatusMessage(batch.reports[l].status);
+        EXPECT_LT((batch.coefficients.col(l) - expected).norm(), 1e-12 * expected.norm()) << "m = " << m[l];
+        EXPECT_NEAR(batch.reports[l].reciprocalCondition, report.reciprocalCondition,
+                    1e-12 * report.reciprocalCondition);
+        EXPECT_LT(batch.reports[l].residual, Constants::RESIDUAL_TOLERANCE);
+    }
+}
+
+TEST_F(MatrixOperationsTest, BatchedSolveRejectsBadCount) {
+    const AssemblyPlan plan(input);
+    std::vector<double> m(MatrixOperations::BATCH_SIZE + 1, 1.0);
+    EXPECT_THROW(MatrixOperations::SolveCoefficientsBatch(m.data(), 0, plan), std::invalid_argument);
+    EXPECT_THROW(MatrixOperations::SolveCoefficientsBatch(m.data(), MatrixOperations::BATCH_SIZE + 1, plan),
+                 std::invalid_argument);
+}
+
+TEST_F(MatrixOperationsTest, IterativeRefinementRescuesResidualFailures) {
+    // RESIDUAL_TOLERANCE is absolute: stiff layers over a very soft platform
+    // under an extreme load make the plain double solve miss it at some m
+    input.youngModuli = {20000.0, 20000.0, 20.0};
+    input.pressure = 1e8;
+    const AssemblyPlan plan(input);
+    SolveOptions plain;
+    plain.maxRefinementSteps = 0;
+    
+    int rescued = 0;
+    int refined = 0;
+    for (double m = 1.0; m < 600.0; m *= 1.01) {
+        bool plainSolved = true;
+        Eigen::VectorXd plainCoefficients;
+        try {
+            plainCoefficients = MatrixOperations::SolveCoefficients(m, plan, nullptr, plain);
+        } catch (const std::runtime_error&) {
+            plainSolved = false;
+        }
+        
+        SolveReport report;
+        Eigen::VectorXd coefficients;
+        try {
+            coefficients = MatrixOperations::SolveCoefficients(m, plan, &report);
+        } catch (const std::runtime_error&) {
+            EXPECT_FALSE(plainSolved) << "refinement lost a solution at m = " << m;
+            continue;
+        }
+        
+        EXPECT_LE(report.residual, Constants::RESIDUAL_TOLERANCE);
+        if (plainSolved) {
+            // Refinement only runs on solutions that miss the tolerance
+            EXPECT_EQ(report.refinementSteps, 0);
+            EXPECT_EQ(coefficients, plainCoefficients);
+        } else {
+            ++rescued;
+            refined += report.refinementSteps > 0 ? 1 : 0;
+        }
+    }
+    EXPECT_GT(rescued, 0);
+    EXPECT_GT(refined, 0);
+}
+
+TEST_F(MatrixOperationsTest, StatusKernelsMatchThrowingSolvers) {
+    // Same stiff structure without refinement, so some parameters fail
+    input.youngModuli = {20000.0, 20000.0, 20.0};
+    input.pressure = 1e9;
+    const AssemblyPlan plan(input);
+    SolveOptions plain;
+    plain.maxRefinementSteps = 0;
+    
+    int failures = 0;
+    for (double m = 1.0; m < 600.0; m *= 1.01) {
+        SolveReport report;
+        Eigen::VectorXd coefficients;
+        const SolveStatus status = MatrixOperations::TrySolveCoefficients(m, plan, coefficients, &report, plain);
+        
+        SolveReport fixedReport;
+        MatrixOperations::FixedCoefficients<3> fixedCoefficients;
+        const SolveStatus fixedStatus =
+            MatrixOperations::TrySolveCoefficientsFixed<3>(m, plan, fixedCoefficients, &fixedReport, plain);
+        EXPECT_EQ(fixedReport.status, fixedStatus);
+        
+        EXPECT_EQ(report.status, status);
+        if (status == SolveStatus::Ok) {
+            EXPECT_EQ(coefficients, MatrixOperations::SolveCoefficients(m, plan, nullptr, plain));
+            continue;
+        }
+        ++failures;
+        if (status == SolveStatus::ResidualTooLarge) {
+            EXPECT_GT(report.residual, Constants::RESIDUAL_TOLERANCE);
+        } else {
+            EXPECT_EQ(status, SolveStatus::Singular);
+        }
+        EXPECT_THROW(MatrixOperations::SolveCoefficients(m, plan, nullptr, plain), std::runtime_error);
+    }
+    EXPECT_GT(failures, 0);
+}
+
+TEST_F(MatrixOperationsTest, RefinementStepsAreReportedByEverySolver) {
+    input.youngModuli = {20000.0, 20000.0, 20.0};
+    input.pressure = 1e8;
+    const AssemblyPlan plan(input);
+    
+    std::vector<double> m;
+    for (double value = 1.0; value < 600.0; value *= 1.01) {
+        m.push_back(value);
+    }
+    
+    int bandedSteps = 0, fixedSteps = 0, batchedSteps = 0;
+    for (size_t i = 0; i < m.size(); ++i) {
+        SolveReport report;
+        try {
+            MatrixOperations::SolveCoefficients(m[i], plan, &report);
+            bandedSteps += report.refinementSteps;
+        } catch (const std::runtime_error&) {}
+        try {
+            MatrixOperations::SolveCoefficientsFixed<3>(m[i], plan, &report);
+            fixedSteps += report.refinementSteps;
+        } catch (const std::runtime_error&) {}
+    }
+    for (size_t i = 0; i + MatrixOperations::BATCH_SIZE <= m.size(); i += MatrixOperations::BATCH_SIZE) {
+        BatchSolveResult batch = MatrixOperations::SolveCoefficientsBatch(
+            &m[i], MatrixOperations::BATCH_SIZE, plan);
+        for (int l = 0; l < MatrixOperations::BATCH_SIZE; ++l) {
+            if (batch.reports[l].status == SolveStatus::Ok) {
+                EXPECT_LE(batch.reports[l].residual, Constants::RESIDUAL_TOLERANCE);
+                batchedSteps += batch.reports[l].refinementSteps;
+            }
+        }
+    }
+    EXPECT_GT(bandedSteps, 0);
+    EXPECT_GT(fixedSteps, 0);
+    EXPECT_GT(batchedSteps, 0);
+}
+
 // ============================================================================
 // Performance Tests
 // ============================================================================
@@ -214,10 +214,237 @@ TEST_F(PavementCalculatorTest, CalculateIndependentOfPriorCalls) {
     }
 }
 
+// ============================================================================
+// Hankel Integration Accuracy Tests
+// ============================================================================
+
+TEST_F(PavementCalculatorTest, ReportsIntegrationErrorAndCost) {
+    CalculationOutput output = calculator->Calculate(input);
+    
+    EXPECT_GT(output.integration.evaluations, 0);
+    EXPECT_GT(output.integration.intervals, 0);
+    EXPECT_GE(output.integration.errorEstimate, 0.0);
+    EXPECT_LE(output.integration.evaluations, Constants::HANKEL_MAX_EVALUATIONS);
+}
+
+TEST_F(PavementCalculatorTest, TighterToleranceCostsMoreEvaluations) {
+    PavementCalculator::CalculatorConfig loose;
+    loose.integration.relativeTolerance = 1e-3;
+    PavementCalculator::CalculatorConfig tight;
+    tight.integration.relativeTolerance = 1e-9;
+    
+    CalculationOutput coarse = PavementCalculator(loose).Calculate(input);
+    CalculationOutput fine = PavementCalculator(tight).Calculate(input);
+    
+    EXPECT_LE(coarse.integration.evaluations, fine.integration.evaluations);
+    EXPECT_LE(fine.integration.errorEstimate, coarse.integration.errorEstimate + 1e-12);
+}
+
+TEST_F(PavementCalculatorTest, SevenLayerStructureUsesDynamicSolver) {
+    // Beyond the fixed-size kernels (2-6 layers) the dynamic banded path is used
+    input.layerCount = 7;
+    input.poissonRatios.assign(7, 0.35);
+    input.youngModuli = {7000.0, 5000.0, 3000.0, 1500.0, 800.0, 200.0, 50.0};
+    input.thicknesses = {0.04, 0.06, 0.08, 0.10, 0.15, 0.25, 100.0};
+    input.interfaceTypes.assign(6, 0);
+    
+    CalculationOutput output = calculator->Calculate(input);
+    
+    ASSERT_EQ(output.deflection.size(), 13u);
+    for (double value : output.deflection) {
+        EXPECT_TRUE(std::isfinite(value));
+    }
+    EXPECT_GT(output.integration.evaluations, 0);
+}
+
+TEST_F(PavementCalculatorTest, ParallelIntegrationIsBitIdentical) {
+    PavementCalculator::CalculatorConfig serial;
+    serial.threadCount = 1;
+    CalculationOutput reference = PavementCalculator(serial).Calculate(input);
+    
+    for (int threads : {2, 3, 8}) {
+        PavementCalculator::CalculatorConfig parallel;
+        parallel.threadCount = threads;
+        CalculationOutput output = PavementCalculator(parallel).Calculate(input);
+        
+        EXPECT_EQ(output.integration.evaluations, reference.integration.evaluations);
+        for (size_t i = 0; i < reference.sigmaT.size(); ++i) {
+            EXPECT_EQ(output.sigmaT[i], reference.sigmaT[i]) << threads << " threads";
+            EXPECT_EQ(output.epsilonZ[i], reference.epsilonZ[i]) << threads << " threads";
+            EXPECT_EQ(output.deflection[i], reference.deflection[i]) << threads << " threads";
+        }
+    }
+}
+
+TEST_F(PavementCalculatorTest, BatchedSolverMatchesPointwiseSolver) {
+    // 7 layers: both paths run the banded LU, so only the batching differs
+    input.layerCount = 7;
+    input.poissonRatios.assign(7, 0.35);
+    input.youngModuli = {7000.0, 5000.0, 3000.0, 1500.0, 800.0, 200.0, 50.0};
+    input.thicknesses = {0.04, 0.06, 0.08, 0.10, 0.15, 0.25, 100.0};
+    input.interfaceTypes.assign(6, 0);
+    
+    PavementCalculator::CalculatorConfig pointwise;
+    pointwise.batchedSolver = false;
+    CalculationOutput reference = PavementCalculator(pointwise).Calculate(input);
+    CalculationOutput output = calculator->Calculate(input);
+    
+    EXPECT_EQ(output.integration.evaluations, reference.integration.evaluations);
+    EXPECT_EQ(output.integration.failedEvaluations, reference.integration.failedEvaluations);
+    for (size_t i = 0; i < reference.deflection.size(); ++i) {
+        EXPECT_NEAR(output.deflection[i], reference.deflection[i], 1e-9 * std::abs(reference.deflection[i]));
+        EXPECT_NEAR(output.sigmaT[i], reference.sigmaT[i], 1e-9 * std::abs(reference.sigmaT[i]) + 1e-12);
+    }
+}
+
+TEST_F(PavementCalculatorTest, ExtremeModulusContrastNeedsNoRefinement) {
+    // The stabilised layer basis keeps every system well conditioned: even
+    // the widest admissible contrast solves at every node without iterative
+    // refinement (MatrixOperationsTest covers the rescue itself)
+    input.youngModuli = {100000.0, 100000.0, 10.0};
+    input.pressure = 5.0;
+    
+    PavementCalculator::CalculatorConfig plain;
+    plain.solver.maxRefinementSteps = 0;
+    CalculationOutput unrefined = PavementCalculator(plain).Calculate(input);
+    CalculationOutput refined = calculator->Calculate(input);
+    
+    EXPECT_EQ(unrefined.integration.failedEvaluations, 0);
+    EXPECT_EQ(refined.integration.failedEvaluations, 0);
+    EXPECT_EQ(refined.integration.refinementSteps, 0);
+    for (size_t i = 0; i < refined.deflection.size(); ++i) {
+        EXPECT_TRUE(std::isfinite(refined.deflection[i]));
+        EXPECT_EQ(refined.deflection[i], unrefined.deflection[i]);
+    }
+}
+
+TEST_F(PavementCalculatorTest, ChebyshevInterpolationMatchesExactSolves) {
+    PavementCalculator::CalculatorConfig config;
+    config.integration.relativeTolerance = 1e-9;
+    CalculationOutput exact = PavementCalculator(config).Calculate(input);
+    
+    config.interpolation.enabled = true;
+    CalculationOutput interpolated = PavementCalculator(config).Calculate(input);
+    
+    EXPECT_EQ(exact.integration.interpolatedEvaluations, 0);
+    EXPECT_EQ(exact.integration.interpolationSolves, 0);
+    EXPECT_GT(interpolated.integration.interpolatedEvaluations, 0);
+    EXPECT_GT(interpolated.integration.interpolationSolves, 0);
+    
+    // Checks are quadrature nodes: every interpolated node is a solve saved
+    EXPECT_EQ(interpolated.integration.evaluations, exact.integration.evaluations);
+    EXPECT_LT(interpolated.integration.evaluations - interpolated.integration.interpolatedEvaluations,
+              exact.integration.evaluations);
+    
+    // Interpolation changes the result by less than the integration error
+    const double tolerance = exact.integration.errorEstimate + interpolated.integration.errorEstimate;
+    for (size_t i = 0; i < exact.deflection.size(); ++i) {
+        EXPECT_NEAR(interpolated.deflection[i], exact.deflection[i], tolerance);
+        EXPECT_NEAR(interpolated.sigmaZ[i], exact.sigmaZ[i], tolerance);
+    }
+}
+
+TEST_F(PavementCalculatorTest, ChebyshevInterpolationIsThreadCountIndependent) {
+    PavementCalculator::CalculatorConfig config;
+    config.integration.relativeTolerance = 1e-9;
+    config.interpolation.enabled = true;
+    CalculationOutput serial = PavementCalculator(config).Calculate(input);
+    
+    config.threadCount = 4;
+    CalculationOutput parallel = PavementCalculator(config).Calculate(input);
+    
+    EXPECT_EQ(parallel.integration.interpolatedEvaluations, serial.integration.interpolatedEvaluations);
+    EXPECT_EQ(parallel.integration.interpolationSolves, serial.integration.interpolationSolves);
+    for (size_t i = 0; i < serial.deflection.size(); ++i) {
+        EXPECT_EQ(parallel.deflection[i], serial.deflection[i]);
+        EXPECT_EQ(parallel.sigmaT[i], serial.sigmaT[i]);
+    }
+}
+
 // ============================================================================
 // Performance Tests
 // ============================================================================
 
+TEST_F(PavementCalculatorTest, ExtrapolatedTailMatchesTruncatedIntegral) {
+    PavementCalculator::CalculatorConfig config;
+    config.integration.extrapolateTail = true;
+    PavementCalculator extrapolating(config);
+    CalculationOutput truncated = calculator->Calculate(input);
+    CalculationOutput extrapolated = extrapolating.Calculate(input);
+    
+    EXPECT_EQ(truncated.integration.partitions, 0);
+    EXPECT_TRUE(extrapolated.integration.converged);
+    EXPECT_GT(extrapolated.integration.partitions, 0);
+    EXPECT_LT(extrapolated.integration.partitions, config.integration.maxPartitions);
+    EXPECT_LE(extrapolated.integration.evaluations, truncated.integration.evaluations);
+    
+    // Below the surface the integrand decays like exp(-m*z), so truncation
+    // loses nothing; on the surface it does not decay and only the
+    // extrapolated integral reaches the applied pressure
+    double scale = 0.0;
+    for (size_t i = 0; i < truncated.epsilonZ.size(); ++i) {
+        scale = std::max(scale, std::abs(truncated.epsilonZ[i]));
+    }
+    for (size_t i = 1; i < truncated.epsilonZ.size(); ++i) {
+        EXPECT_NEAR(extrapolated.epsilonZ[i], truncated.epsilonZ[i], 1e-5 * scale);
+        EXPECT_NEAR(extrapolated.epsilonT[i], truncated.epsilonT[i], 1e-5 * scale);
+    }
+    EXPECT_NEAR(extrapolated.sigmaZ[0], input.pressure, 1e-4 * input.pressure);
+    
+    // Load cases take the same route
+    const std::vector<CalculationOutput> cases =
+        extrapolating.CalculateLoadCases(input, {SurfaceLoad{input.pressure}});
+    EXPECT_GT(cases[0].integration.partitions, 0);
+    EXPECT_NEAR(cases[0].epsilonZ[1], extrapolated.epsilonZ[1], 1e-5 * scale);
+}
+
+TEST_F(PavementCalculatorTest, LoadCasesMatchSeparateCalculations) {
+    // Traffic classes: the reference wheel, a heavier one on a larger and a
+    // lighter one on a smaller footprint, and an empty case
+    const std::vector<SurfaceLoad> loads = {
+        {input.pressure, 0.0}, {0.8, 0.16}, {0.5, 0.1}, {0.0, 0.2}};
+    std::vector<CalculationOutput> cases = calculator->CalculateLoadCases(input, loads);
+    ASSERT_EQ(cases.size(), loads.size());
+    EXPECT_TRUE(cases[0].integration.converged);
+    
+    for (size_t c = 0; c < 3; ++c) {
+        CalculationInput single = input;
+        single.pressure = loads[c].pressure;
+        single.contactRadius = c == 0 ? input.contactRadius : loads[c].contactRadius;
+        const CalculationOutput expected = calculator->Calculate(single);
+        
+        // Below the surface (on it the truncated integral depends on the
+        // truncation bound, which follows the smallest radius)
+        const double tolerance = expected.integration.errorEstimate + cases[c].integration.errorEstimate;
+        for (size_t i = 1; i < expected.deflection.size(); ++i) {
+            EXPECT_NEAR(cases[c].deflection[i], expected.deflection[i], tolerance) << "case " << c;
+            EXPECT_NEAR(cases[c].sigmaZ[i], expected.sigmaZ[i], tolerance) << "case " << c;
+            EXPECT_NEAR(cases[c].epsilonT[i], expected.epsilonT[i], tolerance) << "case " << c;
+        }
+    }
+    for (size_t i = 0; i < cases[3].deflection.size(); ++i) {
+        EXPECT_EQ(cases[3].deflection[i], 0.0);
+        EXPECT_EQ(cases[3].epsilonT[i], 0.0);
+    }
+    EXPECT_EQ(cases[3].integration.evaluations, cases[0].integration.evaluations);
+}
+
+TEST_F(PavementCalculatorTest, LoadCasesRejectInvalidLoads) {
+    EXPECT_THROW(calculator->CalculateLoadCases(input, {{-0.1, 0.0}}), std::invalid_argument);
+    EXPECT_THROW(calculator->CalculateLoadCases(input, {{0.5, -0.1}}), std::invalid_argument);
+    EXPECT_THROW(calculator->CalculateLoadCases(input, {{0.5, 1.5}}), std::invalid_argument);
+    
+    // Same limits as CalculationInput::Validate
+    EXPECT_THROW(calculator->CalculateLoadCases(input, {{1.01 * Constants::MAX_TIRE_PRESSURE, 0.0}}),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(calculator->CalculateLoadCases(
+        input, {{Constants::MAX_TIRE_PRESSURE, Constants::MAX_CONTACT_RADIUS}}));
+}
+
+TEST_F(PavementCalculatorTest, LoadCasesRequireALoad) {
+    EXPECT_THROW(calculator->CalculateLoadCases(input, {}), std::invalid_argument);
+}
+
 TEST_F(PavementCalculatorTest, CalculationPerformance) {
     auto start = std::chrono::high_resolution_clock::now();
     
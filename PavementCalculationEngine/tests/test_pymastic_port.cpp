@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "PyMasticSolver.h"
+#include "SpecialFunctions.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <stdexcept>
 
 /**
  * @brief Test PyMastic C++ port against reference values
@@ -118,4 +122,276 @@ TEST_F(PyMasticPortTest, SolverMethodsTest) {
             EXPECT_TRUE(output.IsValid()) << "Method " << method << " produced invalid results";
         }) << "Solver method " << method << " failed";
     }
-}
\ No newline at end of file
+    
+    // Names are parsed once per call; unknown ones fail validation up front
+    PyMasticSolver::Inverser parsed;
+    EXPECT_TRUE(PyMasticSolver::ParseInverser("lu", parsed));
+    EXPECT_EQ(parsed, PyMasticSolver::Inverser::Lu);
+    EXPECT_FALSE(PyMasticSolver::ParseInverser("qr", parsed));
+    input.inverser = "qr";
+    EXPECT_FALSE(input.Validate());
+    EXPECT_THROW(solver.Compute(input), std::invalid_argument);
+}
+TEST_F(PyMasticPortTest, GridMatchesSingleDepthRuns) {
+    // The m grid depends only on the x offsets, so each row of a depth grid
+    // must equal a run at that depth alone
+    PyMasticSolver solver;
+    input.x_offsets = {0, 4, 8, 12};
+    input.z_depths = {0, 5, 9.99, 10.01, 16.5, 30};
+    auto grid = solver.Compute(input);
+    ASSERT_TRUE(grid.IsValid());
+    
+    PyMasticSolver::Input single = input;
+    for (size_t i = 0; i < input.z_depths.size(); ++i) {
+        single.z_depths = {input.z_depths[i]};
+        auto row = solver.Compute(single);
+        for (size_t j = 0; j < input.x_offsets.size(); ++j) {
+            const int r = static_cast<int>(i), c = static_cast<int>(j);
+            EXPECT_NEAR(grid.displacement_z(r, c), row.displacement_z(0, c), 1e-12 * std::abs(row.displacement_z(0, c)));
+            EXPECT_NEAR(grid.displacement_h(r, c), row.displacement_h(0, c), 1e-12 * std::abs(row.displacement_h(0, c)));
+            EXPECT_NEAR(grid.stress_z(r, c), row.stress_z(0, c), 1e-12 * std::abs(row.stress_z(0, c)));
+            EXPECT_NEAR(grid.stress_r(r, c), row.stress_r(0, c), 1e-12 * std::abs(row.stress_r(0, c)));
+            EXPECT_NEAR(grid.stress_t(r, c), row.stress_t(0, c), 1e-12 * std::abs(row.stress_t(0, c)));
+            EXPECT_NEAR(grid.strain_r(r, c), row.strain_r(0, c), 1e-12 * std::abs(row.strain_r(0, c)));
+        }
+    }
+}
+
+namespace {
+
+// Largest difference relative to the largest magnitude, over all responses
+double MaxRelativeDifference(const PyMasticSolver::Output& a, const PyMasticSolver::Output& b) {
+    double worst = 0.0;
+    auto compare = [&worst](const Eigen::MatrixXd& x, const Eigen::MatrixXd& y) {
+        if (x.size() == 0) return;  // Not requested
+        worst = std::max(worst, (x - y).cwiseAbs().maxCoeff() / y.cwiseAbs().maxCoeff());
+    };
+    compare(a.displacement_z, b.displacement_z);
+    compare(a.displacement_h, b.displacement_h);
+    compare(a.stress_z, b.stress_z);
+    compare(a.stress_r, b.stress_r);
+    compare(a.stress_t, b.stress_t);
+    compare(a.strain_z, b.strain_z);
+    compare(a.strain_r, b.strain_r);
+    compare(a.strain_t, b.strain_t);
+    return worst;
+}
+
+} // namespace
+
+TEST_F(PyMasticPortTest, LiveModulusUpdatesMatchFreshRuns) {
+    // Four layers, mixed bonding: three interfaces padded to a four-leaf tree
+    input.x_offsets = {0, 6, 15};
+    input.z_depths = {0, 4, 10.01, 14, 25};
+    input.H_thicknesses = {5, 6, 8};
+    input.E_moduli = {500, 120, 40, 10};
+    input.nu_poisson = {0.35, 0.35, 0.4, 0.45};
+    input.bonded_interfaces = {1, 0, 1};
+    
+    PyMasticSolver live;
+    PyMasticSolver fresh;
+    EXPECT_FALSE(live.HasLiveStructure());
+    EXPECT_LT(MaxRelativeDifference(live.ComputeLive(input), fresh.Compute(input)), 1e-12);
+    EXPECT_TRUE(live.HasLiveStructure());
+    EXPECT_EQ(live.LastRebuiltInterfaces(), 3);
+    
+    // Slider-style sequence of edits, each compared with a run from scratch
+    const struct { int layer; double E; double nu; int rebuilt; } edits[] = {
+        {1, 200.0, 0.30, 2}, {0, 350.0, 0.33, 1}, {3, 15.0, 0.40, 1}, {2, 55.0, 0.42, 2}, {1, 90.0, 0.25, 2},
+    };
+    for (const auto& edit : edits) {
+        input.E_moduli[edit.layer] = edit.E;
+        input.nu_poisson[edit.layer] = edit.nu;
+        auto updated = live.UpdateLayerModulus(edit.layer, edit.E, edit.nu);
+        ASSERT_TRUE(updated.IsValid());
+        EXPECT_LT(MaxRelativeDifference(updated, fresh.Compute(input)), 1e-12) << "layer " << edit.layer;
+        EXPECT_EQ(live.LastRebuiltInterfaces(), edit.rebuilt);
+    }
+    EXPECT_EQ(live.LiveInput().E_moduli, input.E_moduli);
+    EXPECT_EQ(live.LiveInput().nu_poisson, input.nu_poisson);
+}
+
+TEST_F(PyMasticPortTest, LiveThicknessUpdateAndErrors) {
+    PyMasticSolver solver;
+    EXPECT_THROW(solver.UpdateLayerModulus(0, 400, 0.35), std::logic_error);
+    EXPECT_THROW(solver.UpdateLayerThickness(0, 8), std::logic_error);
+    EXPECT_THROW(solver.LiveInput(), std::logic_error);
+    
+    solver.ComputeLive(input);
+    input.H_thicknesses[1] = 9;
+    auto updated = solver.UpdateLayerThickness(1, 9);
+    EXPECT_LT(MaxRelativeDifference(updated, PyMasticSolver().Compute(input)), 1e-12);
+    EXPECT_EQ(solver.LastRebuiltInterfaces(), 2);
+    
+    // Rejected edits keep the live structure unchanged
+    EXPECT_THROW(solver.UpdateLayerModulus(3, 400, 0.35), std::invalid_argument);
+    EXPECT_THROW(solver.UpdateLayerModulus(0, -1, 0.35), std::invalid_argument);
+    EXPECT_THROW(solver.UpdateLayerThickness(2, 5), std::invalid_argument);  // Semi-infinite
+    EXPECT_THROW(solver.UpdateLayerThickness(0, 0), std::invalid_argument);
+    EXPECT_TRUE(solver.HasLiveStructure());
+    EXPECT_EQ(solver.LiveInput().E_moduli, input.E_moduli);
+    EXPECT_EQ(solver.LiveInput().H_thicknesses, input.H_thicknesses);
+}
+
+TEST_F(PyMasticPortTest, ThreadedRunsMatchSerial) {
+    input.x_offsets.clear();
+    for (int j = 0; j < 23; ++j) input.x_offsets.push_back(0.75 * j);
+    input.z_depths = {0, 2, 5, 9.99, 10.01, 12, 16.5, 20, 30};
+    input.bonded_interfaces = {1, 0};
+    input.iterations = 30;
+    
+    PyMasticSolver solver;
+    auto serial = solver.Compute(input);
+    ASSERT_TRUE(serial.IsValid());
+    
+    for (int threads : {2, 4, 0}) {
+        input.threads = threads;
+        EXPECT_LT(MaxRelativeDifference(solver.Compute(input), serial), 1e-13) << threads << " threads";
+    }
+    
+    // Live structure on the pool as well
+    input.threads = 3;
+    PyMasticSolver live;
+    EXPECT_LT(MaxRelativeDifference(live.ComputeLive(input), serial), 1e-12);
+    input.E_moduli[1] = 65;
+    input.threads = 1;
+    EXPECT_LT(MaxRelativeDifference(live.UpdateLayerModulus(1, 65, 0.4), solver.Compute(input)), 1e-12);
+}
+
+TEST_F(PyMasticPortTest, ResponseMaskComputesOnlyRequestedMatrices) {
+    input.x_offsets = {0, 4, 8, 12};
+    input.z_depths = {0, 5, 9.99, 10.01, 16.5, 30};
+    input.bonded_interfaces = {1, 0};
+    PyMasticSolver solver;
+    const auto full = solver.Compute(input);
+    ASSERT_TRUE(full.IsValid());
+    
+    // Fatigue screening: strains only, no stress matrices kept
+    const unsigned masks[] = {
+        PyMasticSolver::StrainR | PyMasticSolver::StrainZ,
+        PyMasticSolver::DisplacementZ,
+        PyMasticSolver::DisplacementH | PyMasticSolver::StressT,
+        PyMasticSolver::Stresses,
+    };
+    for (unsigned mask : masks) {
+        input.responses = mask;
+        const auto partial = solver.Compute(input);
+        EXPECT_EQ(partial.responses, mask);
+        EXPECT_TRUE(partial.IsValid());
+        EXPECT_EQ(partial.stress_z.size() > 0, partial.Has(PyMasticSolver::StressZ));
+        EXPECT_EQ(partial.strain_t.size() > 0, partial.Has(PyMasticSolver::StrainT));
+        EXPECT_EQ(partial.displacement_z.size() > 0, partial.Has(PyMasticSolver::DisplacementZ));
+        EXPECT_LT(MaxRelativeDifference(partial, full), 1e-12) << "mask " << mask;
+    }
+    
+    // The mask carries over to live updates
+    input.responses = PyMasticSolver::StrainR;
+    PyMasticSolver live;
+    live.ComputeLive(input);
+    const auto updated = live.UpdateLayerModulus(1, 65, 0.4);
+    EXPECT_EQ(updated.strain_z.size(), 0);
+    input.E_moduli[1] = 65;
+    EXPECT_LT(MaxRelativeDifference(updated, solver.Compute(input)), 1e-12);
+    
+    input.responses = 0;
+    EXPECT_FALSE(input.Validate());
+    input.responses = PyMasticSolver::AllResponses + 1;
+    EXPECT_FALSE(input.Validate());
+}
+
+TEST_F(PyMasticPortTest, GeneratedBesselZerosMatchTables) {
+    // First and 50th zeros of the former PyMastic tables (15 significant digits)
+    const std::vector<double> j0 = PyMasticSolver::ComputeBesselZeros(0, 400);
+    const std::vector<double> j1 = PyMasticSolver::ComputeBesselZeros(1, 400);
+    ASSERT_EQ(j0.size(), 400u);
+    EXPECT_NEAR(j0[0], 2.40482555769577, 1e-13);
+    EXPECT_NEAR(j0[49], 156.295034268534, 1e-12);
+    EXPECT_NEAR(j1[0], 3.83170597020751, 1e-13);
+    EXPECT_NEAR(j1[49], 157.862655401930, 1e-12);
+    
+    // Deep zeros: ascending, spaced by ~pi, and roots of the kernels
+    for (int k = 1; k < 400; ++k) {
+        EXPECT_NEAR(j0[k] - j0[k - 1], 3.141592653589793, 0.05) << "k = " << k;
+        EXPECT_NEAR(j1[k] - j1[k - 1], 3.141592653589793, 0.05) << "k = " << k;
+    }
+    // One ulp of x near 1255 moves J by ~5e-15
+    EXPECT_NEAR(Pavement::SpecialFunctions::BesselJ0(j0[399]), 0.0, 1e-14);
+    EXPECT_NEAR(Pavement::SpecialFunctions::BesselJ1(j1[399]), 0.0, 1e-14);
+    
+    // Cached prefixes are returned unchanged
+    EXPECT_EQ(PyMasticSolver::ComputeBesselZeros(0, 10), std::vector<double>(j0.begin(), j0.begin() + 10));
+    EXPECT_THROW(PyMasticSolver::ComputeBesselZeros(2, 10), std::invalid_argument);
+}
+
+TEST_F(PyMasticPortTest, DeepTailIntegrationOnManyOffsets) {
+    // 120 offsets: the dense j0/ro sequences of the far offsets take the
+    // first breakpoints, so the tail needs far more than 50 zeros
+    input.x_offsets.clear();
+    for (int j = 0; j < 120; ++j) input.x_offsets.push_back(0.25 * j);
+    input.z_depths = {0.5, 9.99, 20};
+    
+    PyMasticSolver solver;
+    input.iterations = 40;
+    auto shallow = solver.Compute(input);
+    input.iterations = 300;
+    auto deep = solver.Compute(input);
+    input.iterations = 500;
+    auto deeper = solver.Compute(input);
+    ASSERT_TRUE(deeper.IsValid());
+    
+    // Deep runs agree with each other, the 40-iteration run has not converged
+    auto row_difference = [](const Eigen::MatrixXd& a, const Eigen::MatrixXd& b, int row) {
+        return (a.row(row) - b.row(row)).cwiseAbs().maxCoeff() / b.row(row).cwiseAbs().maxCoeff();
+    };
+    EXPECT_LT(row_difference(deep.stress_z, deeper.stress_z, 1), 1e-2);
+    EXPECT_LT(row_difference(deep.strain_r, deeper.strain_r, 2), 1e-3);
+    EXPECT_GT(row_difference(shallow.stress_z, deeper.stress_z, 1), 0.1);
+    
+    input.iterations = 0;
+    EXPECT_FALSE(input.Validate());
+}
+
+TEST_F(PyMasticPortTest, GridCacheSharesGridsByNormalisedGeometry) {
+    // Nonzero offsets: x = 0 is replaced by an absolute 1e-6, which does not scale
+    input.x_offsets = {2, 8};
+    PyMasticSolver::ResetGridCache();
+    PyMasticSolver first;
+    auto reference = first.Compute(input);
+    EXPECT_EQ(PyMasticSolver::GetGridCacheStats().misses, 1u);
+    EXPECT_EQ(PyMasticSolver::GetGridCacheStats().hits, 0u);
+    
+    // Other moduli, another instance: same grid
+    PyMasticSolver second;
+    input.E_moduli = {300, 50, 12};
+    second.Compute(input);
+    // Geometry scaled by 2 normalises to the same a/sumH and x/sumH
+    PyMasticSolver::Input scaled = input;
+    scaled.a_m *= 2;
+    for (double& x : scaled.x_offsets) x *= 2;
+    for (double& z : scaled.z_depths) z *= 2;
+    for (double& h : scaled.H_thicknesses) h *= 2;
+    auto doubled = second.Compute(scaled);
+    PyMasticSolver::GridCacheStats stats = PyMasticSolver::GetGridCacheStats();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.entries, 1u);
+    EXPECT_TRUE(doubled.IsValid());
+    
+    // Cached grids give the results of a fresh build
+    input.E_moduli = {500, 40, 10};
+    PyMasticSolver::ResetGridCache(0);
+    EXPECT_EQ(MaxRelativeDifference(first.Compute(input), reference), 0.0);
+    EXPECT_EQ(PyMasticSolver::GetGridCacheStats().entries, 0u);
+    
+    // Capacity 1: alternating iteration counts evict each other
+    PyMasticSolver::ResetGridCache(1);
+    for (int iterations : {10, 20, 10, 20}) {
+        input.iterations = iterations;
+        first.Compute(input);
+    }
+    EXPECT_EQ(PyMasticSolver::GetGridCacheStats().misses, 4u);
+    first.Compute(input);
+    EXPECT_EQ(PyMasticSolver::GetGridCacheStats().hits, 1u);
+    
+    PyMasticSolver::ResetGridCache();
+}
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include "SpecialFunctions.h"
+#include "SpecialFunctionKernels.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Pavement;
+
+namespace {
+
+struct BesselReference {
+    double x;
+    double j0;
+    double j1;
+};
+
+// High-precision series (x <= 45) and asymptotic (x > 45) evaluations
+const BesselReference REFERENCES[] = {
+    {0.5, 9.38469807240812858851e-01, 2.42268457674873899377e-01},
+    {1.0, 7.65197686557966605392e-01, 4.40050585744933497878e-01},
+    {7.5, 2.66339657880378388732e-01, 1.35248427579705510215e-01},
+    {8.0, 1.71650807137553901294e-01, 2.34636346853914629085e-01},
+    {8.5, 4.19392518429345037556e-02, 2.73121963674053724880e-01},
+    {10.0, -2.45935764451348348736e-01, 4.34727461688614383317e-02},
+    {25.25, 1.24142086036339097110e-01, -9.65392097194813919581e-02},
+    {60.0, -9.14718040890618727667e-02, 4.65983837581663146166e-02},
+    {150.0, -7.74090375394291237490e-04, -6.51451636577273646145e-02},
+};
+
+} // namespace
+
+TEST(SpecialFunctionsTest, BesselMatchesReferenceValues) {
+    for (const BesselReference& r : REFERENCES) {
+        EXPECT_NEAR(SpecialFunctions::BesselJ0(r.x), r.j0, 5e-16) << "x = " << r.x;
+        EXPECT_NEAR(SpecialFunctions::BesselJ1(r.x), r.j1, 5e-16) << "x = " << r.x;
+    }
+    EXPECT_NEAR(SpecialFunctions::BesselJ0(0.0), 1.0, 5e-16);
+    EXPECT_EQ(SpecialFunctions::BesselJ1(0.0), 0.0);
+    EXPECT_NEAR(SpecialFunctions::BesselJ0(2.404825557695773), 0.0, 1e-15);  // First zeros
+    EXPECT_NEAR(SpecialFunctions::BesselJ1(3.831705970207512), 0.0, 1e-15);
+}
+
+TEST(SpecialFunctionsTest, BesselZerosAreRoots) {
+    const std::vector<double> j0 = SpecialFunctions::BesselZeros(0, 100);
+    const std::vector<double> j1 = SpecialFunctions::BesselZeros(1, 100);
+    ASSERT_EQ(j1.size(), 100u);
+    EXPECT_NEAR(j0[0], 2.404825557695773, 1e-14);
+    EXPECT_NEAR(j1[0], 3.831705970207512, 1e-14);
+    // One ulp of x near 300 moves J by ~3e-15
+    for (int k = 0; k < 100; ++k) {
+        EXPECT_NEAR(SpecialFunctions::BesselJ0(j0[k]), 0.0, 1e-14) << "k = " << k;
+        EXPECT_NEAR(SpecialFunctions::BesselJ1(j1[k]), 0.0, 1e-14) << "k = " << k;
+        if (k > 0) {
+            EXPECT_GT(j1[k], j1[k - 1]);
+        }
+    }
+
+    // Cached prefixes are returned unchanged
+    EXPECT_EQ(SpecialFunctions::BesselZeros(1, 3), std::vector<double>(j1.begin(), j1.begin() + 3));
+    EXPECT_THROW(SpecialFunctions::BesselZeros(2, 3), std::invalid_argument);
+    EXPECT_THROW(SpecialFunctions::BesselZeros(1, -1), std::invalid_argument);
+}
+
+TEST(SpecialFunctionsTest, BesselParity) {
+    for (double x : {0.3, 5.0, 8.0, 12.7, 99.0}) {
+        EXPECT_EQ(SpecialFunctions::BesselJ0(-x), SpecialFunctions::BesselJ0(x));
+        EXPECT_EQ(SpecialFunctions::BesselJ1(-x), -SpecialFunctions::BesselJ1(x));
+    }
+}
+
+TEST(SpecialFunctionsTest, ArraysMatchScalarCallsForAnyLength) {
+    // Lengths that leave partial packs for every lane count
+    for (int count : {1, 3, 7, 8, 13, 64}) {
+        std::vector<double> x(count);
+        for (int i = 0; i < count; ++i) {
+            x[i] = 0.37 + 2.9 * i;
+        }
+        std::vector<double> j0(count), j1(count);
+        SpecialFunctions::BesselJ0(x.data(), j0.data(), count);
+        SpecialFunctions::BesselJ1(x.data(), j1.data(), count);
+        for (int i = 0; i < count; ++i) {
+            EXPECT_EQ(j0[i], SpecialFunctions::BesselJ0(x[i])) << "count " << count << ", x = " << x[i];
+            EXPECT_EQ(j1[i], SpecialFunctions::BesselJ1(x[i])) << "count " << count << ", x = " << x[i];
+        }
+
+        // In place
+        std::vector<double> negated(count);
+        for (int i = 0; i < count; ++i) {
+            negated[i] = -x[i];
+        }
+        SpecialFunctions::Exp(negated.data(), negated.data(), count);
+        for (int i = 0; i < count; ++i) {
+            EXPECT_NEAR(negated[i], std::exp(-x[i]), 4.5e-16 * std::exp(-x[i]));
+        }
+    }
+}
+
+TEST(SpecialFunctionsTest, ExpMatchesStandardLibrary) {
+    std::vector<double> x;
+    for (double v = -740.0; v <= 709.0; v += 0.731) {
+        x.push_back(v);
+    }
+    std::vector<double> result(x.size());
+    SpecialFunctions::Exp(x.data(), result.data(), static_cast<int>(x.size()));
+
+    for (size_t i = 0; i < x.size(); ++i) {
+        const double expected = std::exp(x[i]);
+        if (expected < std::numeric_limits<double>::min()) {
+            // Subnormal results carry fewer significant bits: compare absolutely
+            EXPECT_NEAR(result[i], expected, 1e-300 * std::numeric_limits<double>::epsilon()) << "x = " << x[i];
+        } else {
+            EXPECT_NEAR(result[i], expected, 4.5e-16 * expected) << "x = " << x[i];
+        }
+    }
+}
+
+TEST(SpecialFunctionsTest, ExpSpecialValues) {
+    const double inf = std::numeric_limits<double>::infinity();
+    double x[] = {0.0, 710.0, -746.0, inf, -inf, std::numeric_limits<double>::quiet_NaN()};
+    double result[6];
+    SpecialFunctions::Exp(x, result, 6);
+
+    EXPECT_EQ(result[0], 1.0);
+    EXPECT_EQ(result[1], inf);
+    EXPECT_EQ(result[2], 0.0);
+    EXPECT_EQ(result[3], inf);
+    EXPECT_EQ(result[4], 0.0);
+    EXPECT_TRUE(std::isnan(result[5]));
+    EXPECT_NE(std::string(SpecialFunctions::InstructionSet()), "");
+}
+
+TEST(SpecialFunctionsTest, EveryRunnableKernelBuildAgrees) {
+    namespace Kernels = SpecialFunctionKernels;
+    std::vector<Kernels::Table> tables = {Kernels::Baseline()};
+    if (Kernels::CpuSupportsAvx2()) {
+        tables.push_back(Kernels::Avx2());
+    }
+    if (Kernels::CpuSupportsAvx512()) {
+        tables.push_back(Kernels::Avx512());
+    }
+
+    // The widest runnable build is the one in use
+    EXPECT_STREQ(SpecialFunctions::InstructionSet(), tables.back().instructionSet);
+
+    std::vector<double> x;
+    for (double v = -60.0; v <= 60.0; v += 0.173) {
+        x.push_back(v);
+    }
+    const int count = static_cast<int>(x.size());
+    std::vector<double> j0(count), j1(count), e(count);
+    Kernels::Baseline().besselJ0(x.data(), j0.data(), count);
+    Kernels::Baseline().besselJ1(x.data(), j1.data(), count);
+    Kernels::Baseline().exp(x.data(), e.data(), count);
+    for (const Kernels::Table& table : tables) {
+        std::vector<double> otherJ0(count), otherJ1(count), otherE(count);
+        table.besselJ0(x.data(), otherJ0.data(), count);
+        table.besselJ1(x.data(), otherJ1.data(), count);
+        table.exp(x.data(), otherE.data(), count);
+        for (int i = 0; i < count; ++i) {
+            // Contracted multiply-adds (AVX-512 builds with FMA) move the
+            // last bits; each build is within a few 1e-16 of the true value
+            EXPECT_NEAR(otherJ0[i], j0[i], 1e-15) << table.instructionSet << ", x = " << x[i];
+            EXPECT_NEAR(otherJ1[i], j1[i], 1e-15) << table.instructionSet << ", x = " << x[i];
+            EXPECT_NEAR(otherE[i], e[i], 9e-16 * e[i]) << table.instructionSet << ", x = " << x[i];
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "ThreadPool.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace Pavement;
+
+TEST(ThreadPoolTest, ParallelForVisitsEveryIndexOnce) {
+    ThreadPool pool(4);
+    EXPECT_EQ(pool.GetThreadCount(), 4);
+
+    std::vector<std::atomic<int>> visits(1000);
+    pool.ParallelFor(1000, [&](int i) { visits[i].fetch_add(1); });
+
+    for (const auto& count : visits) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, SingleThreadRunsInline) {
+    ThreadPool pool(1);
+    EXPECT_EQ(pool.GetThreadCount(), 1);
+
+    std::vector<int> order;
+    pool.ParallelFor(5, [&](int i) { order.push_back(i); });
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2, 3, 4}));
+}
+
+TEST(ThreadPoolTest, NestedParallelForCompletes) {
+    ThreadPool pool(3);
+    std::atomic<int> total{0};
+
+    pool.ParallelFor(8, [&](int) {
+        pool.ParallelFor(8, [&](int) { total.fetch_add(1); });
+    });
+
+    EXPECT_EQ(total.load(), 64);
+}
+
+TEST(ThreadPoolTest, RethrowsIterationException) {
+    ThreadPool pool(4);
+    EXPECT_THROW(pool.ParallelFor(100, [](int i) {
+        if (i == 57) throw std::runtime_error("iteration failed");
+    }), std::runtime_error);
+}
@@ -1,10 +1,11 @@
 /**
  * @file test_trmm_solver.cpp
  * @brief Google Test suite for TRMM Solver
- * 
- * Tests the Transmission and Reflection Matrix Method implementation,
- * focusing on numerical stability for extreme cases that fail with TMM.
- * 
+ *
+ * Tests the Transmission and Reflection Matrix Method implementation:
+ * closed-form half-space solutions, interface conditions, and numerical
+ * stability for extreme m*h values that overflow the transfer matrix method.
+ *
  * @author Pavement Calculation Team
  * @date 2025-10-05
  */
@@ -13,400 +14,210 @@
 #include "TRMMSolver.h"
 #include "PavementData.h"
 #include <cmath>
+#include <stdexcept>
 #include <vector>
 
 using namespace PavementCalculation;
+using Pavement::CalculationInput;
+using Pavement::CalculationOutput;
+using Pavement::SolveStatus;
+
+namespace {
+
+// Uniform half-space, split into two identical bonded layers
+CalculationInput HomogeneousInput(double E, double nu) {
+    CalculationInput input;
+    input.layerCount = 2;
+    input.poissonRatios = {nu, nu};
+    input.youngModuli = {E, E};
+    input.thicknesses = {0.20, 100.0};
+    input.interfaceTypes = {0};
+    return input;
+}
+
+} // namespace
 
 // ============================================================================
-// Test Fixture
+// Closed-Form Solutions
 // ============================================================================
 
-class TRMMSolverTest : public ::testing::Test {
-protected:
-    void SetUp() override {
-        solver = std::make_unique<TRMMSolver>();
-        
-        // Configure for verbose testing
-        TRMMSolver::TRMMConfig config;
-        config.verbose_logging = true;
-        config.stability_threshold = 700.0;
-        config.tolerance = 1e-6;
-        solver->SetConfig(config);
+TEST(TRMMSolverTest, HomogeneousHalfSpaceMatchesBoussinesq) {
+    // Axis of a uniform circular load on a half-space (Foster-Ahlvin):
+    //   sigma_z = q (1 - z^3 / R^3)
+    //   sigma_r = q/2 ((1 + 2 nu) - 2 (1 + nu) z / R + z^3 / R^3)
+    //   w = (1 + nu) q a / E (a / R + (1 - 2 nu) (R - z) / a),  R = sqrt(a^2 + z^2)
+    for (double nu : {0.25, 0.35, 0.45}) {
+        const double E = 100.0;
+        CalculationInput input = HomogeneousInput(E, nu);
+        const double q = input.pressure;
+        const double a = input.contactRadius;
+        const std::vector<double> depths = {0.0, 0.05, 0.125, 0.2, 0.3, 1.0};
+
+        TRMMSolver solver;
+        const CalculationOutput output = solver.Calculate(input, depths);
+        ASSERT_EQ(output.sigmaZ.size(), depths.size());
+        EXPECT_TRUE(output.integration.converged);
+        EXPECT_GT(output.integration.partitions, 0);
+
+        for (size_t k = 0; k < depths.size(); ++k) {
+            const double z = depths[k];
+            const double R = std::sqrt(a * a + z * z);
+            const double ratio3 = std::pow(z / R, 3);
+            const double sigmaZ = q * (1.0 - ratio3);
+            const double sigmaR = 0.5 * q * ((1.0 + 2.0 * nu) - 2.0 * (1.0 + nu) * z / R + ratio3);
+            const double w = (1.0 + nu) * q * a / E * (a / R + (1.0 - 2.0 * nu) * (R - z) / a) * 1000.0;
+            const double epsilonZ = -(sigmaZ - 2.0 * nu * sigmaR) / E * 1e6;
+
+            EXPECT_NEAR(output.sigmaZ[k], sigmaZ, 1e-6 * q) << "nu=" << nu << " z=" << z;
+            EXPECT_NEAR(output.sigmaT[k], sigmaR, 1e-6 * q) << "nu=" << nu << " z=" << z;
+            EXPECT_NEAR(output.deflection[k], w, 1e-6 * w) << "nu=" << nu << " z=" << z;
+            EXPECT_NEAR(output.epsilonZ[k], epsilonZ, 1e-5 * std::abs(epsilonZ) + 1e-3)
+                << "nu=" << nu << " z=" << z;
+        }
     }
-    
-    void TearDown() override {
-        solver.reset();
+}
+
+TEST(TRMMSolverTest, ExtrapolatedTailIsExactAtTheSurface) {
+    // The surface stress is the load itself; truncating the m-integral misses
+    // the slowly decaying oscillation of a*J1(m*a) there
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 1.0};
+
+    TRMMSolver extrapolating;
+    TRMMSolver::TRMMConfig truncatedConfig;
+    truncatedConfig.integration.extrapolateTail = false;
+    TRMMSolver truncating(truncatedConfig);
+
+    const CalculationOutput extrapolated = extrapolating.Calculate(input, depths);
+    const CalculationOutput truncated = truncating.Calculate(input, depths);
+
+    EXPECT_NEAR(extrapolated.sigmaZ[0], input.pressure, 1e-9);
+    EXPECT_GT(std::abs(truncated.sigmaZ[0] - input.pressure), 1e-2);
+    EXPECT_LT(extrapolated.integration.evaluations, truncated.integration.evaluations);
+    EXPECT_EQ(truncated.integration.partitions, 0);
+
+    // Below the surface both integrals converge to the same responses
+    for (size_t k = 1; k < depths.size(); ++k) {
+        EXPECT_NEAR(extrapolated.sigmaZ[k], truncated.sigmaZ[k], 1e-6 * input.pressure);
+        EXPECT_NEAR(extrapolated.deflection[k], truncated.deflection[k], 1e-6 * truncated.deflection[k]);
+        EXPECT_NEAR(extrapolated.epsilonT[k], truncated.epsilonT[k], 1e-5 * std::abs(truncated.epsilonT[k]));
     }
-    
-    std::unique_ptr<TRMMSolver> solver;
-};
+}
 
 // ============================================================================
-// Stability Tests - Core TRMM Advantage
+// Interface Conditions
 // ============================================================================
 
-TEST_F(TRMMSolverTest, ExponentialStability_Moderate) {
-    // Test: Moderate m*h values should produce stable matrices
-    
-    double m = 184.805;  // First critical value from test failures
-    double h = 0.20;
-    double mh = m * h;  // = 36.96
-    
-    EXPECT_LT(mh, 50.0) << "This is a moderate case";
-    
-    // Build layer matrices
-    auto matrices = solver->BuildLayerMatrices(5000.0, 0.35, h, m);
-    
-    // All matrix elements should be ≤ 1.5 (allowing small tolerance)
-    double max_T = matrices.T.cwiseAbs().maxCoeff();
-    double max_R = matrices.R.cwiseAbs().maxCoeff();
-    
-    EXPECT_LE(max_T, 1.5) << "Transmission matrix elements should be bounded";
-    EXPECT_LE(max_R, 1.5) << "Reflection matrix elements should be bounded";
-    
-    // Check stability flag
-    EXPECT_TRUE(matrices.IsStable()) << "Matrices should be flagged as stable";
-    
-    // Condition number should be reasonable
-    double cond = matrices.GetConditionNumber();
-    EXPECT_LT(cond, 1e6) << "Condition number should be reasonable: " << cond;
-}
+TEST(TRMMSolverTest, InterfaceListedTwiceGivesBothSides) {
+    // Default structure; 0.15 and 0.45 are both interfaces (0.45 only up to rounding)
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 0.15, 0.45, 0.45, 1.0};
 
-TEST_F(TRMMSolverTest, ExponentialStability_Critical) {
-    // Test: Critical m*h value that caused TMM failure
-    
-    double m = 375.195;  // Second critical value
-    double h = 0.20;
-    double mh = m * h;  // = 75.04
-    
-    // With TMM: exp(+75.04) = 3.78e32 → OVERFLOW
-    // With TRMM: exp(-75.04) = 2.64e-33 → STABLE
-    
-    double exp_neg = std::exp(-mh);
-    EXPECT_GT(exp_neg, 0.0) << "Negative exponential should be positive";
-    EXPECT_LE(exp_neg, 1.0) << "Negative exponential should be ≤ 1.0";
-    
-    // Build matrices - should not throw
-    EXPECT_NO_THROW({
-        auto matrices = solver->BuildLayerMatrices(5000.0, 0.35, h, m);
-        EXPECT_TRUE(matrices.IsStable());
-    });
-}
+    TRMMSolver solver;
+    const CalculationOutput bonded = solver.Calculate(input, depths);
 
-TEST_F(TRMMSolverTest, ExponentialStability_Extreme) {
-    // Test: Extreme m*h value that would catastrophically fail with TMM
-    
-    double m = 521.118;  // Third critical value
-    double h = 0.20;
-    double mh = m * h;  // = 104.22
-    
-    // With TMM: exp(+104.22) = 2.43e45 → CATASTROPHIC OVERFLOW
-    // With TRMM: exp(-104.22) = 4.12e-46 → STABLE (small but valid)
-    
-    EXPECT_NO_THROW({
-        auto matrices = solver->BuildLayerMatrices(5000.0, 0.35, h, m);
-        
-        // Even for extreme case, all elements bounded
-        EXPECT_TRUE(matrices.IsStable());
-        
-        // Condition number should still be reasonable
-        double cond = matrices.GetConditionNumber();
-        EXPECT_LT(cond, 1e8) << "Even extreme case should have reasonable condition: " << cond;
-    });
-}
+    input.interfaceTypes = {2, 2};
+    const CalculationOutput frictionless = solver.Calculate(input, depths);
 
-TEST_F(TRMMSolverTest, ExponentialStability_VeryExtreme) {
-    // Test: Push to the limits - m*h = 150
-    
-    double m = 750.0;
-    double h = 0.20;
-    double mh = m * h;  // = 150
-    
-    // With TMM: impossible (exp(150) = 1.4e65)
-    // With TRMM: exp(-150) = 7.0e-66 → underflows to near zero, but stable
-    
-    EXPECT_NO_THROW({
-        auto matrices = solver->BuildLayerMatrices(5000.0, 0.35, h, m);
-        EXPECT_TRUE(matrices.IsStable());
-    });
-}
+    for (int k : {1, 3}) {
+        // Vertical stress and deflection are continuous across any interface
+        EXPECT_NEAR(bonded.sigmaZ[k], bonded.sigmaZ[k + 1], 1e-12);
+        EXPECT_NEAR(bonded.deflection[k], bonded.deflection[k + 1], 1e-12);
+        EXPECT_NEAR(frictionless.sigmaZ[k], frictionless.sigmaZ[k + 1], 1e-12);
+        EXPECT_NEAR(frictionless.deflection[k], frictionless.deflection[k + 1], 1e-12);
 
-// ============================================================================
-// Validation Against TMM Failure Cases
-// ============================================================================
+        // Bonded: the horizontal strain is continuous and the stress jumps
+        EXPECT_NEAR(bonded.epsilonT[k], bonded.epsilonT[k + 1], 1e-6 * std::abs(bonded.epsilonT[k]));
+        EXPECT_GT(std::abs(bonded.sigmaT[k] - bonded.sigmaT[k + 1]), 1e-3);
 
-TEST_F(TRMMSolverTest, CompareWithTMMFailure_Test5_TwoLayers) {
-    // Test: Exact configuration from C API Test 5 that fails with TMM
-    
-    PavementInput input = {};
-    input.layerCount = 2;
-    
-    // Layer properties
-    double poisson[] = {0.35, 0.35};
-    double moduli[] = {5000, 50};  // MPa
-    double thickness[] = {0.20, 100.0};  // meters
-    int bonded[] = {1};  // Bonded interface
-    double z_coords[] = {0.0, 0.10, 0.20};
-    
-    input.poissonRatios = poisson;
-    input.youngModuli = moduli;
-    input.thicknesses = thickness;
-    input.bondedInterfaces = bonded;
-    input.wheelType = 0;  // Simple wheel
-    input.pressure_kpa = 662.0;
-    input.wheelRadius = 0.125;
-    input.nz = 3;
-    input.z_coords = z_coords;
-    
-    PavementOutput output = {};
-    output.nz = input.nz;
-    output.deflection_mm = new double[output.nz];
-    output.vertical_stress_kpa = new double[output.nz];
-    output.horizontal_strain = new double[output.nz];
-    
-    // TRMM should succeed where TMM failed
-    bool success = solver->CalculateStable(input, output);
-    
-    EXPECT_TRUE(success) << "TRMM should succeed on TMM failure case";
-    
-    if (success) {
-        // Surface deflection must be positive (TMM gave 0.0)
-        EXPECT_GT(output.deflection_mm[0], 0.0) 
-            << "Surface deflection must be positive under load";
-        
-        // Deflection must be physically reasonable (not zero, not huge)
-        EXPECT_LT(output.deflection_mm[0], 10.0) 
-            << "Deflection should be reasonable (< 10mm for this load)";
-        
-        // Deflection should decrease with depth
-        EXPECT_GE(output.deflection_mm[0], output.deflection_mm[1])
-            << "Deflection should decrease with depth";
-        EXPECT_GE(output.deflection_mm[1], output.deflection_mm[2])
-            << "Deflection should decrease monotonically";
-        
-        // Surface stress should be positive
-        EXPECT_GT(output.vertical_stress_kpa[0], 0.0)
-            << "Surface stress must be positive";
-        
-        std::cout << "\n=== TRMM Results for Test 5 Configuration ===" << std::endl;
-        std::cout << "Surface deflection: " << output.deflection_mm[0] << " mm" << std::endl;
-        std::cout << "Mid-layer deflection: " << output.deflection_mm[1] << " mm" << std::endl;
-        std::cout << "Bottom deflection: " << output.deflection_mm[2] << " mm" << std::endl;
-        std::cout << "Calculation time: " << output.calculation_time_ms << " ms" << std::endl;
+        // Frictionless: the layers slide, the horizontal strain jumps
+        EXPECT_GT(std::abs(frictionless.epsilonT[k] - frictionless.epsilonT[k + 1]), 1.0);
     }
-    
-    // Cleanup
-    delete[] output.deflection_mm;
-    delete[] output.vertical_stress_kpa;
-    delete[] output.horizontal_strain;
-}
 
-TEST_F(TRMMSolverTest, CompareWithTMMFailure_Test7_TwinWheels) {
-    // Test: Twin wheel configuration that fails with TMM
-    
-    PavementInput input = {};
-    input.layerCount = 2;
-    
-    double poisson[] = {0.35, 0.35};
-    double moduli[] = {5000, 50};
-    double thickness[] = {0.20, 100.0};
-    int bonded[] = {1};
-    double z_coords[] = {0.0};
-    
-    input.poissonRatios = poisson;
-    input.youngModuli = moduli;
-    input.thicknesses = thickness;
-    input.bondedInterfaces = bonded;
-    input.wheelType = 1;  // Twin wheels
-    input.pressure_kpa = 662.0;
-    input.wheelRadius = 0.125;
-    input.wheelSpacing = 0.375;  // 375 mm spacing
-    input.nz = 1;
-    input.z_coords = z_coords;
-    
-    PavementOutput output = {};
-    output.nz = input.nz;
-    output.deflection_mm = new double[output.nz];
-    output.vertical_stress_kpa = new double[output.nz];
-    output.horizontal_strain = new double[output.nz];
-    
-    bool success = solver->CalculateStable(input, output);
-    
-    EXPECT_TRUE(success) << "TRMM should handle twin wheels";
-    
-    if (success) {
-        EXPECT_GT(output.deflection_mm[0], 0.0) 
-            << "Twin wheel deflection must be positive";
-        
-        std::cout << "\n=== TRMM Results for Twin Wheels ===" << std::endl;
-        std::cout << "Surface deflection: " << output.deflection_mm[0] << " mm" << std::endl;
-        std::cout << "Calculation time: " << output.calculation_time_ms << " ms" << std::endl;
-    }
-    
-    delete[] output.deflection_mm;
-    delete[] output.vertical_stress_kpa;
-    delete[] output.horizontal_strain;
+    // Tension at the bottom of the asphalt, larger once the layers slide
+    EXPECT_GT(bonded.epsilonT[1], 0.0);
+    EXPECT_GT(frictionless.epsilonT[1], bonded.epsilonT[1]);
+    EXPECT_GT(frictionless.deflection[0], bonded.deflection[0]);
 }
 
 // ============================================================================
-// Multi-Layer Tests
+// Stability Tests - Core TRMM Advantage
 // ============================================================================
 
-TEST_F(TRMMSolverTest, ThreeLayerStructure) {
-    // Test: 3-layer pavement structure
-    
-    PavementInput input = {};
-    input.layerCount = 3;
-    
-    double poisson[] = {0.35, 0.35, 0.35};
-    double moduli[] = {5000, 200, 50};
-    double thickness[] = {0.15, 0.30, 100.0};
-    int bonded[] = {1, 1};
-    double z_coords[] = {0.0, 0.15, 0.45, 1.0};
-    
-    input.poissonRatios = poisson;
-    input.youngModuli = moduli;
-    input.thicknesses = thickness;
-    input.bondedInterfaces = bonded;
-    input.wheelType = 0;
-    input.pressure_kpa = 662.0;
-    input.wheelRadius = 0.125;
-    input.nz = 4;
-    input.z_coords = z_coords;
-    
-    PavementOutput output = {};
-    output.nz = input.nz;
-    output.deflection_mm = new double[output.nz];
-    output.vertical_stress_kpa = new double[output.nz];
-    output.horizontal_strain = new double[output.nz];
-    
-    bool success = solver->CalculateStable(input, output);
-    
-    EXPECT_TRUE(success) << "3-layer calculation should succeed";
-    
-    if (success) {
-        // Check monotonic decrease
-        for (int i = 1; i < output.nz; ++i) {
-            EXPECT_GE(output.deflection_mm[i-1], output.deflection_mm[i])
-                << "Deflection should decrease with depth at index " << i;
-        }
+TEST(TRMMSolverTest, AmplitudesStayBoundedForExtremeMh) {
+    // Thick stiff layers: m*h reaches 1e5, where exp(m*h) overflows any
+    // transfer matrix formulation
+    CalculationInput input;
+    input.youngModuli = {30000.0, 3000.0, 3.0};
+    input.thicknesses = {2.0, 5.0, 100.0};
+
+    for (double m : {1.0, 10.0, 184.805, 375.195, 1e3, 1e5}) {
+        TRMMSolver::Amplitudes amplitudes;
+        ASSERT_EQ(TRMMSolver::SolveAmplitudes(m, input, amplitudes), SolveStatus::Ok) << "m=" << m;
+        EXPECT_EQ(amplitudes.cols(), input.layerCount);
+        EXPECT_TRUE(amplitudes.allFinite()) << "m=" << m;
+        EXPECT_LE(amplitudes.cwiseAbs().maxCoeff(), 10.0) << "m=" << m;
     }
-    
-    delete[] output.deflection_mm;
-    delete[] output.vertical_stress_kpa;
-    delete[] output.horizontal_strain;
-}
 
-TEST_F(TRMMSolverTest, FiveLayerComplex) {
-    // Test: Complex 5-layer structure (from Test 12)
-    
-    PavementInput input = {};
-    input.layerCount = 5;
-    
-    double poisson[] = {0.35, 0.35, 0.35, 0.35, 0.35};
-    double moduli[] = {5000, 400, 200, 100, 50};
-    double thickness[] = {0.10, 0.15, 0.20, 0.30, 100.0};
-    int bonded[] = {1, 1, 1, 1};
-    double z_coords[10];
-    for (int i = 0; i < 10; ++i) {
-        z_coords[i] = i * 0.1;
-    }
-    
-    input.poissonRatios = poisson;
-    input.youngModuli = moduli;
-    input.thicknesses = thickness;
-    input.bondedInterfaces = bonded;
-    input.wheelType = 0;
-    input.pressure_kpa = 662.0;
-    input.wheelRadius = 0.125;
-    input.nz = 10;
-    input.z_coords = z_coords;
-    
-    PavementOutput output = {};
-    output.nz = input.nz;
-    output.deflection_mm = new double[output.nz];
-    output.vertical_stress_kpa = new double[output.nz];
-    output.horizontal_strain = new double[output.nz];
-    
-    bool success = solver->CalculateStable(input, output);
-    
-    EXPECT_TRUE(success) << "5-layer calculation should succeed";
-    
-    if (success) {
-        EXPECT_GT(output.deflection_mm[0], 0.0) << "Surface deflection positive";
-        
-        // Should complete in reasonable time
-        EXPECT_LT(output.calculation_time_ms, 2000.0) 
-            << "Should complete in < 2 seconds";
+    TRMMSolver solver;
+    const CalculationOutput output = solver.Calculate(input, {0.0, 2.0, 7.0, 10.0});
+    EXPECT_EQ(output.integration.failedEvaluations, 0);
+    for (size_t k = 0; k < output.deflection.size(); ++k) {
+        EXPECT_TRUE(std::isfinite(output.deflection[k]));
+        EXPECT_GT(output.deflection[k], 0.0);
+        if (k > 0) {
+            EXPECT_LT(output.deflection[k], output.deflection[k - 1]);
+        }
     }
-    
-    delete[] output.deflection_mm;
-    delete[] output.vertical_stress_kpa;
-    delete[] output.horizontal_strain;
 }
 
 // ============================================================================
-// Performance Tests
+// Loads and Configuration
 // ============================================================================
 
-TEST_F(TRMMSolverTest, PerformanceComparison) {
-    // Test: Measure performance for typical case
-    
-    PavementInput input = {};
-    input.layerCount = 3;
-    
-    double poisson[] = {0.35, 0.35, 0.35};
-    double moduli[] = {5000, 200, 50};
-    double thickness[] = {0.15, 0.30, 100.0};
-    int bonded[] = {1, 1};
-    double z_coords[] = {0.0, 0.15, 0.45};
-    
-    input.poissonRatios = poisson;
-    input.youngModuli = moduli;
-    input.thicknesses = thickness;
-    input.bondedInterfaces = bonded;
-    input.wheelType = 0;
-    input.pressure_kpa = 662.0;
-    input.wheelRadius = 0.125;
-    input.nz = 3;
-    input.z_coords = z_coords;
-    
-    PavementOutput output = {};
-    output.nz = input.nz;
-    output.deflection_mm = new double[output.nz];
-    output.vertical_stress_kpa = new double[output.nz];
-    output.horizontal_strain = new double[output.nz];
-    
-    // Run multiple times for average
-    constexpr int ITERATIONS = 10;
-    double total_time = 0.0;
-    
-    for (int i = 0; i < ITERATIONS; ++i) {
-        bool success = solver->CalculateStable(input, output);
-        ASSERT_TRUE(success);
-        total_time += output.calculation_time_ms;
+TEST(TRMMSolverTest, TwinWheelsAddTheSecondWheel) {
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 1.0};
+
+    TRMMSolver solver;
+    const CalculationOutput single = solver.Calculate(input, depths);
+    input.wheelType = 2;
+    input.wheelSpacing = 0.375;
+    const CalculationOutput twin = solver.Calculate(input, depths);
+
+    // Outside its contact area the second wheel loads nothing at the surface
+    EXPECT_NEAR(twin.sigmaZ[0], input.pressure, 1e-4 * input.pressure);
+    for (size_t k = 0; k < depths.size(); ++k) {
+        EXPECT_GT(twin.deflection[k], single.deflection[k]);
     }
-    
-    double avg_time = total_time / ITERATIONS;
-    
-    std::cout << "\n=== TRMM Performance ===" << std::endl;
-    std::cout << "Average calculation time: " << avg_time << " ms" << std::endl;
-    std::cout << "Iterations: " << ITERATIONS << std::endl;
-    
-    // TRMM may be ~50% slower than TMM, but 100% reliable
-    // Target: < 100 ms for 3-layer structure
-    EXPECT_LT(avg_time, 100.0) << "Should be reasonably fast";
-    
-    delete[] output.deflection_mm;
-    delete[] output.vertical_stress_kpa;
-    delete[] output.horizontal_strain;
+    EXPECT_GT(twin.sigmaZ[2], single.sigmaZ[2]);
 }
 
-// ============================================================================
-// Main
-// ============================================================================
+TEST(TRMMSolverTest, ThreadedResultsAreIdentical) {
+    CalculationInput input;
+    const std::vector<double> depths = {0.0, 0.15, 0.3, 0.45, 1.0};
+
+    TRMMSolver serial;
+    TRMMSolver::TRMMConfig config;
+    config.thread_count = 3;
+    TRMMSolver threaded(config);
+
+    const CalculationOutput expected = serial.Calculate(input, depths);
+    const CalculationOutput actual = threaded.Calculate(input, depths);
+    EXPECT_EQ(actual.sigmaZ, expected.sigmaZ);
+    EXPECT_EQ(actual.sigmaT, expected.sigmaT);
+    EXPECT_EQ(actual.epsilonT, expected.epsilonT);
+    EXPECT_EQ(actual.deflection, expected.deflection);
+    EXPECT_EQ(actual.integration.evaluations, expected.integration.evaluations);
+}
+
+TEST(TRMMSolverTest, RejectsInvalidDepths) {
+    CalculationInput input;
+    TRMMSolver solver;
+    EXPECT_THROW(solver.Calculate(input, {}), std::invalid_argument);
+    EXPECT_THROW(solver.Calculate(input, {0.0, -0.1}), std::invalid_argument);
+    EXPECT_THROW(solver.Calculate(input, {std::nan("")}), std::invalid_argument);
 
-int main(int argc, char** argv) {
-    testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+    input.layerCount = 1;
+    EXPECT_THROW(solver.Calculate(input, {0.0}), std::invalid_argument);
 }
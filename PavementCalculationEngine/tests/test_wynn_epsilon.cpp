@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "WynnEpsilon.h"
+#include <Eigen/Dense>
+#include <cmath>
+#include <stdexcept>
+
+using namespace Pavement;
+
+// ============================================================================
+// Series Acceleration Tests
+// ============================================================================
+
+TEST(WynnEpsilonTest, AcceleratesAlternatingSeries) {
+    // 1 - 1/2 + 1/3 - ... = ln 2 and 1 - 1/3 + 1/5 - ... = pi/4, both O(1/n) slow
+    WynnEpsilon epsilon;
+    Eigen::VectorXd partialSum = Eigen::VectorXd::Zero(2);
+    for (int k = 1; k <= 15; ++k) {
+        const double sign = k % 2 == 1 ? 1.0 : -1.0;
+        partialSum(0) += sign / k;
+        partialSum(1) += sign / (2 * k - 1);
+        epsilon.Add(partialSum);
+    }
+
+    EXPECT_EQ(epsilon.Terms(), 15);
+    EXPECT_GT(std::abs(partialSum(0) - std::log(2.0)), 1e-2);
+    EXPECT_NEAR(epsilon.Estimate()(0), std::log(2.0), 1e-10);
+    EXPECT_NEAR(epsilon.Estimate()(1), std::atan(1.0), 1e-10);
+
+    // The error estimate bounds the actual error
+    const double error = std::max(std::abs(epsilon.Estimate()(0) - std::log(2.0)),
+                                  std::abs(epsilon.Estimate()(1) - std::atan(1.0)));
+    EXPECT_LE(error, epsilon.ErrorEstimate());
+    EXPECT_LT(epsilon.ErrorEstimate(), 1e-8);
+}
+
+TEST(WynnEpsilonTest, ConvergedComponentsStayFinite) {
+    // A constant component makes every difference vanish: no division by zero
+    WynnEpsilon epsilon;
+    double geometric = 0.0;
+    for (int k = 0; k < 10; ++k) {
+        geometric += std::pow(-0.5, k);
+        Eigen::VectorXd partialSum(2);
+        partialSum << 3.0, geometric;
+        epsilon.Add(partialSum);
+        EXPECT_TRUE(epsilon.Estimate().allFinite()) << "term " << k;
+    }
+
+    EXPECT_EQ(epsilon.Estimate()(0), 3.0);
+    EXPECT_NEAR(epsilon.Estimate()(1), 2.0 / 3.0, 1e-14);  // Exact from three terms on
+}
+
+TEST(WynnEpsilonTest, ErrorEstimateNeedsThreeTerms) {
+    WynnEpsilon epsilon;
+    Eigen::VectorXd term = Eigen::VectorXd::Constant(1, 1.0);
+    epsilon.Add(term);
+    epsilon.Add(term * 0.5);
+    EXPECT_TRUE(std::isinf(epsilon.ErrorEstimate()));
+    epsilon.Add(term * 0.75);
+    EXPECT_TRUE(std::isfinite(epsilon.ErrorEstimate()));
+}
+
+TEST(WynnEpsilonTest, TableDepthIsCapped) {
+    // A shallow table still accelerates, just less
+    WynnEpsilon shallow(5);
+    WynnEpsilon deep;
+    double partialSum = 0.0;
+    for (int k = 1; k <= 30; ++k) {
+        partialSum += (k % 2 == 1 ? 1.0 : -1.0) / k;
+        shallow.Add(Eigen::VectorXd::Constant(1, partialSum));
+        deep.Add(Eigen::VectorXd::Constant(1, partialSum));
+    }
+    const double shallowError = std::abs(shallow.Estimate()(0) - std::log(2.0));
+    EXPECT_LT(shallowError, 1e-6);
+    EXPECT_LT(std::abs(deep.Estimate()(0) - std::log(2.0)), 1e-13);
+}
+
+TEST(WynnEpsilonTest, RejectsBadArguments) {
+    EXPECT_THROW(WynnEpsilon(2), std::invalid_argument);
+
+    WynnEpsilon epsilon;
+    epsilon.Add(Eigen::VectorXd::Zero(3));
+    EXPECT_THROW(epsilon.Add(Eigen::VectorXd::Zero(2)), std::invalid_argument);
+}